@@ -2432,13 +2432,13 @@ int rtw_mesh_peer_establish(_adapter *adapter, struct mesh_plink_ent *plink, str
 
 	rtw_ap_parse_sta_capability(adapter, sta, plink->rx_conf_ies);
 
-	if (rtw_ap_parse_sta_supported_rates(adapter, sta, tlv_ies, tlv_ieslen) != _STATS_SUCCESSFUL_)
+	if (rtw_ap_parse_sta_supported_rates(adapter, sta, &elems) != _STATS_SUCCESSFUL_)
 		goto exit;
 	
 	if (rtw_ap_parse_sta_security_ie(adapter, sta, &elems) != _STATS_SUCCESSFUL_)
 		goto exit;
 
-	rtw_ap_parse_sta_wmm_ie(adapter, sta, tlv_ies, tlv_ieslen);
+	rtw_ap_parse_sta_wmm_ie(adapter, sta, &elems);
 #ifdef CONFIG_RTS_FULL_BW
 	/*check vendor IE*/
 	rtw_parse_sta_vendor_ie_8812(adapter, sta, tlv_ies, tlv_ieslen);
@@ -2449,11 +2449,10 @@ int rtw_mesh_peer_establish(_adapter *adapter, struct mesh_plink_ent *plink, str
 
 	/* AID */
 #ifdef CONFIG_RTW_MESH_DRIVER_AID
-	sta->cmn.aid = RTW_GET_LE16(plink->tx_conf_ies + 2);
+	rtw_aid_bind(stapriv, sta, RTW_GET_LE16(plink->tx_conf_ies + 2));
 #else
-	sta->cmn.aid = plink->aid;
+	rtw_aid_bind(stapriv, sta, plink->aid);
 #endif
-	stapriv->sta_aid[sta->cmn.aid - 1] = sta;
 	RTW_INFO(FUNC_ADPT_FMT" sta "MAC_FMT" aid:%u\n"
 		, FUNC_ADPT_ARG(adapter), MAC_ARG(sta->cmn.mac_addr), sta->cmn.aid);
 
@@ -2474,6 +2473,8 @@ int rtw_mesh_peer_establish(_adapter *adapter, struct mesh_plink_ent *plink, str
 		/* sta->expire_to = mcfg->plink_timeout / 2; */
 		rtw_list_insert_tail(&sta->asoc_list, &stapriv->asoc_list);
 		stapriv->asoc_list_cnt++;
+		/* only armed STAs are visited by expire_timeout_chk() */
+		rtw_sta_expire_arm(stapriv, sta, stapriv->expire_to);
 	}
 	_exit_critical_bh(&stapriv->asoc_list_lock, &irqL);
 
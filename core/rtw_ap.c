@@ -54,13 +54,14 @@ u8 rtw_set_tim_ie(u8 dtim_cnt, u8 dtim_period
 	u8 i, n1, n2;
 	u8 bmp_len;
 
-	if (rtw_bmp_not_empty(tim_bmp, tim_bmp_len)) {
-		/* find the first nonzero octet in tim_bitmap */
-		for (i = 0; i < tim_bmp_len; i++)
-			if (tim_bmp[i])
-				break;
+	/* find the first nonzero octet in tim_bitmap, none means empty */
+	for (i = 0; i < tim_bmp_len; i++)
+		if (tim_bmp[i])
+			break;
+
+	if (i < tim_bmp_len) {
 		n1 = i & 0xFE;
-	
+
 		/* find the last nonzero octet in tim_bitmap, except octet 0 */
 		for (i = tim_bmp_len - 1; i > 0; i--)
 			if (tim_bmp[i])
@@ -310,6 +311,8 @@ u8 chk_sta_is_alive(struct sta_info *psta)
 /**
  * issue_aka_chk_frame - issue active keep alive check frame
  *	aka = active keep alive
+ * return _SUCCESS if peer is known to be alive now,
+ * result of the null data issued in AP mode is got by rtw_ap_aka_probe_report() later
  */
 static int issue_aka_chk_frame(_adapter *adapter, struct sta_info *psta)
 {
@@ -318,10 +321,18 @@ static int issue_aka_chk_frame(_adapter *adapter, struct sta_info *psta)
 
 	if (MLME_IS_AP(adapter)) {
 		/* issue null data to check sta alive */
+#ifdef CONFIG_XMIT_ACK
+		psta->aka_probe = AKA_PROBE_PENDING;
+		if (issue_nulldata_tx_rpt(adapter, psta) == _SUCCESS)
+			adapter->stapriv.aka_probe_cnt++;
+		else
+			psta->aka_probe = AKA_PROBE_FAIL;
+#else
 		if (psta->state & WIFI_SLEEP_STATE)
 			ret = issue_nulldata(adapter, target_addr, 0, 1, 50);
 		else
 			ret = issue_nulldata(adapter, target_addr, 0, 3, 50);
+#endif
 	}
 
 #ifdef CONFIG_RTW_MESH
@@ -384,259 +395,323 @@ static void rtw_check_restore_rf18(_adapter *padapter)
 }
 #endif
 
-void	expire_timeout_chk(_adapter *padapter)
+/* arm expire check of psta only if it's still associated, not being freed */
+static void expire_asoc_sta_arm(struct sta_priv *pstapriv, struct sta_info *psta, u32 ticks)
 {
 	_irqL irqL;
-	_list	*phead, *plist;
-	u8 updated = _FALSE;
-	struct sta_info *psta = NULL;
-	struct sta_priv *pstapriv = &padapter->stapriv;
-	u8 chk_alive_num = 0;
-	char chk_alive_list[NUM_STA];
-	int i;
 
-#ifdef CONFIG_RTW_MESH
-	if (MLME_IS_MESH(padapter)
-		&& check_fwstate(&padapter->mlmepriv, WIFI_ASOC_STATE)
-	) {
-		struct rtw_mesh_cfg *mcfg = &padapter->mesh_cfg;
+	_enter_critical_bh(&pstapriv->asoc_list_lock, &irqL);
+	if (rtw_is_list_empty(&psta->asoc_list) == _FALSE)
+		rtw_sta_expire_arm(pstapriv, psta, ticks);
+	_exit_critical_bh(&pstapriv->asoc_list_lock, &irqL);
+}
 
-		rtw_mesh_path_expire(padapter);
+#ifdef CONFIG_XMIT_ACK
+/*
+ * rtw_ap_aka_probe_report - TX report of AC queue frame with STA macid
+ * it's consumed if psta is waiting for the report of null data issued by issue_aka_chk_frame()
+ * return _SUCCESS if consumed
+ */
+s32 rtw_ap_aka_probe_report(_adapter *adapter, u8 mac_id, bool acked)
+{
+	struct macid_ctl_t *macid_ctl = adapter_to_macidctl(adapter);
+	struct sta_info *psta;
+	struct sta_priv *pstapriv;
 
-		/* TBD: up layer timeout mechanism */
-		/* if (!mcfg->plink_timeout)
-			return; */
-#ifndef CONFIG_ACTIVE_KEEP_ALIVE_CHECK
-		return;
-#endif
+	if (mac_id >= macid_ctl->num)
+		return _FAIL;
+
+	psta = macid_ctl->sta[mac_id];
+	if (!psta || psta->aka_probe != AKA_PROBE_PENDING)
+		return _FAIL;
+
+	pstapriv = &psta->padapter->stapriv;
+
+	if (!acked) {
+		psta->aka_probe = AKA_PROBE_FAIL;
+		pstapriv->aka_probe_fail_cnt++;
+		return _SUCCESS;
 	}
-#endif
 
-#ifdef CONFIG_MCC_MODE
-	/*	then driver may check fail due to not recv client's frame under sitesurvey,
-	 *	don't expire timeout chk under MCC under sitesurvey */
+	psta->aka_probe = AKA_PROBE_NONE;
+	pstapriv->aka_probe_ack_cnt++;
 
-	if (rtw_hal_mcc_link_status_chk(padapter, __func__) == _FALSE)
-		return;
+	RTW_INFO(FUNC_ADPT_FMT" asoc check, "MAC_FMT" is alive\n"
+		, FUNC_ADPT_ARG(psta->padapter), MAC_ARG(psta->cmn.mac_addr));
+
+	psta->keep_alive_trycnt = 0;
+	expire_asoc_sta_arm(pstapriv, psta, pstapriv->expire_to);
+
+	return _SUCCESS;
+}
+#endif /* CONFIG_XMIT_ACK */
+
+/*
+ * expire_asoc_sta_chk - deadline of associated STA is reached, called with asoc_list_lock held
+ * return _TRUE if the STA needs active keep alive check or is to be expired
+ */
+static u8 expire_asoc_sta_chk(_adapter *padapter, struct sta_info *psta)
+{
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	struct mlme_ext_priv *pmlmeext = &padapter->mlmeextpriv;
+	u32 rx_ago;
+
+#ifdef CONFIG_ATMEL_RC_PATCH
+	RTW_INFO("%s:%d  psta=%p, %02x,%02x||%02x,%02x  \n\n", __func__,  __LINE__,
+		psta, pstapriv->atmel_rc_pattern[0], pstapriv->atmel_rc_pattern[5], psta->cmn.mac_addr[0], psta->cmn.mac_addr[5]);
+	if (_rtw_memcmp((void *)pstapriv->atmel_rc_pattern, (void *)(psta->cmn.mac_addr), ETH_ALEN) == _TRUE)
+		goto rearm;
+	if (psta->flag_atmel_rc)
+		goto rearm;
+#endif
+#ifdef CONFIG_AUTO_AP_MODE
+	if (psta->isrc)
+		goto rearm;
 #endif
 
-	_enter_critical_bh(&pstapriv->auth_list_lock, &irqL);
+	if (chk_sta_is_alive(psta)) {
+		/* deadline is expire_to after the last RX */
+		rx_ago = rtw_get_passing_time_ms(psta->sta_stats.last_rx_time) / STA_EXPIRE_TICK_MS;
+		psta->keep_alive_trycnt = 0;
+		psta->aka_probe = AKA_PROBE_NONE;
+#ifdef CONFIG_TX_MCAST2UNI
+		psta->under_exist_checking = 0;
+#endif
+		rtw_sta_expire_arm(pstapriv, psta
+			, rx_ago < pstapriv->expire_to ? pstapriv->expire_to - rx_ago : pstapriv->expire_to);
+		return _FALSE;
+	}
 
-	phead = &pstapriv->auth_list;
-	plist = get_next(phead);
+	if (padapter->registrypriv.wifi_spec == 1)
+		goto rearm;
 
-	/* check auth_queue */
-#ifdef DBG_EXPIRATION_CHK
-	if (rtw_end_of_queue_search(phead, plist) == _FALSE) {
-		RTW_INFO(FUNC_ADPT_FMT" auth_list, cnt:%u\n"
-			, FUNC_ADPT_ARG(padapter), pstapriv->auth_list_cnt);
+#ifndef CONFIG_ACTIVE_KEEP_ALIVE_CHECK
+#ifdef CONFIG_80211N_HT
+#ifdef CONFIG_TX_MCAST2UNI
+	if ((psta->flags & WLAN_STA_HT) && psta->htpriv.agg_enable_bitmap && psta->under_exist_checking == 0) {
+		/* check sta by delba(addba) for 11n STA */
+		/* ToDo: use CCX report to check for all STAs */
+		RTW_INFO("asoc check by DELBA/ADDBA! (%d s)\n", pstapriv->expire_to * 2);
+		psta->under_exist_checking = 1;
+		/* tear down TX AMPDU */
+		send_delba(padapter, 1, psta->cmn.mac_addr);/*  */ /* originator */
+		psta->htpriv.agg_enable_bitmap = 0x0;/* reset */
+		psta->htpriv.candidate_tid_bitmap = 0x0;/* reset */
+		goto rearm;
 	}
-#endif
-	while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
-		psta = LIST_CONTAINOR(plist, struct sta_info, auth_list);
+	if (psta->under_exist_checking) {
+		RTW_INFO("asoc expire by DELBA/ADDBA! (%d s)\n", pstapriv->expire_to * 2 * 2);
+		psta->under_exist_checking = 0;
+	}
+#endif /* CONFIG_TX_MCAST2UNI */
 
-		plist = get_next(plist);
+#define KEEP_ALIVE_TRYCNT (3)
 
+	if (psta->keep_alive_trycnt > 0 && psta->keep_alive_trycnt <= KEEP_ALIVE_TRYCNT) {
+		if (psta->state & WIFI_STA_ALIVE_CHK_STATE)
+			psta->state ^= WIFI_STA_ALIVE_CHK_STATE;
+		else
+			psta->keep_alive_trycnt = 0;
 
-#ifdef CONFIG_ATMEL_RC_PATCH
-		if (_rtw_memcmp((void *)(pstapriv->atmel_rc_pattern), (void *)(psta->cmn.mac_addr), ETH_ALEN) == _TRUE)
-			continue;
-		if (psta->flag_atmel_rc)
-			continue;
-#endif
-		if (psta->expire_to > 0) {
-			psta->expire_to--;
-			if (psta->expire_to == 0) {
-				rtw_list_delete(&psta->auth_list);
-				pstapriv->auth_list_cnt--;
+	} else if ((psta->keep_alive_trycnt > KEEP_ALIVE_TRYCNT) && !(psta->state & WIFI_STA_ALIVE_CHK_STATE))
+		psta->keep_alive_trycnt = 0;
+	if ((psta->htpriv.ht_option == _TRUE) && (psta->htpriv.ampdu_enable == _TRUE)) {
+		uint priority = 1; /* test using BK */
+		u8 issued = 0;
 
-				RTW_INFO(FUNC_ADPT_FMT" auth expire "MAC_FMT"\n"
-					, FUNC_ADPT_ARG(padapter), MAC_ARG(psta->cmn.mac_addr));
+		/* issued = (psta->htpriv.agg_enable_bitmap>>priority)&0x1; */
+		issued |= (psta->htpriv.candidate_tid_bitmap >> priority) & 0x1;
 
-				_exit_critical_bh(&pstapriv->auth_list_lock, &irqL);
+		if (0 == issued) {
+			if (!(psta->state & WIFI_STA_ALIVE_CHK_STATE)) {
+				psta->htpriv.candidate_tid_bitmap |= BIT((u8)priority);
+
+				if (psta->state & WIFI_SLEEP_STATE)
+					rtw_sta_expire_arm(pstapriv, psta, 2); /* 2x2=4 sec */
+				else
+					rtw_sta_expire_arm(pstapriv, psta, 1); /* 2 sec */
 
-				/* _enter_critical_bh(&(pstapriv->sta_hash_lock), &irqL);	 */
-				rtw_free_stainfo(padapter, psta);
-				/* _exit_critical_bh(&(pstapriv->sta_hash_lock), &irqL);	 */
+				psta->state |= WIFI_STA_ALIVE_CHK_STATE;
 
-				_enter_critical_bh(&pstapriv->auth_list_lock, &irqL);
+				/* add_ba_hdl(padapter, (u8*)paddbareq_parm); */
+
+				RTW_INFO("issue addba_req to check if sta alive, keep_alive_trycnt=%d\n", psta->keep_alive_trycnt);
+
+				issue_addba_req(padapter, psta->cmn.mac_addr, (u8)priority);
+
+				_set_timer(&psta->addba_retry_timer, ADDBA_TO);
+
+				psta->keep_alive_trycnt++;
+
+				return _FALSE;
 			}
 		}
+	}
+	if (psta->keep_alive_trycnt > 0 && psta->state & WIFI_STA_ALIVE_CHK_STATE) {
+		psta->keep_alive_trycnt = 0;
+		psta->state ^= WIFI_STA_ALIVE_CHK_STATE;
+		RTW_INFO("change to another methods to check alive if staion is at ps mode\n");
+	}
+
+#endif /* CONFIG_80211N_HT */
+#endif /* CONFIG_ACTIVE_KEEP_ALIVE_CHECK	 */
+	if (psta->state & WIFI_SLEEP_STATE) {
+		if (!(psta->state & WIFI_STA_ALIVE_CHK_STATE)) {
+			/* to check if alive by another methods if staion is at ps mode.					 */
+			psta->state |= WIFI_STA_ALIVE_CHK_STATE;
 
+			/* RTW_INFO("alive chk, sta:" MAC_FMT " is at ps mode!\n", MAC_ARG(psta->cmn.mac_addr)); */
+
+			/* to update bcn with tim_bitmap for this station */
+			rtw_tim_map_set(padapter, pstapriv->tim_bitmap, psta->cmn.aid);
+			update_beacon(padapter, _TIM_IE_, NULL, _TRUE);
+
+			if (!pmlmeext->active_keep_alive_check)
+				goto rearm;
+		}
 	}
 
-	_exit_critical_bh(&pstapriv->auth_list_lock, &irqL);
-	psta = NULL;
+	return _TRUE;
 
+rearm:
+	rtw_sta_expire_arm(pstapriv, psta, pstapriv->expire_to);
+	return _FALSE;
+}
+
+/* TODO: Aging mechanism to digest frames in sleep_q to avoid running out of xmitframe */
+static void expire_sleepq_chk(_adapter *padapter)
+{
+	_irqL irqL;
+	_list	*phead, *plist;
+	struct sta_info *psta;
+	struct sta_priv *pstapriv = &padapter->stapriv;
 
 	_enter_critical_bh(&pstapriv->asoc_list_lock, &irqL);
 
 	phead = &pstapriv->asoc_list;
 	plist = get_next(phead);
 
-	/* check asoc_queue */
-#ifdef DBG_EXPIRATION_CHK
-	if (rtw_end_of_queue_search(phead, plist) == _FALSE) {
-		RTW_INFO(FUNC_ADPT_FMT" asoc_list, cnt:%u\n"
-			, FUNC_ADPT_ARG(padapter), pstapriv->asoc_list_cnt);
-	}
-#endif
 	while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
 		psta = LIST_CONTAINOR(plist, struct sta_info, asoc_list);
 		plist = get_next(plist);
-#ifdef CONFIG_ATMEL_RC_PATCH
-		RTW_INFO("%s:%d  psta=%p, %02x,%02x||%02x,%02x  \n\n", __func__,  __LINE__,
-			psta, pstapriv->atmel_rc_pattern[0], pstapriv->atmel_rc_pattern[5], psta->cmn.mac_addr[0], psta->cmn.mac_addr[5]);
-		if (_rtw_memcmp((void *)pstapriv->atmel_rc_pattern, (void *)(psta->cmn.mac_addr), ETH_ALEN) == _TRUE)
-			continue;
-		if (psta->flag_atmel_rc)
-			continue;
-		RTW_INFO("%s: debug line:%d\n", __func__, __LINE__);
-#endif
-#ifdef CONFIG_AUTO_AP_MODE
-		if (psta->isrc)
-			continue;
-#endif
-		if (chk_sta_is_alive(psta) || !psta->expire_to) {
-			psta->expire_to = pstapriv->expire_to;
-			psta->keep_alive_trycnt = 0;
-#ifdef CONFIG_TX_MCAST2UNI
-			psta->under_exist_checking = 0;
-#endif	/* CONFIG_TX_MCAST2UNI */
-		} else
-			psta->expire_to--;
 
-#ifndef CONFIG_ACTIVE_KEEP_ALIVE_CHECK
-#ifdef CONFIG_80211N_HT
-#ifdef CONFIG_TX_MCAST2UNI
-		if ((psta->flags & WLAN_STA_HT) && (psta->htpriv.agg_enable_bitmap || psta->under_exist_checking)) {
-			/* check sta by delba(addba) for 11n STA */
-			/* ToDo: use CCX report to check for all STAs */
-			/* RTW_INFO("asoc check by DELBA/ADDBA! (pstapriv->expire_to=%d s)(psta->expire_to=%d s), [%02x, %d]\n", pstapriv->expire_to*2, psta->expire_to*2, psta->htpriv.agg_enable_bitmap, psta->under_exist_checking); */
-
-			if (psta->expire_to <= (pstapriv->expire_to - 50)) {
-				RTW_INFO("asoc expire by DELBA/ADDBA! (%d s)\n", (pstapriv->expire_to - psta->expire_to) * 2);
-				psta->under_exist_checking = 0;
-				psta->expire_to = 0;
-			} else if (psta->expire_to <= (pstapriv->expire_to - 3) && (psta->under_exist_checking == 0)) {
-				RTW_INFO("asoc check by DELBA/ADDBA! (%d s)\n", (pstapriv->expire_to - psta->expire_to) * 2);
-				psta->under_exist_checking = 1;
-				/* tear down TX AMPDU */
-				send_delba(padapter, 1, psta->cmn.mac_addr);/*  */ /* originator */
-				psta->htpriv.agg_enable_bitmap = 0x0;/* reset */
-				psta->htpriv.candidate_tid_bitmap = 0x0;/* reset */
-			}
+		if (psta->sleepq_len > (NR_XMITFRAME / pstapriv->asoc_list_cnt)
+		    && padapter->xmitpriv.free_xmitframe_cnt < ((NR_XMITFRAME / pstapriv->asoc_list_cnt) / 2)
+		   ) {
+			RTW_INFO(FUNC_ADPT_FMT" sta:"MAC_FMT", sleepq_len:%u, free_xmitframe_cnt:%u, asoc_list_cnt:%u, clear sleep_q\n"
+				, FUNC_ADPT_ARG(padapter), MAC_ARG(psta->cmn.mac_addr)
+				, psta->sleepq_len, padapter->xmitpriv.free_xmitframe_cnt, pstapriv->asoc_list_cnt);
+			wakeup_sta_to_xmit(padapter, psta);
 		}
-#endif /* CONFIG_TX_MCAST2UNI */
-#endif /* CONFIG_80211N_HT */
-#endif /* CONFIG_ACTIVE_KEEP_ALIVE_CHECK */
-
-		if (psta->expire_to <= 0) {
-			struct mlme_ext_priv *pmlmeext = &padapter->mlmeextpriv;
-
-			if (padapter->registrypriv.wifi_spec == 1) {
-				psta->expire_to = pstapriv->expire_to;
-				continue;
-			}
-
-#ifndef CONFIG_ACTIVE_KEEP_ALIVE_CHECK
-#ifdef CONFIG_80211N_HT
-
-#define KEEP_ALIVE_TRYCNT (3)
+	}
 
-			if (psta->keep_alive_trycnt > 0 && psta->keep_alive_trycnt <= KEEP_ALIVE_TRYCNT) {
-				if (psta->state & WIFI_STA_ALIVE_CHK_STATE)
-					psta->state ^= WIFI_STA_ALIVE_CHK_STATE;
-				else
-					psta->keep_alive_trycnt = 0;
+	_exit_critical_bh(&pstapriv->asoc_list_lock, &irqL);
+}
 
-			} else if ((psta->keep_alive_trycnt > KEEP_ALIVE_TRYCNT) && !(psta->state & WIFI_STA_ALIVE_CHK_STATE))
-				psta->keep_alive_trycnt = 0;
-			if ((psta->htpriv.ht_option == _TRUE) && (psta->htpriv.ampdu_enable == _TRUE)) {
-				uint priority = 1; /* test using BK */
-				u8 issued = 0;
+void	expire_timeout_chk(_adapter *padapter)
+{
+	_irqL irqL;
+	u8 updated = _FALSE;
+	struct sta_info *psta = NULL;
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	u8 due_num;
+	char due_list[NUM_STA];
+	u8 chk_alive_num = 0;
+	char chk_alive_list[NUM_STA];
+	int i;
 
-				/* issued = (psta->htpriv.agg_enable_bitmap>>priority)&0x1; */
-				issued |= (psta->htpriv.candidate_tid_bitmap >> priority) & 0x1;
+#ifdef CONFIG_RTW_MESH
+	if (MLME_IS_MESH(padapter)
+		&& check_fwstate(&padapter->mlmepriv, WIFI_ASOC_STATE)
+	) {
+		struct rtw_mesh_cfg *mcfg = &padapter->mesh_cfg;
 
-				if (0 == issued) {
-					if (!(psta->state & WIFI_STA_ALIVE_CHK_STATE)) {
-						psta->htpriv.candidate_tid_bitmap |= BIT((u8)priority);
+		rtw_mesh_path_expire(padapter);
 
-						if (psta->state & WIFI_SLEEP_STATE)
-							psta->expire_to = 2; /* 2x2=4 sec */
-						else
-							psta->expire_to = 1; /* 2 sec */
+		/* TBD: up layer timeout mechanism */
+		/* if (!mcfg->plink_timeout)
+			return; */
+#ifndef CONFIG_ACTIVE_KEEP_ALIVE_CHECK
+		return;
+#endif
+	}
+#endif
 
-						psta->state |= WIFI_STA_ALIVE_CHK_STATE;
+#ifdef CONFIG_MCC_MODE
+	/*	then driver may check fail due to not recv client's frame under sitesurvey,
+	 *	don't expire timeout chk under MCC under sitesurvey */
 
-						/* add_ba_hdl(padapter, (u8*)paddbareq_parm); */
+	if (rtw_hal_mcc_link_status_chk(padapter, __func__) == _FALSE)
+		return;
+#endif
 
-						RTW_INFO("issue addba_req to check if sta alive, keep_alive_trycnt=%d\n", psta->keep_alive_trycnt);
+	/* only STAs whose deadline is reached are checked */
+	due_num = rtw_sta_expire_tick(pstapriv, due_list);
 
-						issue_addba_req(padapter, psta->cmn.mac_addr, (u8)priority);
+#ifdef DBG_EXPIRATION_CHK
+	if (due_num) {
+		RTW_INFO(FUNC_ADPT_FMT" due:%u, auth_list cnt:%u, asoc_list cnt:%u\n"
+			, FUNC_ADPT_ARG(padapter), due_num, pstapriv->auth_list_cnt, pstapriv->asoc_list_cnt);
+	}
+#endif
 
-						_set_timer(&psta->addba_retry_timer, ADDBA_TO);
+	for (i = 0; i < due_num; i++) {
+		psta = rtw_get_stainfo_by_offset(pstapriv, due_list[i]);
 
-						psta->keep_alive_trycnt++;
+		/* armed again after taken out of the wheel */
+		if (rtw_is_list_empty(&psta->expire_list) == _FALSE)
+			continue;
 
-						continue;
-					}
-				}
-			}
-			if (psta->keep_alive_trycnt > 0 && psta->state & WIFI_STA_ALIVE_CHK_STATE) {
-				psta->keep_alive_trycnt = 0;
-				psta->state ^= WIFI_STA_ALIVE_CHK_STATE;
-				RTW_INFO("change to another methods to check alive if staion is at ps mode\n");
+		/* check auth_queue */
+		_enter_critical_bh(&pstapriv->auth_list_lock, &irqL);
+		if (rtw_is_list_empty(&psta->auth_list) == _FALSE) {
+#ifdef CONFIG_ATMEL_RC_PATCH
+			if (_rtw_memcmp((void *)(pstapriv->atmel_rc_pattern), (void *)(psta->cmn.mac_addr), ETH_ALEN) == _TRUE
+				|| psta->flag_atmel_rc) {
+				rtw_sta_expire_arm(pstapriv, psta, pstapriv->auth_to);
+				_exit_critical_bh(&pstapriv->auth_list_lock, &irqL);
+				continue;
 			}
+#endif
+			rtw_list_delete(&psta->auth_list);
+			pstapriv->auth_list_cnt--;
 
-#endif /* CONFIG_80211N_HT */
-#endif /* CONFIG_ACTIVE_KEEP_ALIVE_CHECK	 */
-			if (psta->state & WIFI_SLEEP_STATE) {
-				if (!(psta->state & WIFI_STA_ALIVE_CHK_STATE)) {
-					/* to check if alive by another methods if staion is at ps mode.					 */
-					psta->expire_to = pstapriv->expire_to;
-					psta->state |= WIFI_STA_ALIVE_CHK_STATE;
-
-					/* RTW_INFO("alive chk, sta:" MAC_FMT " is at ps mode!\n", MAC_ARG(psta->cmn.mac_addr)); */
+			RTW_INFO(FUNC_ADPT_FMT" auth expire "MAC_FMT"\n"
+				, FUNC_ADPT_ARG(padapter), MAC_ARG(psta->cmn.mac_addr));
 
-					/* to update bcn with tim_bitmap for this station */
-					rtw_tim_map_set(padapter, pstapriv->tim_bitmap, psta->cmn.aid);
-					update_beacon(padapter, _TIM_IE_, NULL, _TRUE);
+			_exit_critical_bh(&pstapriv->auth_list_lock, &irqL);
 
-					if (!pmlmeext->active_keep_alive_check)
-						continue;
-				}
-			}
+			/* _enter_critical_bh(&(pstapriv->sta_hash_lock), &irqL);	 */
+			rtw_free_stainfo(padapter, psta);
+			/* _exit_critical_bh(&(pstapriv->sta_hash_lock), &irqL);	 */
+			continue;
+		}
+		_exit_critical_bh(&pstapriv->auth_list_lock, &irqL);
 
-			{
-				int stainfo_offset;
+		/* check asoc_queue */
+		_enter_critical_bh(&pstapriv->asoc_list_lock, &irqL);
+		if (rtw_is_list_empty(&psta->asoc_list) == _FALSE
+			&& expire_asoc_sta_chk(padapter, psta) == _TRUE
+		) {
+			int stainfo_offset;
 
-				stainfo_offset = rtw_stainfo_offset(pstapriv, psta);
-				if (stainfo_offset_valid(stainfo_offset))
-					chk_alive_list[chk_alive_num++] = stainfo_offset;
-				continue;
-			}
-		} else {
-			/* TODO: Aging mechanism to digest frames in sleep_q to avoid running out of xmitframe */
-			if (psta->sleepq_len > (NR_XMITFRAME / pstapriv->asoc_list_cnt)
-			    && padapter->xmitpriv.free_xmitframe_cnt < ((NR_XMITFRAME / pstapriv->asoc_list_cnt) / 2)
-			   ) {
-				RTW_INFO(FUNC_ADPT_FMT" sta:"MAC_FMT", sleepq_len:%u, free_xmitframe_cnt:%u, asoc_list_cnt:%u, clear sleep_q\n"
-					, FUNC_ADPT_ARG(padapter), MAC_ARG(psta->cmn.mac_addr)
-					, psta->sleepq_len, padapter->xmitpriv.free_xmitframe_cnt, pstapriv->asoc_list_cnt);
-				wakeup_sta_to_xmit(padapter, psta);
-			}
+			stainfo_offset = rtw_stainfo_offset(pstapriv, psta);
+			if (stainfo_offset_valid(stainfo_offset))
+				chk_alive_list[chk_alive_num++] = stainfo_offset;
 		}
+		_exit_critical_bh(&pstapriv->asoc_list_lock, &irqL);
 	}
+	psta = NULL;
 
-	_exit_critical_bh(&pstapriv->asoc_list_lock, &irqL);
+	if (pstapriv->asoc_list_cnt
+		&& padapter->xmitpriv.free_xmitframe_cnt < ((NR_XMITFRAME / pstapriv->asoc_list_cnt) / 2))
+		expire_sleepq_chk(padapter);
 
 	if (chk_alive_num) {
 #if defined(CONFIG_ACTIVE_KEEP_ALIVE_CHECK)
-		u8 backup_ch = 0, backup_bw = 0, backup_offset = 0;
 		u8 union_ch = 0, union_bw = 0, union_offset = 0;
 		u8 switch_channel_by_drv = _TRUE;
+		u8 aka_defer = _FALSE;
 		struct mlme_ext_priv *pmlmeext = &padapter->mlmeextpriv;
 #endif
 		char del_asoc_list[NUM_STA];
@@ -657,13 +732,12 @@ void	expire_timeout_chk(_adapter *padapter)
 				|| pmlmeext->cur_channel != union_ch)
 				switch_channel_by_drv = _FALSE;
 
-			/* switch to correct channel of current network  before issue keep-alive frames */
-			if (switch_channel_by_drv == _TRUE && rtw_get_oper_ch(padapter) != pmlmeext->cur_channel) {
-				backup_ch = rtw_get_oper_ch(padapter);
-				backup_bw = rtw_get_oper_bw(padapter);
-				backup_offset = rtw_get_oper_choffset(padapter);
-				set_channel_bwmode(padapter, union_ch, union_offset, union_bw);
-			}
+			/*
+			* keep-alive frames are not waited for, don't switch channel for them,
+			* check again next tick if currently off the operating channel
+			*/
+			if (switch_channel_by_drv == _TRUE && rtw_get_oper_ch(padapter) != pmlmeext->cur_channel)
+				aka_defer = _TRUE;
 		}
 		#endif /* CONFIG_ACTIVE_KEEP_ALIVE_CHECK */
 
@@ -676,37 +750,52 @@ void	expire_timeout_chk(_adapter *padapter)
 			psta = rtw_get_stainfo_by_offset(pstapriv, chk_alive_list[i]);
 
 			#ifdef CONFIG_ATMEL_RC_PATCH
-			if (_rtw_memcmp(pstapriv->atmel_rc_pattern, psta->cmn.mac_addr, ETH_ALEN) == _TRUE)
-				continue;
-			if (psta->flag_atmel_rc)
+			if (_rtw_memcmp(pstapriv->atmel_rc_pattern, psta->cmn.mac_addr, ETH_ALEN) == _TRUE
+				|| psta->flag_atmel_rc) {
+				expire_asoc_sta_arm(pstapriv, psta, pstapriv->expire_to);
 				continue;
+			}
 			#endif
 
-			if (!(psta->state & _FW_LINKED))
+			if (!(psta->state & _FW_LINKED)) {
+				expire_asoc_sta_arm(pstapriv, psta, 1);
 				continue;
+			}
 
 			#ifdef CONFIG_ACTIVE_KEEP_ALIVE_CHECK
 			if (pmlmeext->active_keep_alive_check) {
-				/* issue active keep alive frame to check */
-				ret = issue_aka_chk_frame(padapter, psta);
+				/* acked by rtw_ap_aka_probe_report() in between */
+				if (rtw_is_list_empty(&psta->expire_list) == _FALSE)
+					continue;
 
-				psta->keep_alive_trycnt++;
-				if (ret == _SUCCESS) {
-					RTW_INFO(FUNC_ADPT_FMT" asoc check, "MAC_FMT" is alive\n"
-						, FUNC_ADPT_ARG(padapter), MAC_ARG(psta->cmn.mac_addr));
-					psta->expire_to = pstapriv->expire_to;
-					psta->keep_alive_trycnt = 0;
+				if (aka_defer == _TRUE) {
+					expire_asoc_sta_arm(pstapriv, psta, 1);
 					continue;
-				} else if (psta->keep_alive_trycnt <= 3) {
+				}
+
+				if (psta->keep_alive_trycnt <= 3) {
+					/* issue active keep alive frame to check, no ack in this tick is a failed try */
+					ret = issue_aka_chk_frame(padapter, psta);
+
+					psta->keep_alive_trycnt++;
+					if (ret == _SUCCESS) {
+						RTW_INFO(FUNC_ADPT_FMT" asoc check, "MAC_FMT" is alive\n"
+							, FUNC_ADPT_ARG(padapter), MAC_ARG(psta->cmn.mac_addr));
+						psta->keep_alive_trycnt = 0;
+						expire_asoc_sta_arm(pstapriv, psta, pstapriv->expire_to);
+						continue;
+					}
+
 					RTW_INFO(FUNC_ADPT_FMT" asoc check, "MAC_FMT" keep_alive_trycnt=%d\n"
 						, FUNC_ADPT_ARG(padapter) , MAC_ARG(psta->cmn.mac_addr), psta->keep_alive_trycnt);
-					psta->expire_to = 1;
+					expire_asoc_sta_arm(pstapriv, psta, 1);
 					continue;
 				}
 			}
 			#endif /* CONFIG_ACTIVE_KEEP_ALIVE_CHECK */
 
 			psta->keep_alive_trycnt = 0;
+			psta->aka_probe = AKA_PROBE_NONE;
 			del_asoc_list[i] = chk_alive_list[i];
 			_enter_critical_bh(&pstapriv->asoc_list_lock, &irqL);
 			if (rtw_is_list_empty(&psta->asoc_list) == _FALSE) {
@@ -735,14 +824,6 @@ void	expire_timeout_chk(_adapter *padapter)
 				rtw_mesh_expire_peer(padapter, sta_addr);
 			#endif
 		}
-
-		#ifdef CONFIG_ACTIVE_KEEP_ALIVE_CHECK
-		if (pmlmeext->active_keep_alive_check) {
-			/* back to the original operation channel */
-			if (switch_channel_by_drv == _TRUE && backup_ch > 0)
-				set_channel_bwmode(padapter, backup_ch, backup_offset, backup_bw);
-		}
-		#endif
 	}
 
 #ifdef RTW_CONFIG_RFREG18_WA
@@ -2518,14 +2599,28 @@ void rtw_macaddr_acl_init(_adapter *adapter, u8 period)
 	_enter_critical_bh(&(acl_node_q->lock), &irqL);
 	_rtw_init_listhead(&(acl_node_q->queue));
 	acl->num = 0;
+	acl->used_map = 0;
 	acl->mode = RTW_ACL_MODE_DISABLED;
+	for (i = 0; i < RTW_ACL_HASH_NUM; i++)
+		_rtw_init_listhead(&acl->hash[i]);
 	for (i = 0; i < NUM_ACL; i++) {
 		_rtw_init_listhead(&acl->aclnode[i].list);
+		_rtw_init_listhead(&acl->aclnode[i].hash_list);
 		acl->aclnode[i].valid = _FALSE;
 	}
 	_exit_critical_bh(&(acl_node_q->lock), &irqL);
 }
 
+/* caller must hold acl->acl_node_q.lock */
+static void rtw_acl_node_release(struct wlan_acl_pool *acl, struct rtw_wlan_acl_node *acl_node)
+{
+	acl_node->valid = _FALSE;
+	rtw_list_delete(&acl_node->list);
+	rtw_list_delete(&acl_node->hash_list);
+	acl->used_map &= ~BIT(acl_node - acl->aclnode);
+	acl->num--;
+}
+
 static void _rtw_macaddr_acl_deinit(_adapter *adapter, u8 period, bool clear_only)
 {
 	struct sta_priv *stapriv = &adapter->stapriv;
@@ -2551,9 +2646,7 @@ static void _rtw_macaddr_acl_deinit(_adapter *adapter, u8 period, bool clear_onl
 		list = get_next(list);
 
 		if (acl_node->valid == _TRUE) {
-			acl_node->valid = _FALSE;
-			rtw_list_delete(&acl_node->list);
-			acl->num--;
+			rtw_acl_node_release(acl, acl_node);
 		}
 	}
 	_exit_critical_bh(&(acl_node_q->lock), &irqL);
@@ -2615,41 +2708,28 @@ int rtw_acl_add_sta(_adapter *adapter, u8 period, const u8 *addr)
 
 	_enter_critical_bh(&(acl_node_q->lock), &irqL);
 
-	head = get_list_head(acl_node_q);
-	list = get_next(head);
-
 	/* search for existed entry */
-	while (rtw_end_of_queue_search(head, list) == _FALSE) {
-		acl_node = LIST_CONTAINOR(list, struct rtw_wlan_acl_node, list);
-		list = get_next(list);
-
-		if (_rtw_memcmp(acl_node->addr, addr, ETH_ALEN)) {
-			if (acl_node->valid == _TRUE) {
-				existed = 1;
-				break;
-			}
-		}
-	}
-	if (existed)
+	if (rtw_acl_node_find(acl, addr)) {
+		existed = 1;
 		goto release_lock;
+	}
 
 	if (acl->num >= NUM_ACL)
 		goto release_lock;
 
 	/* find empty one and use */
-	for (i = 0; i < NUM_ACL; i++) {
-
+	i = rtw_ffz32(acl->used_map);
+	if (i < NUM_ACL) {
 		acl_node = &acl->aclnode[i];
-		if (acl_node->valid == _FALSE) {
 
-			_rtw_init_listhead(&acl_node->list);
-			_rtw_memcpy(acl_node->addr, addr, ETH_ALEN);
-			acl_node->valid = _TRUE;
+		_rtw_init_listhead(&acl_node->list);
+		_rtw_memcpy(acl_node->addr, addr, ETH_ALEN);
+		acl_node->valid = _TRUE;
 
-			rtw_list_insert_tail(&acl_node->list, get_list_head(acl_node_q));
-			acl->num++;
-			break;
-		}
+		rtw_list_insert_tail(&acl_node->list, get_list_head(acl_node_q));
+		rtw_list_insert_tail(&acl_node->hash_list, &acl->hash[acl_hash(addr)]);
+		acl->used_map |= BIT(i);
+		acl->num++;
 	}
 
 release_lock:
@@ -2688,6 +2768,15 @@ int rtw_acl_remove_sta(_adapter *adapter, u8 period, const u8 *addr)
 
 	_enter_critical_bh(&(acl_node_q->lock), &irqL);
 
+	if (!is_baddr) {
+		acl_node = rtw_acl_node_find(acl, addr);
+		if (acl_node) {
+			rtw_acl_node_release(acl, acl_node);
+			match = 1;
+		}
+		goto release_lock;
+	}
+
 	head = get_list_head(acl_node_q);
 	list = get_next(head);
 
@@ -2695,16 +2784,13 @@ int rtw_acl_remove_sta(_adapter *adapter, u8 period, const u8 *addr)
 		acl_node = LIST_CONTAINOR(list, struct rtw_wlan_acl_node, list);
 		list = get_next(list);
 
-		if (is_baddr || _rtw_memcmp(acl_node->addr, addr, ETH_ALEN)) {
-			if (acl_node->valid == _TRUE) {
-				acl_node->valid = _FALSE;
-				rtw_list_delete(&acl_node->list);
-				acl->num--;
-				match = 1;
-			}
+		if (acl_node->valid == _TRUE) {
+			rtw_acl_node_release(acl, acl_node);
+			match = 1;
 		}
 	}
 
+release_lock:
 	_exit_critical_bh(&(acl_node_q->lock), &irqL);
 
 	RTW_INFO(FUNC_ADPT_FMT" p=%u "MAC_FMT" %s (acl_num=%d)\n"
@@ -2893,7 +2979,7 @@ u8 rtw_ap_bmc_frames_hdl(_adapter *padapter)
 
 			rtw_list_delete(&pxmitframe->list);
 
-			psta_bmc->sleepq_len--;
+			rtw_sleepq_frame_out(psta_bmc, pxmitframe);
 			tx_counts++;
 
 			if (psta_bmc->sleepq_len > 0)
@@ -3921,7 +4007,7 @@ int rtw_ap_inform_ch_switch(_adapter *padapter, u8 new_ch, u8 ch_offset)
 		plist = get_next(plist);
 
 		issue_action_spct_ch_switch(padapter, psta->cmn.mac_addr, new_ch, ch_offset);
-		psta->expire_to = ((pstapriv->expire_to * 2) > 5) ? 5 : (pstapriv->expire_to * 2);
+		rtw_sta_expire_arm(pstapriv, psta, ((pstapriv->expire_to * 2) > 5) ? 5 : (pstapriv->expire_to * 2));
 	}
 	_exit_critical_bh(&pstapriv->asoc_list_lock, &irqL);
 
@@ -4157,8 +4243,7 @@ void start_ap_mode(_adapter *padapter)
 	psecuritypriv->dot118021x_bmc_cam_id = INVALID_SEC_MAC_CAM_ID;
 #endif
 
-	for (i = 0 ;  i < pstapriv->max_aid; i++)
-		pstapriv->sta_aid[i] = NULL;
+	rtw_aid_free_all(pstapriv);
 
 	psta = rtw_get_bcmc_stainfo(padapter);
 	/*_enter_critical_bh(&(pstapriv->sta_hash_lock), &irqL);*/
@@ -5142,14 +5227,14 @@ void rtw_ap_parse_sta_capability(_adapter *adapter, struct sta_info *sta, u8 *ca
 		sta->flags &= ~WLAN_STA_SHORT_PREAMBLE;
 }
 
-u16 rtw_ap_parse_sta_supported_rates(_adapter *adapter, struct sta_info *sta, u8 *tlv_ies, u16 tlv_ies_len)
+u16 rtw_ap_parse_sta_supported_rates(_adapter *adapter, struct sta_info *sta, struct rtw_ieee802_11_elems *elems)
 {
 	u8 rate_set[12];
 	u8 rate_num;
 	int i;
 	u16 status = _STATS_SUCCESSFUL_;
 
-	rtw_ies_get_supported_rate(tlv_ies, tlv_ies_len, rate_set, &rate_num);
+	rtw_ie_idx_get_supported_rate(&elems->idx, rate_set, &rate_num);
 	if (rate_num == 0) {
 		RTW_INFO(FUNC_ADPT_FMT" sta "MAC_FMT" with no supported rate\n"
 			, FUNC_ADPT_ARG(adapter), MAC_ARG(sta->cmn.mac_addr));
@@ -5340,7 +5425,7 @@ exit:
 	return status;
 }
 
-void rtw_ap_parse_sta_wmm_ie(_adapter *adapter, struct sta_info *sta, u8 *tlv_ies, u16 tlv_ies_len)
+void rtw_ap_parse_sta_wmm_ie(_adapter *adapter, struct sta_info *sta, struct rtw_ieee802_11_elems *elems)
 {
 	struct mlme_priv *mlme = &adapter->mlmepriv;
 	unsigned char WMM_IE[] = {0x00, 0x50, 0xf2, 0x02, 0x00, 0x01};
@@ -5365,7 +5450,7 @@ void rtw_ap_parse_sta_wmm_ie(_adapter *adapter, struct sta_info *sta, u8 *tlv_ie
 	}
 #endif
 
-	p = rtw_get_ie_ex(tlv_ies, tlv_ies_len, WLAN_EID_VENDOR_SPECIFIC, WMM_IE, 6, NULL, NULL);
+	p = rtw_ie_idx_get_ie_ex(&elems->idx, WLAN_EID_VENDOR_SPECIFIC, WMM_IE, 6, NULL, NULL);
 	if (!p)
 		goto exit;
 
@@ -29,13 +29,19 @@ No irqsave is necessary.
 sint	_rtw_init_cmd_priv(struct	cmd_priv *pcmdpriv)
 {
 	sint res = _SUCCESS;
+	int i;
 
 
 	_rtw_init_sema(&(pcmdpriv->cmd_queue_sema), 0);
 	/* _rtw_init_sema(&(pcmdpriv->cmd_done_sema), 0); */
 	_rtw_init_sema(&(pcmdpriv->start_cmdthread_sema), 0);
 
-	_rtw_init_queue(&(pcmdpriv->cmd_queue));
+	for (i = 0; i < CMD_CLS_NUM; i++)
+		_rtw_init_queue(&(pcmdpriv->cmd_queue[i]));
+	pcmdpriv->cls_credit[CMD_CLS_URGENT] = CMD_CLS_URGENT_QUOTA;
+	pcmdpriv->cls_credit[CMD_CLS_NORMAL] = CMD_CLS_NORMAL_QUOTA;
+	pcmdpriv->cls_credit[CMD_CLS_BG] = CMD_CLS_BG_QUOTA;
+	ATOMIC_SET(&pcmdpriv->cmd_kick, 0);
 
 	/* allocate DMA-able/Non-Page memory for cmd_buf and rsp_buf */
 
@@ -61,6 +67,9 @@ sint	_rtw_init_cmd_priv(struct	cmd_priv *pcmdpriv)
 
 	pcmdpriv->cmd_issued_cnt = pcmdpriv->cmd_done_cnt = pcmdpriv->rsp_cnt = 0;
 
+	/* latency stat is debug only, go on without it */
+	pcmdpriv->lat = rtw_zmalloc(sizeof(struct cmd_lat_stat) * CMD_LAT_STAT_NUM);
+
 	_rtw_mutex_init(&pcmdpriv->sctx_mutex);
 exit:
 
@@ -213,9 +222,11 @@ void _rtw_free_evt_priv(struct	evt_priv *pevtpriv)
 
 void _rtw_free_cmd_priv(struct	cmd_priv *pcmdpriv)
 {
+	int i;
 
 	if (pcmdpriv) {
-		_rtw_spinlock_free(&(pcmdpriv->cmd_queue.lock));
+		for (i = 0; i < CMD_CLS_NUM; i++)
+			_rtw_spinlock_free(&(pcmdpriv->cmd_queue[i].lock));
 		_rtw_free_sema(&(pcmdpriv->cmd_queue_sema));
 		/* _rtw_free_sema(&(pcmdpriv->cmd_done_sema)); */
 		_rtw_free_sema(&(pcmdpriv->start_cmdthread_sema));
@@ -226,6 +237,9 @@ void _rtw_free_cmd_priv(struct	cmd_priv *pcmdpriv)
 		if (pcmdpriv->rsp_allocated_buf)
 			rtw_mfree(pcmdpriv->rsp_allocated_buf, MAX_RSPSZ + 4);
 
+		if (pcmdpriv->lat)
+			rtw_mfree(pcmdpriv->lat, sizeof(struct cmd_lat_stat) * CMD_LAT_STAT_NUM);
+
 		_rtw_mutex_free(&pcmdpriv->sctx_mutex);
 	}
 }
@@ -430,6 +444,188 @@ int rtw_cmd_filter(struct cmd_priv *pcmdpriv, struct cmd_obj *cmd_obj)
 
 
 
+static int rtw_cmd_lat_idx(struct cmd_obj *pcmd)
+{
+	if (pcmd->cmdcode >= MAX_H2CCMD)
+		return -1;
+
+	if (pcmd->cmdcode == GEN_CMD_CODE(_Set_Drv_Extra)) {
+		struct drvextra_cmd_parm *extra_parm = (struct drvextra_cmd_parm *)pcmd->parmbuf;
+
+		if (extra_parm && extra_parm->ec_id < MAX_WK_CID)
+			return MAX_H2CCMD + extra_parm->ec_id;
+	}
+
+	return pcmd->cmdcode;
+}
+
+/*
+* Pick the queue class of a cmd.
+* Promoted cmds are triggered by frames of an established link (keys, BA),
+* demoted ones are periodic housekeeping; everything else stays in order.
+* A promoted cmd may still be kept in CMD_CLS_NORMAL by rtw_enqueue_cmd().
+*/
+static u8 rtw_cmd_classify(struct cmd_obj *cmd_obj)
+{
+	struct drvextra_cmd_parm *extra_parm;
+
+	switch (cmd_obj->cmdcode) {
+	case GEN_CMD_CODE(_SetStaKey):
+	case GEN_CMD_CODE(_AddBAReq):
+	case GEN_CMD_CODE(_AddBARsp):
+		return CMD_CLS_URGENT;
+	case GEN_CMD_CODE(_LedBlink):
+		return CMD_CLS_BG;
+	case GEN_CMD_CODE(_Set_Drv_Extra):
+		extra_parm = (struct drvextra_cmd_parm *)cmd_obj->parmbuf;
+		if (!extra_parm)
+			break;
+		if (extra_parm->ec_id == DYNAMIC_CHK_WK_CID
+			|| extra_parm->ec_id == SESSION_TRACKER_WK_CID)
+			return CMD_CLS_BG;
+		break;
+	default:
+		break;
+	}
+
+	return CMD_CLS_NORMAL;
+}
+
+/*
+* Return _TRUE if a cmd of adapter is pending in queue.
+* Used to keep a promoted cmd from overtaking e.g. _DisConnect or _JoinBss of
+* its adapter: the key or BA it sets up may belong to the link being torn down.
+*/
+static bool rtw_cmd_adapter_pending(_queue *queue, _adapter *adapter)
+{
+	struct cmd_obj *obj;
+	_list *phead, *plist;
+	_irqL irqL;
+	bool pending = _FALSE;
+
+	_enter_critical(&queue->lock, &irqL);
+
+	phead = get_list_head(queue);
+	for (plist = get_next(phead); plist != phead; plist = get_next(plist)) {
+		obj = LIST_CONTAINOR(plist, struct cmd_obj, list);
+		if (obj->padapter == adapter) {
+			pending = _TRUE;
+			break;
+		}
+	}
+
+	_exit_critical(&queue->lock, &irqL);
+
+	return pending;
+}
+
+/*
+* Coalescing key of a cmd: (ec_id, type, target sta) of a _Set_Drv_Extra whose
+* pending copy can be replaced by a newer one without changing the end result.
+* Cmds waited on by a caller are never coalesced.
+*/
+static bool rtw_cmd_coalesce_key(struct cmd_obj *obj, struct drvextra_cmd_parm **parm, void **sta)
+{
+	struct drvextra_cmd_parm *extra_parm;
+
+	if (obj->cmdcode != GEN_CMD_CODE(_Set_Drv_Extra) || obj->sctx || !obj->parmbuf)
+		return _FALSE;
+
+	extra_parm = (struct drvextra_cmd_parm *)obj->parmbuf;
+	*sta = NULL;
+
+	switch (extra_parm->ec_id) {
+	case DYNAMIC_CHK_WK_CID:
+	case LPS_CTRL_WK_CID:
+		break;
+	case SSMPS_WK_CID:
+		if (!extra_parm->pbuf)
+			return _FALSE;
+		*sta = ((struct ssmps_cmd_parm *)extra_parm->pbuf)->sta;
+		break;
+#ifdef CONFIG_CTRL_TXSS_BY_TP
+	case TXSS_WK_CID:
+		if (!extra_parm->pbuf)
+			return _FALSE;
+		*sta = ((struct txss_cmd_parm *)extra_parm->pbuf)->sta;
+		break;
+#endif
+	default:
+		return _FALSE;
+	}
+
+	*parm = extra_parm;
+	return _TRUE;
+}
+
+/*
+* Merge cmd_obj into a pending cmd with the same coalescing key.
+* Only the latest pending cmd of the same ec_id/adapter/sta is considered, so a
+* merge never moves a cmd across another one of its kind (e.g. LPS enter/leave).
+* The pending cmd keeps its queue position and takes over the newer parameters.
+* Return _TRUE if cmd_obj has been merged and freed.
+*/
+static bool rtw_cmd_coalesce(struct cmd_priv *pcmdpriv, struct cmd_obj *cmd_obj)
+{
+	_queue *queue = &pcmdpriv->cmd_queue[cmd_obj->cls];
+	struct drvextra_cmd_parm *parm, *pend_parm;
+	struct cmd_obj *pend = NULL, *obj;
+	void *sta, *pend_sta;
+	_list *phead, *plist;
+	_irqL irqL;
+	u8 *parmbuf;
+	int idx;
+
+	if (!rtw_cmd_coalesce_key(cmd_obj, &parm, &sta))
+		return _FALSE;
+
+	_enter_critical(&queue->lock, &irqL);
+
+	phead = get_list_head(queue);
+	for (plist = phead->prev; plist != phead; plist = plist->prev) {
+		obj = LIST_CONTAINOR(plist, struct cmd_obj, list);
+		if (obj->padapter != cmd_obj->padapter
+			|| obj->cmdcode != cmd_obj->cmdcode
+			|| !obj->parmbuf
+			|| ((struct drvextra_cmd_parm *)obj->parmbuf)->ec_id != parm->ec_id)
+			continue;
+
+		/* a waited one of the same kind can't be passed over */
+		if (!rtw_cmd_coalesce_key(obj, &pend_parm, &pend_sta))
+			break;
+		/* order against other stations doesn't matter */
+		if (pend_sta != sta)
+			continue;
+		if (pend_parm->type == parm->type)
+			pend = obj;
+		break;
+	}
+
+	if (pend) {
+		/* swap parameters, the older ones are freed with cmd_obj */
+		parmbuf = pend->parmbuf;
+		pend->parmbuf = cmd_obj->parmbuf;
+		cmd_obj->parmbuf = parmbuf;
+	}
+
+	_exit_critical(&queue->lock, &irqL);
+
+	if (!pend)
+		return _FALSE;
+
+	pcmdpriv->cmd_merged_cnt++;
+	idx = rtw_cmd_lat_idx(cmd_obj);
+	if (pcmdpriv->lat && idx >= 0)
+		pcmdpriv->lat[idx].merged++;
+
+	parm = (struct drvextra_cmd_parm *)cmd_obj->parmbuf;
+	if (parm->pbuf && parm->size > 0)
+		rtw_mfree(parm->pbuf, parm->size);
+	rtw_free_cmd_obj(cmd_obj);
+
+	return _TRUE;
+}
+
 u32 rtw_enqueue_cmd(struct cmd_priv *pcmdpriv, struct cmd_obj *cmd_obj)
 {
 	int res = _FAIL;
@@ -464,9 +660,25 @@ u32 rtw_enqueue_cmd(struct cmd_priv *pcmdpriv, struct cmd_obj *cmd_obj)
 		goto exit;
 	}
 
-	res = _rtw_enqueue_cmd(&pcmdpriv->cmd_queue, cmd_obj, 0);
+	cmd_obj->cls = rtw_cmd_classify(cmd_obj);
+	/* never reorder cmds of the same adapter */
+	if (cmd_obj->cls == CMD_CLS_URGENT
+		&& rtw_cmd_adapter_pending(&pcmdpriv->cmd_queue[CMD_CLS_NORMAL], cmd_obj->padapter))
+		cmd_obj->cls = CMD_CLS_NORMAL;
+	cmd_obj->enq_time = rtw_get_current_time();
 
-	if (res == _SUCCESS)
+	if (rtw_cmd_coalesce(pcmdpriv, cmd_obj)) {
+		/* pending cmd will do the work, no extra wakeup for cmd thread */
+		res = _SUCCESS;
+		goto exit;
+	}
+
+	pcmdpriv->cls_enq_cnt[cmd_obj->cls]++;
+
+	res = _rtw_enqueue_cmd(&pcmdpriv->cmd_queue[cmd_obj->cls], cmd_obj, 0);
+
+	/* cmd thread already kicked will pick this one up in the same batch */
+	if (res == _SUCCESS && ATOMIC_INC_RETURN(&pcmdpriv->cmd_kick) == 1)
 		_rtw_up_sema(&pcmdpriv->cmd_queue_sema);
 
 exit:
@@ -475,16 +687,144 @@ exit:
 	return res;
 }
 
+/*
+* Weighted round robin over the class queues, only called by rtw_cmd_thread.
+* A class is served while it has credit left, higher class first;
+* credits are refilled once every non-empty class has used up its quota.
+*/
 struct	cmd_obj	*rtw_dequeue_cmd(struct cmd_priv *pcmdpriv)
 {
-	struct cmd_obj *cmd_obj;
+	struct cmd_obj *cmd_obj = NULL;
+	u8 refill;
+	int i;
 
+	for (refill = 0; refill < 2 && !cmd_obj; refill++) {
+		for (i = 0; i < CMD_CLS_NUM; i++) {
+			if (!pcmdpriv->cls_credit[i])
+				continue;
+			cmd_obj = _rtw_dequeue_cmd(&pcmdpriv->cmd_queue[i]);
+			if (cmd_obj) {
+				pcmdpriv->cls_credit[i]--;
+				break;
+			}
+		}
 
-	cmd_obj = _rtw_dequeue_cmd(&pcmdpriv->cmd_queue);
+		if (!cmd_obj) {
+			pcmdpriv->cls_credit[CMD_CLS_URGENT] = CMD_CLS_URGENT_QUOTA;
+			pcmdpriv->cls_credit[CMD_CLS_NORMAL] = CMD_CLS_NORMAL_QUOTA;
+			pcmdpriv->cls_credit[CMD_CLS_BG] = CMD_CLS_BG_QUOTA;
+		}
+	}
 
 	return cmd_obj;
 }
 
+static bool rtw_cmd_queue_empty(struct cmd_priv *pcmdpriv)
+{
+	_irqL irqL;
+	bool empty = _TRUE;
+	int i;
+
+	for (i = 0; i < CMD_CLS_NUM && empty; i++) {
+		_enter_critical(&pcmdpriv->cmd_queue[i].lock, &irqL);
+		empty = rtw_is_list_empty(&(pcmdpriv->cmd_queue[i].queue));
+		_exit_critical(&pcmdpriv->cmd_queue[i].lock, &irqL);
+	}
+
+	return empty;
+}
+
+static void rtw_cmd_lat_update(struct cmd_priv *pcmdpriv, struct cmd_obj *pcmd, systime start, u32 run_ms)
+{
+	struct cmd_lat_stat *stat;
+	u32 wait_ms;
+	int idx;
+
+	idx = rtw_cmd_lat_idx(pcmd);
+	if (!pcmdpriv->lat || idx < 0)
+		return;
+
+	stat = &pcmdpriv->lat[idx];
+	wait_ms = rtw_get_time_interval_ms(pcmd->enq_time, start);
+
+	stat->cnt++;
+	if (wait_ms > stat->wait_max_ms)
+		stat->wait_max_ms = wait_ms;
+	if (run_ms > stat->run_max_ms)
+		stat->run_max_ms = run_ms;
+	stat->wait_hist[rtw_log2_bucket(wait_ms, CMD_LAT_HIST_NUM)]++;
+	stat->run_hist[rtw_log2_bucket(run_ms, CMD_LAT_HIST_NUM)]++;
+}
+
+void rtw_cmd_lat_reset(struct cmd_priv *cmdpriv)
+{
+	if (cmdpriv->lat)
+		_rtw_memset(cmdpriv->lat, 0, sizeof(struct cmd_lat_stat) * CMD_LAT_STAT_NUM);
+	_rtw_memset(cmdpriv->cls_enq_cnt, 0, sizeof(cmdpriv->cls_enq_cnt));
+	cmdpriv->cmd_merged_cnt = 0;
+	cmdpriv->wakeup_cnt = 0;
+	_rtw_memset(cmdpriv->batch_hist, 0, sizeof(cmdpriv->batch_hist));
+}
+
+static void dump_cmd_lat_hist(void *sel, const char *title, u32 *hist)
+{
+	int i;
+
+	RTW_PRINT_SEL(sel, "  %s(ms):", title);
+	for (i = 0; i < CMD_LAT_HIST_NUM; i++) {
+		if (!hist[i])
+			continue;
+		if (i == 0)
+			_RTW_PRINT_SEL(sel, " 0:%u", hist[i]);
+		else if (i == CMD_LAT_HIST_NUM - 1)
+			_RTW_PRINT_SEL(sel, " >=%u:%u", 1 << (i - 1), hist[i]);
+		else
+			_RTW_PRINT_SEL(sel, " <%u:%u", 1 << i, hist[i]);
+	}
+	_RTW_PRINT_SEL(sel, "\n");
+}
+
+void dump_cmd_lat(void *sel, struct cmd_priv *cmdpriv)
+{
+	struct cmd_lat_stat *stat;
+	int i;
+
+	RTW_PRINT_SEL(sel, "enq urgent:%u normal:%u bg:%u merged:%u\n"
+		, cmdpriv->cls_enq_cnt[CMD_CLS_URGENT], cmdpriv->cls_enq_cnt[CMD_CLS_NORMAL], cmdpriv->cls_enq_cnt[CMD_CLS_BG]
+		, cmdpriv->cmd_merged_cnt);
+
+	RTW_PRINT_SEL(sel, "wakeup:%u batch:", cmdpriv->wakeup_cnt);
+	for (i = 0; i < CMD_BATCH_HIST_NUM; i++) {
+		if (!cmdpriv->batch_hist[i])
+			continue;
+		if (i == 0)
+			_RTW_PRINT_SEL(sel, " 0:%u", cmdpriv->batch_hist[i]);
+		else if (i == CMD_BATCH_HIST_NUM - 1)
+			_RTW_PRINT_SEL(sel, " >=%u:%u", 1 << (i - 1), cmdpriv->batch_hist[i]);
+		else
+			_RTW_PRINT_SEL(sel, " <%u:%u", 1 << i, cmdpriv->batch_hist[i]);
+	}
+	_RTW_PRINT_SEL(sel, "\n");
+
+	if (!cmdpriv->lat)
+		return;
+
+	for (i = 0; i < CMD_LAT_STAT_NUM; i++) {
+		stat = &cmdpriv->lat[i];
+		if (!stat->cnt && !stat->merged)
+			continue;
+
+		if (i < MAX_H2CCMD)
+			RTW_PRINT_SEL(sel, "cmd:%d", i);
+		else
+			RTW_PRINT_SEL(sel, "cmd:%d,%d", GEN_CMD_CODE(_Set_Drv_Extra), i - MAX_H2CCMD);
+		_RTW_PRINT_SEL(sel, " cnt:%u merged:%u wait_max:%ums run_max:%ums\n"
+			, stat->cnt, stat->merged, stat->wait_max_ms, stat->run_max_ms);
+		dump_cmd_lat_hist(sel, "wait", stat->wait_hist);
+		dump_cmd_lat_hist(sel, "run", stat->run_hist);
+	}
+}
+
 void rtw_cmd_clr_isr(struct	cmd_priv *pcmdpriv)
 {
 	pcmdpriv->cmd_done_cnt++;
@@ -530,12 +870,15 @@ thread_return rtw_cmd_thread(thread_context context)
 	PADAPTER padapter = (PADAPTER)context;
 	struct cmd_priv *pcmdpriv = &(padapter->cmdpriv);
 	struct drvextra_cmd_parm *extra_parm = NULL;
+	u32 batch = 0;
 	_irqL irqL;
 
 	thread_enter("RTW_CMD_THREAD");
 
 	pcmdbuf = pcmdpriv->cmd_buf;
 	prspbuf = pcmdpriv->rsp_buf;
+	/* a kick left by cmds enqueued before last stop would swallow every later one */
+	ATOMIC_SET(&pcmdpriv->cmd_kick, 0);
 	ATOMIC_SET(&(pcmdpriv->cmdthd_running), _TRUE);
 	_rtw_up_sema(&pcmdpriv->start_cmdthread_sema);
 
@@ -554,13 +897,20 @@ thread_return rtw_cmd_thread(thread_context context)
 			break;
 		}
 
-		_enter_critical(&pcmdpriv->cmd_queue.lock, &irqL);
-		if (rtw_is_list_empty(&(pcmdpriv->cmd_queue.queue))) {
+		/*
+		* Rearm the kick before draining, cmds enqueued from now on either
+		* get dequeued in this batch or up the sema for the next one
+		*/
+		ATOMIC_SET(&pcmdpriv->cmd_kick, 0);
+		rtw_mb();
+		pcmdpriv->wakeup_cnt++;
+		batch = 0;
+
+		if (rtw_cmd_queue_empty(pcmdpriv)) {
 			/* RTW_INFO("%s: cmd queue is empty!\n", __func__); */
-			_exit_critical(&pcmdpriv->cmd_queue.lock, &irqL);
+			pcmdpriv->batch_hist[0]++;
 			continue;
 		}
-		_exit_critical(&pcmdpriv->cmd_queue.lock, &irqL);
 
 _next:
 		if (RTW_CANNOT_RUN(padapter)) {
@@ -577,11 +927,13 @@ _next:
 #ifdef CONFIG_LPS_LCLK
 			rtw_unregister_cmd_alive(padapter);
 #endif
+			pcmdpriv->batch_hist[rtw_log2_bucket(batch, CMD_BATCH_HIST_NUM)]++;
 			continue;
 		}
 
 		cmd_start_time = rtw_get_current_time();
 		pcmdpriv->cmd_issued_cnt++;
+		batch++;
 
 		if (pcmd->cmdsz > MAX_CMDSZ) {
 			RTW_ERR("%s cmdsz:%d > MAX_CMDSZ:%d\n", __func__, pcmd->cmdsz, MAX_CMDSZ);
@@ -625,8 +977,10 @@ _next:
 					RTW_PRINT("%s: wait to leave LPS_LCLK\n", __func__);
 
 				pcmd->res = H2C_ENQ_HEAD;
-				ret = _rtw_enqueue_cmd(&pcmdpriv->cmd_queue, pcmd, 1);
+				ret = _rtw_enqueue_cmd(&pcmdpriv->cmd_queue[pcmd->cls], pcmd, 1);
 				if (ret == _SUCCESS) {
+					/* not served yet, give the credit back */
+					pcmdpriv->cls_credit[pcmd->cls]++;
 					if (DBG_CMD_EXECUTE)
 						RTW_INFO(ADPT_FMT" "CMD_FMT" ENQ_HEAD\n", ADPT_ARG(pcmd->padapter), CMD_ARG(pcmd));
 					continue;
@@ -663,6 +1017,7 @@ post_process:
 		_exit_critical_mutex(&(pcmd->padapter->cmdpriv.sctx_mutex), NULL);
 
 		cmd_process_time = rtw_get_passing_time_ms(cmd_start_time);
+		rtw_cmd_lat_update(pcmdpriv, pcmd, cmd_start_time, cmd_process_time);
 		if (cmd_process_time > 1000) {
 			RTW_INFO(ADPT_FMT" "CMD_FMT" process_time=%d\n", ADPT_ARG(pcmd->padapter), CMD_ARG(pcmd), cmd_process_time);
 			if (0)
@@ -694,6 +1049,7 @@ post_process:
 
 	/* to avoid enqueue cmd after free all cmd_obj */
 	ATOMIC_SET(&(pcmdpriv->cmdthd_running), _FALSE);
+	ATOMIC_SET(&pcmdpriv->cmd_kick, 0);
 
 	/* free all cmd_obj resources */
 	do {
@@ -897,7 +1253,7 @@ u8 rtw_sitesurvey_cmd(_adapter *padapter, struct sitesurvey_parm *pparm)
 		u32 scan_timeout_ms;
 
 		pmlmepriv->scan_start_time = rtw_get_current_time();
-		scan_timeout_ms = rtw_scan_timeout_decision(padapter);
+		scan_timeout_ms = rtw_scan_timeout_decision(padapter, psurveyPara);
 		mlme_set_scan_to_timer(pmlmepriv,scan_timeout_ms);
 
 		rtw_led_control(padapter, LED_CTL_SITE_SURVEY);
@@ -3299,43 +3655,198 @@ void rtw_iface_dynamic_chk_wk_hdl(_adapter *padapter)
 
 
 }
-void rtw_dynamic_chk_wk_hdl(_adapter *padapter)
+static void wdog_task_iface(_adapter *padapter)
 {
 	rtw_mi_dynamic_chk_wk_hdl(padapter);
+}
 
+static void wdog_task_health(_adapter *padapter)
+{
 #ifdef DBG_CONFIG_ERROR_DETECT
 	rtw_hal_sreset_xmit_status_check(padapter);
 	rtw_hal_sreset_linked_status_check(padapter);
 #endif
-
-	/* if(check_fwstate(pmlmepriv, _FW_UNDER_LINKING|_FW_UNDER_SURVEY)==_FALSE) */
-	{
 #ifdef DBG_RX_COUNTER_DUMP
-		rtw_dump_rx_counters(padapter);
+	rtw_dump_rx_counters(padapter);
 #endif
-		dm_DynamicUsbTxAgg(padapter, 0);
-	}
-	rtw_hal_dm_watchdog(padapter);
+}
 
+static void wdog_task_usb_agg(_adapter *padapter)
+{
+	dm_DynamicUsbTxAgg(padapter, 0);
+}
+
+static void wdog_task_dm(_adapter *padapter)
+{
+	rtw_hal_dm_watchdog(padapter);
 	/* check_hw_pbc(padapter, pdrvextra_cmd->pbuf, pdrvextra_cmd->type); */
+}
 
+static void wdog_task_btcoex(_adapter *padapter)
+{
 #ifdef CONFIG_BT_COEXIST
-	/* BT-Coexist */
 	rtw_btcoex_Handler(padapter);
 #endif
+}
 
+static void wdog_task_ps(_adapter *padapter)
+{
 #ifdef CONFIG_IPS_CHECK_IN_WD
-	/* always call rtw_ps_processor() at last one. */
 	rtw_ps_processor(padapter);
 #endif
+}
 
+static void wdog_task_mcc(_adapter *padapter)
+{
 #ifdef CONFIG_MCC_MODE
 	rtw_hal_mcc_sw_status_check(padapter);
-#endif /* CONFIG_MCC_MODE */
+#endif
+}
 
+static void wdog_task_tsf(_adapter *padapter)
+{
 	rtw_hal_periodic_tsf_update_chk(padapter);
 }
 
+/* USB agg thresholds only depend on link state and throughput level */
+static bool wdog_task_usb_agg_stable(_adapter *padapter)
+{
+	return !adapter_to_dvobj(padapter)->wdog_input_changed;
+}
+
+/* nothing associated, scanning or joining: phydm has nothing to track */
+static bool wdog_task_dm_stable(_adapter *padapter)
+{
+	return !adapter_to_dvobj(padapter)->wdog_input_changed
+		&& !rtw_mi_check_status(padapter, MI_ASSOC)
+		&& !rtw_mi_check_fwstate(padapter, _FW_UNDER_SURVEY | _FW_UNDER_LINKING);
+}
+
+/*
+* Tasks counting watchdog ticks (keep-alive, traffic watchdog, btcoex, IPS,
+* sreset) keep a fixed period of 1, only those whose output is a pure
+* function of slowly changing inputs back off while the inputs are stable.
+*/
+static const struct {
+	const char *name;
+	void (*hdl)(_adapter *padapter);
+	bool (*stable)(_adapter *padapter);
+	u8 period_max;
+} wdog_task_def[WDOG_TASK_NUM] = {
+	[WDOG_TASK_IFACE] = {"iface", wdog_task_iface, NULL, 1},
+	[WDOG_TASK_HEALTH] = {"health", wdog_task_health, NULL, 1},
+	[WDOG_TASK_USB_AGG] = {"usb_agg", wdog_task_usb_agg, wdog_task_usb_agg_stable, 8},
+	[WDOG_TASK_DM] = {"dm", wdog_task_dm, wdog_task_dm_stable, 4},
+	[WDOG_TASK_BTCOEX] = {"btcoex", wdog_task_btcoex, NULL, 1},
+	/* always call rtw_ps_processor() after the others */
+	[WDOG_TASK_PS] = {"ps", wdog_task_ps, NULL, 1},
+	[WDOG_TASK_MCC] = {"mcc", wdog_task_mcc, NULL, 1},
+	[WDOG_TASK_TSF] = {"tsf", wdog_task_tsf, NULL, 1},
+};
+
+static u32 rtw_wdog_xfer_cnt(struct dvobj_priv *dvobj)
+{
+#ifdef CONFIG_USB_HCI
+	return ATOMIC_READ(&dvobj->usb_ctrl_xfer_cnt);
+#else
+	return 0;
+#endif
+}
+
+static void rtw_wdog_input_update(_adapter *padapter)
+{
+	struct dvobj_priv *dvobj = adapter_to_dvobj(padapter);
+	u32 tp = dvobj->traffic_stat.cur_tx_tp + dvobj->traffic_stat.cur_rx_tp;
+	u32 last = dvobj->wdog_last_tp;
+	u32 diff = tp > last ? tp - last : last - tp;
+	u8 assoc = rtw_mi_check_status(padapter, MI_ASSOC) ? 1 : 0;
+
+	/* a change of more than 1/4 (at least 1Mbps) or of link state */
+	dvobj->wdog_input_changed = diff > rtw_max(1, (last >> 2)) || assoc != dvobj->wdog_last_assoc;
+	dvobj->wdog_last_tp = tp;
+	dvobj->wdog_last_assoc = assoc;
+}
+
+void rtw_dynamic_chk_wk_hdl(_adapter *padapter)
+{
+	struct dvobj_priv *dvobj = adapter_to_dvobj(padapter);
+	struct rtw_wdog_task *task;
+	u64 start_us;
+	u32 xfer, time_us;
+	bool stable;
+	int i;
+
+	rtw_wdog_input_update(padapter);
+
+	for (i = 0; i < WDOG_TASK_NUM; i++) {
+		task = &dvobj->wdog_task[i];
+		stable = wdog_task_def[i].stable && wdog_task_def[i].stable(padapter);
+
+		if (!stable) {
+			/* tighten, run now */
+			task->period = 1;
+			task->countdown = 0;
+		}
+
+		if (task->countdown) {
+			task->countdown--;
+			task->skip_cnt++;
+			continue;
+		}
+
+		start_us = rtw_get_current_time_us();
+		xfer = rtw_wdog_xfer_cnt(dvobj);
+
+		wdog_task_def[i].hdl(padapter);
+
+		time_us = (u32)(rtw_get_current_time_us() - start_us);
+		task->run_cnt++;
+		task->time_us += time_us;
+		if (time_us > task->time_max_us)
+			task->time_max_us = time_us;
+		task->xfer_cnt += rtw_wdog_xfer_cnt(dvobj) - xfer;
+
+		/* back off while inputs stay stable */
+		if (stable)
+			task->period = rtw_min((task->period << 1), wdog_task_def[i].period_max);
+		if (!task->period)
+			task->period = 1;
+		task->countdown = task->period - 1;
+	}
+}
+
+void rtw_wdog_task_reset(_adapter *adapter)
+{
+	struct dvobj_priv *dvobj = adapter_to_dvobj(adapter);
+	struct rtw_wdog_task *task;
+	int i;
+
+	for (i = 0; i < WDOG_TASK_NUM; i++) {
+		task = &dvobj->wdog_task[i];
+		task->run_cnt = task->skip_cnt = 0;
+		task->time_us = 0;
+		task->time_max_us = 0;
+		task->xfer_cnt = 0;
+	}
+}
+
+void dump_wdog_task(void *sel, _adapter *adapter)
+{
+	struct dvobj_priv *dvobj = adapter_to_dvobj(adapter);
+	struct rtw_wdog_task *task;
+	int i;
+
+	RTW_PRINT_SEL(sel, "%-8s %6s %8s %8s %8s %8s %8s\n"
+		, "task", "period", "run", "skip", "avg_us", "max_us", "xfer");
+	for (i = 0; i < WDOG_TASK_NUM; i++) {
+		task = &dvobj->wdog_task[i];
+		RTW_PRINT_SEL(sel, "%-8s %6u %8u %8u %8u %8u %8u\n"
+			, wdog_task_def[i].name, task->period, task->run_cnt, task->skip_cnt
+			, task->run_cnt ? (u32)rtw_division64(task->time_us, task->run_cnt) : 0
+			, task->time_max_us, task->xfer_cnt);
+	}
+}
+
 #ifdef CONFIG_LPS
 struct lps_ctrl_wk_parm {
 	u8 lps_level;
@@ -5752,12 +6263,13 @@ void rtw_create_ibss_post_hdl(_adapter *padapter, int status)
 				_exit_critical_bh(&(pmlmepriv->scanned_queue.lock), &irqL);
 				goto createbss_cmd_fail;
 			}
-			pwlan->last_scanned = rtw_get_current_time();
+			rtw_scanned_network_touch(pmlmepriv, pwlan);
 		} else
-			rtw_list_insert_tail(&(pwlan->list), &pmlmepriv->scanned_queue.queue);
+			rtw_scanned_network_link(pmlmepriv, pwlan);
 
 		pdev_network->Length = get_WLAN_BSSID_EX_sz(pdev_network);
 		_rtw_memcpy(&(pwlan->network), pdev_network, pdev_network->Length);
+		rtw_scanned_network_rehash(pmlmepriv, pwlan);
 		/* pwlan->fixed = _TRUE; */
 
 		/* copy pdev_network information to pmlmepriv->cur_network */
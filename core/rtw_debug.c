@@ -387,8 +387,10 @@ void sta_rx_reorder_ctl_dump(void *sel, struct sta_info *sta)
 	struct recv_reorder_ctrl *reorder_ctl;
 	int i;
 
-	for (i = 0; i < 16; i++) {
-		reorder_ctl = &sta->recvreorder_ctrl[i];
+	for (i = 0; i < TID_NUM; i++) {
+		reorder_ctl = sta->recvreorder_ctrl[i];
+		if (!reorder_ctl)
+			continue;
 		if (reorder_ctl->ampdu_size != RX_AMPDU_SIZE_INVALID || reorder_ctl->indicate_seq != 0xFFFF) {
 			RTW_PRINT_SEL(sel, "tid=%d, enable=%d, ampdu_size=%u, indicate_seq=%u\n"
 				, i, reorder_ctl->enable, reorder_ctl->ampdu_size, reorder_ctl->indicate_seq
@@ -871,6 +873,385 @@ int proc_get_rx_stat(struct seq_file *m, void *v)
 	return 0;
 }
 
+#ifdef CONFIG_TX_CMPL_TRACK
+static void dump_tx_cmpl_track(void *sel, struct sta_info *psta)
+{
+	struct tx_cmpl_track *track = &psta->tx_cmpl;
+	int i;
+
+	RTW_PRINT_SEL(sel, "macid:%u "MAC_FMT" ok:%u fail:%u overflow:%u lost:%u outstanding:%u lat_max:%uus\n"
+		, psta->cmn.mac_id, MAC_ARG(psta->cmn.mac_addr), track->ok, track->fail, track->overflow, track->lost
+		, (track->tail - track->head) & (TX_CMPL_FIFO_SZ - 1), track->lat_max_us);
+
+	RTW_PRINT_SEL(sel, "latency(us):");
+	for (i = 0; i < TX_CMPL_LAT_HIST_NUM; i++) {
+		if (!track->lat_hist[i])
+			continue;
+		if (i == 0)
+			_RTW_PRINT_SEL(sel, " 0:%u", track->lat_hist[i]);
+		else if (i == TX_CMPL_LAT_HIST_NUM - 1)
+			_RTW_PRINT_SEL(sel, " >=%u:%u", 1 << (i - 1), track->lat_hist[i]);
+		else
+			_RTW_PRINT_SEL(sel, " <%u:%u", 1 << i, track->lat_hist[i]);
+	}
+	_RTW_PRINT_SEL(sel, "\n");
+
+	RTW_PRINT_SEL(sel, "retry:");
+	for (i = 0; i < TX_CMPL_RETRY_HIST_NUM; i++)
+		_RTW_PRINT_SEL(sel, " %u%s:%u", i, i == TX_CMPL_RETRY_HIST_NUM - 1 ? "+" : "", track->retry_hist[i]);
+	_RTW_PRINT_SEL(sel, "\n");
+
+	RTW_PRINT_SEL(sel, "final rate:");
+	for (i = 0; i < TX_CMPL_RATE_NUM; i++) {
+		if (track->rate_cnt[i])
+			_RTW_PRINT_SEL(sel, " %s:%u", HDATA_RATE(i), track->rate_cnt[i]);
+	}
+	_RTW_PRINT_SEL(sel, "\n");
+}
+
+int proc_get_tx_cmpl_stat(struct seq_file *m, void *v)
+{
+	_irqL irqL;
+	_list *plist, *phead;
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct xmit_priv *pxmitpriv = &adapter->xmitpriv;
+	struct sta_priv *pstapriv = &adapter->stapriv;
+	struct sta_info *psta;
+	u8 bc_addr[ETH_ALEN] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+	int i;
+
+	RTW_PRINT_SEL(m, "sample:%u (1 of every N data frames, 0:disable)\n", pxmitpriv->tx_cmpl_sample);
+
+	_enter_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+	for (i = 0; i < NUM_STA; i++) {
+		phead = &(pstapriv->sta_hash[i]);
+		plist = get_next(phead);
+		while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
+			psta = LIST_CONTAINOR(plist, struct sta_info, hash_list);
+			plist = get_next(plist);
+
+			if (_rtw_memcmp(psta->cmn.mac_addr, bc_addr, ETH_ALEN) == _TRUE
+				|| _rtw_memcmp(psta->cmn.mac_addr, adapter_mac_addr(adapter), ETH_ALEN) == _TRUE)
+				continue;
+
+			dump_tx_cmpl_track(m, psta);
+		}
+	}
+	_exit_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+
+	return 0;
+}
+
+ssize_t proc_set_tx_cmpl_stat(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct sta_priv *pstapriv = &adapter->stapriv;
+	_irqL irqL;
+	_list *plist, *phead;
+	struct sta_info *psta;
+	char tmp[32];
+	u32 sample;
+	int i;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		if (strncmp(tmp, "clear", 5) == 0) {
+			_enter_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+			for (i = 0; i < NUM_STA; i++) {
+				phead = &(pstapriv->sta_hash[i]);
+				plist = get_next(phead);
+				while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
+					psta = LIST_CONTAINOR(plist, struct sta_info, hash_list);
+					plist = get_next(plist);
+					rtw_tx_cmpl_track_reset(psta);
+				}
+			}
+			_exit_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+		} else if (sscanf(tmp, "%u", &sample) == 1) {
+			adapter->xmitpriv.tx_cmpl_sample = rtw_min(sample, 0xFFFF);
+			RTW_INFO(FUNC_ADPT_FMT" tx_cmpl_sample:%u\n", FUNC_ADPT_ARG(adapter), adapter->xmitpriv.tx_cmpl_sample);
+		}
+	}
+
+	return count;
+}
+#endif /* CONFIG_TX_CMPL_TRACK */
+
+#ifdef CONFIG_RTW_HOST_RA
+int proc_get_host_ra(struct seq_file *m, void *v)
+{
+	_irqL irqL;
+	_list *plist, *phead;
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct xmit_priv *pxmitpriv = &adapter->xmitpriv;
+	struct sta_priv *pstapriv = &adapter->stapriv;
+	struct sta_info *psta;
+	int i;
+
+	RTW_PRINT_SEL(m, "en:%u sample_intvl:%u rpt_intvl:%u\n"
+		, pxmitpriv->host_ra_en, pxmitpriv->host_ra_sample_intvl, pxmitpriv->host_ra_rpt_intvl);
+
+	_enter_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+	for (i = 0; i < NUM_STA; i++) {
+		phead = &(pstapriv->sta_hash[i]);
+		plist = get_next(phead);
+		while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
+			psta = LIST_CONTAINOR(plist, struct sta_info, hash_list);
+			plist = get_next(plist);
+			dump_host_ra(m, psta);
+		}
+	}
+	_exit_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+
+	return 0;
+}
+
+/* <en> [<sample_intvl> [<rpt_intvl>]] or "clear" */
+ssize_t proc_set_host_ra(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct xmit_priv *pxmitpriv = &adapter->xmitpriv;
+	struct sta_priv *pstapriv = &adapter->stapriv;
+	_irqL irqL;
+	_list *plist, *phead;
+	struct sta_info *psta;
+	char tmp[32];
+	u32 en, sample_intvl, rpt_intvl;
+	int i, num;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		if (strncmp(tmp, "clear", 5) == 0) {
+			_enter_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+			for (i = 0; i < NUM_STA; i++) {
+				phead = &(pstapriv->sta_hash[i]);
+				plist = get_next(phead);
+				while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
+					psta = LIST_CONTAINOR(plist, struct sta_info, hash_list);
+					plist = get_next(plist);
+					rtw_host_ra_reset(psta);
+				}
+			}
+			_exit_critical_bh(&pstapriv->sta_hash_lock, &irqL);
+			return count;
+		}
+
+		num = sscanf(tmp, "%u %u %u", &en, &sample_intvl, &rpt_intvl);
+		if (num < 1)
+			return count;
+
+		if (num >= 2)
+			pxmitpriv->host_ra_sample_intvl = rtw_min(sample_intvl, 0xFFFF);
+		if (num >= 3)
+			pxmitpriv->host_ra_rpt_intvl = rtw_max(rtw_min(rpt_intvl, 0xFFFF), 1);
+		pxmitpriv->host_ra_en = en ? 1 : 0;
+
+		RTW_INFO(FUNC_ADPT_FMT" host_ra en:%u sample_intvl:%u rpt_intvl:%u\n", FUNC_ADPT_ARG(adapter)
+			, pxmitpriv->host_ra_en, pxmitpriv->host_ra_sample_intvl, pxmitpriv->host_ra_rpt_intvl);
+	}
+
+	return count;
+}
+#endif /* CONFIG_RTW_HOST_RA */
+
+#ifdef CONFIG_RTW_IQK_CACHE
+int proc_get_iqk_cache(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	dump_iqk_cache(m, adapter);
+
+	return 0;
+}
+
+/* <mode> or "clear" */
+ssize_t proc_set_iqk_cache(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+	u32 mode;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		if (strncmp(tmp, "clear", 5) == 0) {
+			rtw_hal_iqk_cache_flush(adapter);
+			return count;
+		}
+
+		if (sscanf(tmp, "%u", &mode) != 1 || mode > 2)
+			return count;
+
+		adapter->registrypriv.iqk_cache = mode;
+		if (!mode)
+			rtw_hal_iqk_cache_flush(adapter);
+
+		RTW_INFO(FUNC_ADPT_FMT" iqk_cache mode:%u\n", FUNC_ADPT_ARG(adapter), mode);
+	}
+
+	return count;
+}
+#endif /* CONFIG_RTW_IQK_CACHE */
+
+int proc_get_cmd_lat(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	/* cmd thread and its queues belong to the primary adapter */
+	dump_cmd_lat(m, &GET_PRIMARY_ADAPTER(adapter)->cmdpriv);
+
+	return 0;
+}
+
+ssize_t proc_set_cmd_lat(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		if (strncmp(tmp, "clear", 5) == 0)
+			rtw_cmd_lat_reset(&GET_PRIMARY_ADAPTER(adapter)->cmdpriv);
+	}
+
+	return count;
+}
+
+int proc_get_wdog_task(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	dump_wdog_task(m, adapter);
+
+	return 0;
+}
+
+ssize_t proc_set_wdog_task(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		if (strncmp(tmp, "clear", 5) == 0)
+			rtw_wdog_task_reset(adapter);
+	}
+
+	return count;
+}
+
+int proc_get_tx_ac_quota(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct xmit_priv *pxmitpriv = &adapter->xmitpriv;
+	const char *ac_str[4] = {"VO", "VI", "BE", "BK"};
+	int i;
+
+	RTW_PRINT_SEL(m, "free_xmitframe_cnt:%u\n", pxmitpriv->free_xmitframe_cnt);
+	RTW_PRINT_SEL(m, "%-2s %5s %5s %5s %5s %10s\n", "AC", "rsvd", "quota", "used", "avail", "drop");
+	for (i = 0; i < 4; i++) {
+		RTW_PRINT_SEL(m, "%-2s %5u %5u %5u %5u %10u\n", ac_str[i]
+			, pxmitpriv->xmitframe_ac_rsvd[i], pxmitpriv->xmitframe_ac_quota[i]
+			, pxmitpriv->xmitframe_ac_cnt[i], rtw_xmitframe_ac_avail(pxmitpriv, i)
+			, pxmitpriv->tx_ac_drop[i]);
+	}
+	RTW_PRINT_SEL(m, "xmitbuf_rsvd:%u, free_xmitbuf_cnt:%u\n"
+		, pxmitpriv->xmitbuf_rsvd, pxmitpriv->free_xmitbuf_cnt);
+
+	return 0;
+}
+
+ssize_t proc_set_tx_ac_quota(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct xmit_priv *pxmitpriv = &adapter->xmitpriv;
+	_irqL irqL;
+	char tmp[32];
+	u32 ac, rsvd, quota;
+	int num;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		if (strncmp(tmp, "xmitbuf", 7) == 0) {
+			if (sscanf(tmp + 7, "%u", &rsvd) == 1)
+				pxmitpriv->xmitbuf_rsvd = rtw_min(rsvd, NR_XMITBUFF / 2);
+			goto exit;
+		}
+
+		num = sscanf(tmp, "%u %u %u", &ac, &rsvd, &quota);
+		if (num < 2 || ac >= 4) {
+			RTW_INFO("usage: <ac(0:VO,1:VI,2:BE,3:BK)> <rsvd> [<quota>] or xmitbuf <rsvd>\n");
+			goto exit;
+		}
+
+		_enter_critical_bh(&pxmitpriv->free_xmit_queue.lock, &irqL);
+		pxmitpriv->xmitframe_ac_rsvd[ac] = rtw_min(rsvd, NR_XMITFRAME / 8);
+		if (num >= 3)
+			pxmitpriv->xmitframe_ac_quota[ac] = rtw_min(quota, NR_XMITFRAME);
+		_exit_critical_bh(&pxmitpriv->free_xmit_queue.lock, &irqL);
+	}
+
+exit:
+	return count;
+}
+
 int proc_get_tx_stat(struct seq_file *m, void *v)
 {
 	_irqL	irqL;
@@ -997,6 +1378,44 @@ int proc_get_mlmext_state(struct seq_file *m, void *v)
 	return 0;
 }
 
+int proc_get_fast_reconn(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+
+	dump_fast_reconn(m, adapter);
+
+	return 0;
+}
+
+ssize_t proc_set_fast_reconn(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct mlme_priv *mlme = &adapter->mlmepriv;
+
+	char tmp[32];
+	u32 exp_ms;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		int num = sscanf(tmp, "%u", &exp_ms);
+
+		if (num >= 1)
+			mlme->fast_reconn_exp_ms = exp_ms;
+	}
+
+	return count;
+}
+
 #ifdef CONFIG_LAYER2_ROAMING
 int proc_get_roam_flags(struct seq_file *m, void *v)
 {
@@ -1252,6 +1671,12 @@ int proc_get_scan_param(struct seq_file *m, void *v)
 		SCAN_PARAM_VALUE_ARG_BACKOP
 	);
 
+#ifdef CONFIG_SCAN_BACKOP
+	RTW_PRINT_SEL(m, "bg_scan tl:%u slice_ch_num:%u slice_backop_ms:%u offch_budget_ms:%u slice_cnt:%u defer_cnt:%u\n"
+		, ss->bg_tl, ss->slice_ch_num, ss->slice_backop_ms, ss->offch_budget_ms
+		, ss->bg_slice_cnt, ss->bg_defer_cnt);
+#endif
+
 	return 0;
 }
 
@@ -3183,6 +3608,70 @@ int proc_get_tx_amsdu(struct seq_file *m, void *v)
 	return 0;
 }
 
+int proc_get_tx_amsdu_adapt(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	const char *ac_str[4] = {"VO", "VI", "BE", "BK"};
+	int i, j;
+
+	RTW_PRINT_SEL(m, "max_num=%u, lat_budget=%u us\n"
+		, padapter->tx_amsdu_max_num, padapter->tx_amsdu_lat_budget);
+
+	RTW_PRINT_SEL(m, "%-2s", "AC");
+	for (j = 1; j <= RTW_AMSDU_ADAPT_MAX_NUM; j++)
+		_RTW_PRINT_SEL(m, " %8s%u", "num", j);
+	for (j = 0; j < RTW_AMSDU_FLUSH_NUM; j++)
+		_RTW_PRINT_SEL(m, " %9s", amsdu_flush_reason_str(j));
+	_RTW_PRINT_SEL(m, "\n");
+
+	for (i = 0; i < 4; i++) {
+		RTW_PRINT_SEL(m, "%-2s", ac_str[i]);
+		for (j = 1; j <= RTW_AMSDU_ADAPT_MAX_NUM; j++)
+			_RTW_PRINT_SEL(m, " %9u", pxmitpriv->amsdu_adapt_num_cnt[i][j]);
+		for (j = 0; j < RTW_AMSDU_FLUSH_NUM; j++)
+			_RTW_PRINT_SEL(m, " %9u", pxmitpriv->amsdu_adapt_flush_cnt[i][j]);
+		_RTW_PRINT_SEL(m, "\n");
+	}
+
+	return 0;
+}
+
+ssize_t proc_set_tx_amsdu_adapt(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+	char tmp[32];
+	u32 max_num, lat_budget;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		int num = sscanf(tmp, "%u %u", &max_num, &lat_budget);
+
+		if (num >= 1) {
+			if (max_num == 0) {
+				/* "0" clears statistics only */
+				rtw_amsdu_adapt_stats_reset(padapter);
+				return count;
+			}
+			padapter->tx_amsdu_max_num = rtw_min(max_num, RTW_AMSDU_ADAPT_MAX_NUM);
+		}
+		if (num >= 2)
+			padapter->tx_amsdu_lat_budget = rtw_min(lat_budget, 0xFFFF);
+	}
+
+	return count;
+}
+
 ssize_t proc_set_tx_amsdu(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
 {
 	struct net_device *dev = data;
@@ -3214,6 +3703,7 @@ ssize_t proc_set_tx_amsdu(struct file *file, const char __user *buffer, size_t c
 				pxmitpriv->amsdu_debug_timeout = 0;
 				pxmitpriv->amsdu_debug_coalesce_one = 0;
 				pxmitpriv->amsdu_debug_coalesce_two = 0;
+				rtw_amsdu_adapt_stats_reset(padapter);
 			}
 			else
 				padapter->tx_amsdu = amsdu;
@@ -3682,6 +4172,17 @@ int proc_get_all_sta_info(struct seq_file *m, void *v)
 					, psta->cmn.bw_mode, psta->htpriv.ch_offset, psta->htpriv.sgi_20m, psta->htpriv.sgi_40m);
 				RTW_PRINT_SEL(m, "ampdu_enable = %d\n", psta->htpriv.ampdu_enable);
 				RTW_PRINT_SEL(m, "tx_amsdu_enable = %d\n", psta->htpriv.tx_amsdu_enable);
+#ifdef CONFIG_TX_AMSDU
+				RTW_PRINT_SEL(m, "amsdu num/timeout/reason: VO=%u/%u/%s, VI=%u/%u/%s, BE=%u/%u/%s, BK=%u/%u/%s\n"
+					, psta->sta_xmitpriv.amsdu_ctl[VO_QUEUE_INX].num, psta->sta_xmitpriv.amsdu_ctl[VO_QUEUE_INX].timeout_ms
+					, amsdu_flush_reason_str(psta->sta_xmitpriv.amsdu_ctl[VO_QUEUE_INX].reason)
+					, psta->sta_xmitpriv.amsdu_ctl[VI_QUEUE_INX].num, psta->sta_xmitpriv.amsdu_ctl[VI_QUEUE_INX].timeout_ms
+					, amsdu_flush_reason_str(psta->sta_xmitpriv.amsdu_ctl[VI_QUEUE_INX].reason)
+					, psta->sta_xmitpriv.amsdu_ctl[BE_QUEUE_INX].num, psta->sta_xmitpriv.amsdu_ctl[BE_QUEUE_INX].timeout_ms
+					, amsdu_flush_reason_str(psta->sta_xmitpriv.amsdu_ctl[BE_QUEUE_INX].reason)
+					, psta->sta_xmitpriv.amsdu_ctl[BK_QUEUE_INX].num, psta->sta_xmitpriv.amsdu_ctl[BK_QUEUE_INX].timeout_ms
+					, amsdu_flush_reason_str(psta->sta_xmitpriv.amsdu_ctl[BK_QUEUE_INX].reason));
+#endif
 				RTW_PRINT_SEL(m, "agg_enable_bitmap=%x, candidate_tid_bitmap=%x\n", psta->htpriv.agg_enable_bitmap, psta->htpriv.candidate_tid_bitmap);
 #endif /* CONFIG_80211N_HT */
 #ifdef CONFIG_80211AC_VHT
@@ -3689,7 +4190,8 @@ int proc_get_all_sta_info(struct seq_file *m, void *v)
 				RTW_PRINT_SEL(m, "vht_ldpc_cap=0x%x, vht_stbc_cap=0x%x, vht_beamform_cap=0x%x\n", psta->vhtpriv.ldpc_cap, psta->vhtpriv.stbc_cap, psta->vhtpriv.beamform_cap);
 				RTW_PRINT_SEL(m, "vht_mcs_map=0x%x, vht_highest_rate=0x%x, vht_ampdu_len=%d\n", *(u16 *)psta->vhtpriv.vht_mcs_map, psta->vhtpriv.vht_highest_rate, psta->vhtpriv.ampdu_len);
 #endif
-				RTW_PRINT_SEL(m, "sleepq_len=%d\n", psta->sleepq_len);
+				RTW_PRINT_SEL(m, "sleepq_len=%d, sleepq_bytes=%u, sleepq_ovf_drop=%u\n"
+					, psta->sleepq_len, psta->sleepq_bytes, psta->sleepq_ovf_drop);
 				RTW_PRINT_SEL(m, "sta_xmitpriv.vo_q_qcnt=%d\n", psta->sta_xmitpriv.vo_q.qcnt);
 				RTW_PRINT_SEL(m, "sta_xmitpriv.vi_q_qcnt=%d\n", psta->sta_xmitpriv.vi_q.qcnt);
 				RTW_PRINT_SEL(m, "sta_xmitpriv.be_q_qcnt=%d\n", psta->sta_xmitpriv.be_q.qcnt);
@@ -3748,6 +4250,16 @@ int proc_get_all_sta_info(struct seq_file *m, void *v)
 
 #endif
 
+int proc_get_sta_mem(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *padapter = (_adapter *)rtw_netdev_priv(dev);
+
+	dump_sta_mem(m, padapter);
+
+	return 0;
+}
+
 #ifdef CONFIG_PREALLOC_RX_SKB_BUFFER
 int proc_get_rtkm_info(struct seq_file *m, void *v)
 {
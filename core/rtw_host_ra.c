@@ -0,0 +1,305 @@
+/******************************************************************************
+ *
+ * Copyright(c) 2007 - 2017 Realtek Corporation.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ *****************************************************************************/
+#define _RTW_HOST_RA_C_
+
+#include <drv_types.h>
+
+#ifdef CONFIG_RTW_HOST_RA
+/*
+ * Host side rate control, modeled after Minstrel:
+ * - normal frames go out at the rate of best expected throughput
+ * - 1 of every host_ra_sample_intvl frames probes another rate
+ * - success probability of each rate is merged into an EWMA every
+ *   HOST_RA_UPDATE_MS, from TX reports matched by the tx_cmpl_track FIFO
+ */
+
+/* nominal PHY rate of 20MHz long GI, in 100Kbps, index by DESC_RATEXXX */
+static const u16 host_ra_rate_20m[HOST_RA_RATE_NUM] = {
+	10, 20, 55, 110,
+	60, 90, 120, 180, 240, 360, 480, 540,
+	65, 130, 195, 260, 390, 520, 585, 650,
+	130, 260, 390, 520, 780, 1040, 1170, 1300,
+};
+
+/* stride of sampling rotation, coprime to HOST_RA_RATE_NUM so every rate gets visited */
+#define HOST_RA_SAMPLE_STRIDE	11
+
+static u16 host_ra_phy_rate(u8 rate, u8 bw, u8 sgi)
+{
+	u32 phy_rate = host_ra_rate_20m[rate];
+
+	if (rate < DESC_RATEMCS0)
+		return phy_rate;
+
+	if (bw >= CHANNEL_WIDTH_40)
+		phy_rate = phy_rate * 27 / 13;
+	if (sgi)
+		phy_rate = phy_rate * 10 / 9;
+
+	return (u16)phy_rate;
+}
+
+static bool host_ra_rate_valid(struct host_ra_sta *hra, u8 rate)
+{
+	return rate < HOST_RA_RATE_NUM && (hra->ramask & ((u64)1 << rate));
+}
+
+static void host_ra_sta_init(struct sta_info *psta, u64 ramask)
+{
+	struct host_ra_sta *hra = &psta->host_ra;
+	u8 rate;
+
+	_rtw_memset(hra, 0, sizeof(*hra));
+	hra->ramask = ramask;
+
+	/* start from what firmware RA is using, it's the best guess available */
+	rate = rtw_get_current_tx_rate(psta->padapter, psta);
+	if (!host_ra_rate_valid(hra, rate)) {
+		for (rate = 0; rate < HOST_RA_RATE_NUM; rate++)
+			if (host_ra_rate_valid(hra, rate))
+				break;
+	}
+
+	hra->max_tp = rate;
+	hra->max_tp2 = rate;
+	hra->max_prob = rate;
+	hra->sample_idx = rate;
+	hra->update_time = rtw_get_current_time();
+}
+
+/* merge statistics of the finished window and choose rates for the next one */
+static void host_ra_update(struct host_ra_sta *hra)
+{
+	struct host_ra_rate *r;
+	u8 max_tp = HOST_RA_RATE_NONE;
+	u8 max_tp2 = HOST_RA_RATE_NONE;
+	u8 max_prob = HOST_RA_RATE_NONE;
+	u32 cur_prob;
+	u8 i;
+
+	for (i = 0; i < HOST_RA_RATE_NUM; i++) {
+		if (!host_ra_rate_valid(hra, i))
+			continue;
+
+		r = &hra->rate[i];
+		if (r->att) {
+			cur_prob = r->succ * HOST_RA_PROB_MAX / r->att;
+			if (!r->att_total)
+				r->prob = (u16)cur_prob;
+			else
+				r->prob = (u16)((r->prob * HOST_RA_EWMA_LEVEL
+					+ cur_prob * (100 - HOST_RA_EWMA_LEVEL)) / 100);
+
+			r->att_total += r->att;
+			r->succ_total += r->succ;
+			r->att = 0;
+			r->succ = 0;
+		}
+
+		if (r->prob < HOST_RA_PROB_MIN)
+			r->tp = 0;
+		else
+			r->tp = (u16)(r->prob * host_ra_phy_rate(i, hra->bw, hra->sgi) / HOST_RA_PROB_MAX);
+
+		/* never tried, not a candidate yet */
+		if (!r->att_total)
+			continue;
+
+		if (max_tp == HOST_RA_RATE_NONE || r->tp > hra->rate[max_tp].tp) {
+			max_tp2 = max_tp;
+			max_tp = i;
+		} else if (max_tp2 == HOST_RA_RATE_NONE || r->tp > hra->rate[max_tp2].tp)
+			max_tp2 = i;
+
+		if (max_prob == HOST_RA_RATE_NONE || r->prob > hra->rate[max_prob].prob
+			|| (r->prob == hra->rate[max_prob].prob && r->tp > hra->rate[max_prob].tp))
+			max_prob = i;
+	}
+
+	if (max_tp != HOST_RA_RATE_NONE) {
+		hra->max_tp = max_tp;
+		hra->max_tp2 = (max_tp2 != HOST_RA_RATE_NONE) ? max_tp2 : max_tp;
+		hra->max_prob = max_prob;
+	}
+
+	hra->update_time = rtw_get_current_time();
+	hra->update_total++;
+}
+
+static u8 host_ra_next_sample(struct host_ra_sta *hra)
+{
+	u16 cur_tp = hra->rate[hra->max_tp].tp;
+	u8 i, rate;
+
+	for (i = 0; i < HOST_RA_RATE_NUM; i++) {
+		rate = hra->sample_idx;
+		hra->sample_idx = (hra->sample_idx + HOST_RA_SAMPLE_STRIDE) % HOST_RA_RATE_NUM;
+
+		if (!host_ra_rate_valid(hra, rate))
+			continue;
+		if (rate == hra->max_tp || rate == hra->max_tp2 || rate == hra->max_prob)
+			continue;
+		/* can't beat current choice even without any loss */
+		if (host_ra_phy_rate(rate, hra->bw, hra->sgi) <= cur_tp)
+			continue;
+		/* already known to be good */
+		if (hra->rate[rate].att_total && hra->rate[rate].prob >= HOST_RA_PROB_GOOD)
+			continue;
+
+		return rate;
+	}
+
+	return HOST_RA_RATE_NONE;
+}
+
+/*
+ * rtw_host_ra_select - choose TX rate of a unicast data frame
+ * Called by HAL when filling the TX descriptor, before rtw_tx_cmpl_track_push().
+ * Result is left in pattrib->hra_rate and pattrib->hra_flags.
+ * Returns: _TRUE if HAL should use pattrib->hra_rate instead of firmware RA
+ */
+bool rtw_host_ra_select(_adapter *padapter, struct xmit_frame *pxmitframe)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+	struct sta_info *psta = pattrib->psta;
+	struct host_ra_sta *hra;
+	_irqL irqL;
+	u64 ramask;
+	u8 rate, sample;
+	u8 flags = 0;
+
+	pattrib->hra_rate = HOST_RA_RATE_NONE;
+	pattrib->hra_flags = 0;
+
+	if (!pxmitpriv->host_ra_en || !psta || IS_MCAST(pattrib->ra))
+		return _FALSE;
+
+	/* fixed rate for debug wins */
+	if (padapter->fix_rate != 0xFF)
+		return _FALSE;
+
+	ramask = psta->cmn.ra_info.ramask & (((u64)1 << HOST_RA_RATE_NUM) - 1);
+	if (!ramask)
+		return _FALSE;
+
+	hra = &psta->host_ra;
+
+	_enter_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+	if (hra->ramask != ramask)
+		host_ra_sta_init(psta, ramask);
+	hra->bw = pattrib->bwmode;
+	hra->sgi = pattrib->sgi;
+
+	rate = hra->max_tp;
+	if (pxmitpriv->host_ra_sample_intvl
+		&& ++hra->sample_cnt >= pxmitpriv->host_ra_sample_intvl) {
+		hra->sample_cnt = 0;
+		sample = host_ra_next_sample(hra);
+		if (sample != HOST_RA_RATE_NONE) {
+			rate = sample;
+			flags |= HOST_RA_F_SAMPLE | HOST_RA_F_RPT;
+			hra->rate[sample].sample_cnt++;
+			hra->sample_tx_cnt++;
+		}
+	}
+
+	if (!(flags & HOST_RA_F_SAMPLE)
+		&& ++hra->rpt_cnt >= pxmitpriv->host_ra_rpt_intvl) {
+		hra->rpt_cnt = 0;
+		flags |= HOST_RA_F_RPT;
+	}
+
+	hra->tx_cnt++;
+	_exit_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+
+	pattrib->hra_rate = rate;
+	pattrib->hra_flags = flags;
+
+	return _TRUE;
+}
+
+/*
+ * rtw_host_ra_report - account TX report of a frame whose rate is chosen by host
+ * Called by rtw_tx_cmpl_track_report() with xmitpriv.tx_cmpl_lock held.
+ * HW fallback is on for all frames. If the final attempt was not at tx_rate,
+ * the only certain facts are that tx_rate failed at least once and the
+ * final attempt was at final_rate.
+ */
+void rtw_host_ra_report(struct sta_info *psta, u8 tx_rate, u8 flags, bool ok, u8 retry_cnt, u8 final_rate)
+{
+	struct host_ra_sta *hra = &psta->host_ra;
+
+	if (!host_ra_rate_valid(hra, tx_rate))
+		return;
+
+	hra->rpt_total++;
+
+	if (final_rate == tx_rate) {
+		hra->rate[tx_rate].att += retry_cnt + 1;
+		if (ok)
+			hra->rate[tx_rate].succ++;
+	} else {
+		hra->rate[tx_rate].att++;
+		if (host_ra_rate_valid(hra, final_rate)) {
+			hra->rate[final_rate].att++;
+			if (ok)
+				hra->rate[final_rate].succ++;
+		}
+	}
+
+	if (rtw_get_passing_time_ms(hra->update_time) >= HOST_RA_UPDATE_MS)
+		host_ra_update(hra);
+}
+
+void rtw_host_ra_reset(struct sta_info *psta)
+{
+	struct xmit_priv *pxmitpriv = &psta->padapter->xmitpriv;
+	_irqL irqL;
+
+	_enter_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+	_rtw_memset(&psta->host_ra, 0, sizeof(psta->host_ra));
+	_exit_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+}
+
+void dump_host_ra(void *sel, struct sta_info *psta)
+{
+	struct host_ra_sta *hra = &psta->host_ra;
+	struct host_ra_rate *r;
+	u8 i;
+
+	if (!hra->ramask)
+		return;
+
+	RTW_PRINT_SEL(sel, "macid:%u "MAC_FMT" tx:%u sample:%u rpt:%u update:%u bw:%u sgi:%u\n"
+		, psta->cmn.mac_id, MAC_ARG(psta->cmn.mac_addr), hra->tx_cnt, hra->sample_tx_cnt
+		, hra->rpt_total, hra->update_total, hra->bw, hra->sgi);
+	RTW_PRINT_SEL(sel, "max_tp:%s max_tp2:%s max_prob:%s\n"
+		, HDATA_RATE(hra->max_tp), HDATA_RATE(hra->max_tp2), HDATA_RATE(hra->max_prob));
+
+	RTW_PRINT_SEL(sel, "%-10s %6s %8s %10s %10s %8s\n"
+		, "rate", "prob", "tp(100K)", "att", "succ", "sample");
+	for (i = 0; i < HOST_RA_RATE_NUM; i++) {
+		if (!host_ra_rate_valid(hra, i))
+			continue;
+
+		r = &hra->rate[i];
+		RTW_PRINT_SEL(sel, "%-10s %3u.%u%% %8u %10u %10u %8u%s\n"
+			, HDATA_RATE(i), r->prob / 10, r->prob % 10, r->tp
+			, r->att_total + r->att, r->succ_total + r->succ, r->sample_cnt
+			, i == hra->max_tp ? " *" : "");
+	}
+}
+#endif /* CONFIG_RTW_HOST_RA */
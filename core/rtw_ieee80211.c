@@ -363,6 +363,108 @@ u8 *rtw_get_ie_ex(const u8 *in_ie, uint in_len, u8 eid, const u8 *oui, u8 oui_le
 	return (u8 *)target_ie;
 }
 
+static void rtw_ie_idx_add(struct rtw_ie_idx *idx, uint ofs)
+{
+	u8 eid = idx->ies[ofs];
+
+	idx->eid_map[eid >> 5] |= BIT(eid & 0x1f);
+
+	if (idx->tail < idx->ies_len)
+		return;
+
+	if (idx->num >= RTW_IE_IDX_NUM
+		|| ofs + 2 + idx->ies[ofs + 1] > idx->ies_len
+	) {
+		idx->tail = ofs;
+		return;
+	}
+
+	idx->ofs[idx->num++] = ofs;
+}
+
+static void rtw_ie_idx_init(struct rtw_ie_idx *idx, u8 *ies, uint ies_len)
+{
+	_rtw_memset(idx, 0, sizeof(*idx));
+	idx->ies = ies;
+	idx->ies_len = ies_len;
+	idx->tail = ies_len;
+}
+
+/**
+ * rtw_ie_idx_build - Index a series of IEs in one pass
+ * @idx: The index to build
+ * @ies: Address of IEs, must stay valid while @idx is in use
+ * @ies_len: Length of @ies
+ */
+void rtw_ie_idx_build(struct rtw_ie_idx *idx, u8 *ies, uint ies_len)
+{
+	uint cnt = 0;
+
+	rtw_ie_idx_init(idx, ies, ies ? ies_len : 0);
+
+	while (cnt + 2 <= idx->ies_len) {
+		rtw_ie_idx_add(idx, cnt);
+		cnt += ies[cnt + 1] + 2;
+	}
+}
+
+/**
+ * rtw_ie_idx_get_ie_ex - Search specific IE through an IE index
+ * @idx: The index built by rtw_ie_idx_build() or rtw_ieee802_11_parse_elems()
+ * @eid, @oui, @oui_len, @ie, @ielen: The same as rtw_get_ie_ex()
+ *
+ * Returns: The address of the specific IE found, or NULL
+ */
+u8 *rtw_ie_idx_get_ie_ex(struct rtw_ie_idx *idx, u8 eid, const u8 *oui, u8 oui_len, u8 *ie, uint *ielen)
+{
+	u8 *p;
+	int i;
+
+	if (ielen)
+		*ielen = 0;
+
+	if (!(idx->eid_map[eid >> 5] & BIT(eid & 0x1f)))
+		return NULL;
+
+	for (i = 0; i < idx->num; i++) {
+		p = idx->ies + idx->ofs[i];
+		if (p[0] != eid)
+			continue;
+		if (oui && (p[1] < oui_len || _rtw_memcmp(p + 2, oui, oui_len) == _FALSE))
+			continue;
+
+		if (ie)
+			_rtw_memcpy(ie, p, p[1] + 2);
+		if (ielen)
+			*ielen = p[1] + 2;
+		return p;
+	}
+
+	if (idx->tail < idx->ies_len)
+		return rtw_get_ie_ex(idx->ies + idx->tail, idx->ies_len - idx->tail, eid, oui, oui_len, ie, ielen);
+
+	return NULL;
+}
+
+/**
+ * rtw_ie_idx_get_ie - Search IE by element ID through an IE index
+ * @idx: The index built by rtw_ie_idx_build() or rtw_ieee802_11_parse_elems()
+ * @eid: Element ID to match
+ * @len: Set to the length of the IE content as rtw_get_ie() does
+ *
+ * Returns: The address of the IE found, or NULL
+ */
+u8 *rtw_ie_idx_get_ie(struct rtw_ie_idx *idx, u8 eid, sint *len)
+{
+	uint ielen;
+	u8 *p;
+
+	p = rtw_ie_idx_get_ie_ex(idx, eid, NULL, 0, NULL, &ielen);
+	*len = p ? ielen - 2 : 0;
+
+	return p;
+}
+
 /**
  * rtw_ies_remove_ie - Find matching IEs and remove
  * @ies: Address of IEs to search
@@ -1304,10 +1406,13 @@ ParseRes rtw_ieee802_11_parse_elems(u8 *start, uint len,
 	int unknown = 0;
 
 	_rtw_memset(elems, 0, sizeof(*elems));
+	rtw_ie_idx_init(&elems->idx, start, len);
 
 	while (left >= 2) {
 		u8 id, elen;
 
+		rtw_ie_idx_add(&elems->idx, pos - start);
+
 		id = *pos++;
 		elen = *pos++;
 		left -= 2;
@@ -1759,6 +1864,19 @@ void dump_wps_ie(void *sel, const u8 *ie, u32 ie_len)
  * @vht: check VHT IEs, if true imply ht is true
  */
 void rtw_ies_get_chbw(u8 *ies, int ies_len, u8 *ch, u8 *bw, u8 *offset, u8 ht, u8 vht)
+{
+	struct rtw_ie_idx idx;
+
+	rtw_ie_idx_build(&idx, ies, ies_len > 0 ? ies_len : 0);
+	rtw_ie_idx_get_chbw(&idx, ch, bw, offset, ht, vht);
+}
+
+/**
+ * rtw_ie_idx_get_chbw - get operation ch, bw, offset from indexed IEs of BSS.
+ * @idx: index of the tlv IEs
+ * @ch, @bw, @offset, @ht, @vht: the same as rtw_ies_get_chbw()
+ */
+void rtw_ie_idx_get_chbw(struct rtw_ie_idx *idx, u8 *ch, u8 *bw, u8 *offset, u8 ht, u8 vht)
 {
 	u8 *p;
 	int	ie_len;
@@ -1767,7 +1885,7 @@ void rtw_ies_get_chbw(u8 *ies, int ies_len, u8 *ch, u8 *bw, u8 *offset, u8 ht, u
 	*bw = CHANNEL_WIDTH_20;
 	*offset = HAL_PRIME_CHNL_OFFSET_DONT_CARE;
 
-	p = rtw_get_ie(ies, _DSSET_IE_, &ie_len, ies_len);
+	p = rtw_ie_idx_get_ie(idx, _DSSET_IE_, &ie_len);
 	if (p && ie_len > 0)
 		*ch = *(p + 2);
 
@@ -1776,13 +1894,13 @@ void rtw_ies_get_chbw(u8 *ies, int ies_len, u8 *ch, u8 *bw, u8 *offset, u8 ht, u
 		u8 *ht_cap_ie, *ht_op_ie;
 		int ht_cap_ielen, ht_op_ielen;
 
-		ht_cap_ie = rtw_get_ie(ies, EID_HTCapability, &ht_cap_ielen, ies_len);
+		ht_cap_ie = rtw_ie_idx_get_ie(idx, EID_HTCapability, &ht_cap_ielen);
 		if (ht_cap_ie && ht_cap_ielen) {
 			if (GET_HT_CAP_ELE_CHL_WIDTH(ht_cap_ie + 2))
 				*bw = CHANNEL_WIDTH_40;
 		}
 
-		ht_op_ie = rtw_get_ie(ies, EID_HTInfo, &ht_op_ielen, ies_len);
+		ht_op_ie = rtw_ie_idx_get_ie(idx, EID_HTInfo, &ht_op_ielen);
 		if (ht_op_ie && ht_op_ielen) {
 			if (*ch == 0)
 				*ch = GET_HT_OP_ELE_PRI_CHL(ht_op_ie + 2);
@@ -1811,7 +1929,7 @@ void rtw_ies_get_chbw(u8 *ies, int ies_len, u8 *ch, u8 *bw, u8 *offset, u8 ht, u
 			u8 *vht_op_ie;
 			int vht_op_ielen;
 
-			vht_op_ie = rtw_get_ie(ies, EID_VHTOperation, &vht_op_ielen, ies_len);
+			vht_op_ie = rtw_ie_idx_get_ie(idx, EID_VHTOperation, &vht_op_ielen);
 			if (vht_op_ie && vht_op_ielen) {
 				if (GET_VHT_OPERATION_ELE_CHL_WIDTH(vht_op_ie + 2) >= 1)
 					*bw = CHANNEL_WIDTH_80;
@@ -90,6 +90,7 @@ u8 rtw_do_join(_adapter *padapter)
 	pmlmepriv->cur_network.join_res = -2;
 
 	set_fwstate(pmlmepriv, _FW_UNDER_LINKING);
+	rtw_join_timing_start(padapter);
 
 	pmlmepriv->pscanned = plist;
 
@@ -112,7 +113,8 @@ u8 rtw_do_join(_adapter *padapter)
 			u8 ssc_chk = rtw_sitesurvey_condition_check(padapter, _FALSE);
 
 			if ((ssc_chk == SS_ALLOW) || (ssc_chk == SS_DENY_BUSY_TRAFFIC) ){
-				/* submit site_survey_cmd */
+				/* submit site_survey_cmd, only on the channel of last BSS if it's fresh */
+				rtw_fast_reconn_survey_parm(padapter, &parm);
 				ret = rtw_sitesurvey_cmd(padapter, &parm);
 				if (_SUCCESS != ret)
 					pmlmepriv->to_join = _FALSE;
@@ -174,6 +176,7 @@ u8 rtw_do_join(_adapter *padapter)
 
 					if ((ssc_chk == SS_ALLOW) || (ssc_chk == SS_DENY_BUSY_TRAFFIC)){
 						/* RTW_INFO(("rtw_do_join() when   no desired bss in scanning queue\n"); */
+						rtw_fast_reconn_survey_parm(padapter, &parm);
 						ret = rtw_sitesurvey_cmd(padapter, &parm);
 						if (_SUCCESS != ret)
 							pmlmepriv->to_join = _FALSE;
@@ -194,6 +197,8 @@ u8 rtw_do_join(_adapter *padapter)
 	}
 
 exit:
+	if (ret != _SUCCESS)
+		pmlmepriv->join_timing = 0;
 
 	return ret;
 }
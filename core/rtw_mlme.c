@@ -70,6 +70,9 @@ sint	_rtw_init_mlme_priv(_adapter *padapter)
 	_rtw_spinlock_init(&(pmlmepriv->lock));
 	_rtw_init_queue(&(pmlmepriv->free_bss_pool));
 	_rtw_init_queue(&(pmlmepriv->scanned_queue));
+	for (i = 0; i < SCANNED_HASH_NUM; i++)
+		_rtw_init_listhead(&pmlmepriv->scanned_hash[i]);
+	_rtw_init_listhead(&pmlmepriv->scanned_lru);
 
 	set_scanned_network_val(pmlmepriv, 0);
 
@@ -95,6 +98,8 @@ sint	_rtw_init_mlme_priv(_adapter *padapter)
 
 	for (i = 0; i < pmlmepriv->max_bss_cnt; i++) {
 		_rtw_init_listhead(&(pnetwork->list));
+		_rtw_init_listhead(&(pnetwork->hash_list));
+		_rtw_init_listhead(&(pnetwork->lru_list));
 
 		rtw_list_insert_tail(&(pnetwork->list), &(pmlmepriv->free_bss_pool.queue));
 
@@ -104,6 +109,7 @@ sint	_rtw_init_mlme_priv(_adapter *padapter)
 	/* allocate DMA-able/Non-Page memory for cmd_buf and rsp_buf */
 
 	rtw_clear_scan_deny(padapter);
+	pmlmepriv->fast_reconn_exp_ms = RTW_FAST_RECONN_EXP_MS;
 #ifdef CONFIG_ARP_KEEP_ALIVE
 	pmlmepriv->bGetGateway = 0;
 	pmlmepriv->GetGatewayTryCnt = 0;
@@ -429,7 +435,7 @@ void _rtw_free_network(struct	mlme_priv *pmlmepriv , struct wlan_network *pnetwo
 
 	_enter_critical_bh(&free_queue->lock, &irqL);
 
-	rtw_list_delete(&(pnetwork->list));
+	rtw_scanned_network_unlink(pnetwork);
 
 	rtw_list_insert_tail(&(pnetwork->list), &(free_queue->queue));
 
@@ -458,7 +464,7 @@ void _rtw_free_network_nolock(struct	mlme_priv *pmlmepriv, struct wlan_network *
 
 	/* _enter_critical(&free_queue->lock, &irqL); */
 
-	rtw_list_delete(&(pnetwork->list));
+	rtw_scanned_network_unlink(pnetwork);
 
 	rtw_list_insert_tail(&(pnetwork->list), get_list_head(free_queue));
 
@@ -610,6 +616,51 @@ void rtw_free_network_queue(_adapter *dev, u8 isfreeall)
 	_rtw_free_network_queue(dev, isfreeall);
 }
 
+#define scanned_queue_to_mlme(q) LIST_CONTAINOR(q, struct mlme_priv, scanned_queue)
+
+static inline u32 rtw_scanned_hash(const u8 *bssid)
+{
+	u32 x;
+
+	/* vendor OUI is shared by most BSSes around, the NIC specific part is more random */
+	x = bssid[5];
+	x = (x << 3) ^ bssid[4];
+	x = (x << 3) ^ bssid[3];
+	x ^= x >> 6;
+
+	return x & (SCANNED_HASH_NUM - 1);
+}
+
+/* caller must hold scanned_queue.lock for all rtw_scanned_network_xxx() */
+void rtw_scanned_network_link(struct mlme_priv *pmlmepriv, struct wlan_network *pnetwork)
+{
+	rtw_list_insert_tail(&pnetwork->list, get_list_head(&pmlmepriv->scanned_queue));
+	rtw_list_insert_tail(&pnetwork->hash_list, &pmlmepriv->scanned_hash[rtw_scanned_hash(pnetwork->network.MacAddress)]);
+	rtw_list_insert_tail(&pnetwork->lru_list, &pmlmepriv->scanned_lru);
+}
+
+void rtw_scanned_network_unlink(struct wlan_network *pnetwork)
+{
+	rtw_list_delete(&pnetwork->list);
+	rtw_list_delete(&pnetwork->hash_list);
+	rtw_list_delete(&pnetwork->lru_list);
+}
+
+/* update last_scanned and move to the tail of LRU */
+void rtw_scanned_network_touch(struct mlme_priv *pmlmepriv, struct wlan_network *pnetwork)
+{
+	pnetwork->last_scanned = rtw_get_current_time();
+	rtw_list_delete(&pnetwork->lru_list);
+	rtw_list_insert_tail(&pnetwork->lru_list, &pmlmepriv->scanned_lru);
+}
+
+/* BSSID of pnetwork is overwritten, keep its position in scanned_queue */
+void rtw_scanned_network_rehash(struct mlme_priv *pmlmepriv, struct wlan_network *pnetwork)
+{
+	rtw_list_delete(&pnetwork->hash_list);
+	rtw_list_insert_tail(&pnetwork->hash_list, &pmlmepriv->scanned_hash[rtw_scanned_hash(pnetwork->network.MacAddress)]);
+}
+
 struct wlan_network *_rtw_find_network(_queue *scanned_queue, const u8 *addr)
 {
 	_list	*phead, *plist;
@@ -621,11 +672,11 @@ struct wlan_network *_rtw_find_network(_queue *scanned_queue, const u8 *addr)
 		goto exit;
 	}
 
-	phead = get_list_head(scanned_queue);
+	phead = &scanned_queue_to_mlme(scanned_queue)->scanned_hash[rtw_scanned_hash(addr)];
 	plist = get_next(phead);
 
 	while (plist != phead) {
-		pnetwork = LIST_CONTAINOR(plist, struct wlan_network , list);
+		pnetwork = LIST_CONTAINOR(plist, struct wlan_network , hash_list);
 
 		if (_rtw_memcmp(addr, pnetwork->network.MacAddress, ETH_ALEN) == _TRUE)
 			break;
@@ -735,11 +786,11 @@ struct wlan_network *_rtw_find_same_network(_queue *scanned_queue, struct wlan_n
 	_list *phead, *plist;
 	struct wlan_network *found = NULL;
 
-	phead = get_list_head(scanned_queue);
+	phead = &scanned_queue_to_mlme(scanned_queue)->scanned_hash[rtw_scanned_hash(network->network.MacAddress)];
 	plist = get_next(phead);
 
 	while (plist != phead) {
-		found = LIST_CONTAINOR(plist, struct wlan_network , list);
+		found = LIST_CONTAINOR(plist, struct wlan_network , hash_list);
 
 		if (is_same_network(&network->network, &found->network, 0))
 			break;
@@ -776,20 +827,21 @@ struct	wlan_network	*rtw_get_oldest_wlan_network(_queue *scanned_queue)
 
 	struct	wlan_network	*pwlan = NULL;
 	struct	wlan_network	*oldest = NULL;
-	phead = get_list_head(scanned_queue);
+	phead = &scanned_queue_to_mlme(scanned_queue)->scanned_lru;
 
 	plist = get_next(phead);
 
+	/* LRU is in last_scanned order, the first one not fixed is the oldest */
 	while (1) {
 
 		if (rtw_end_of_queue_search(phead, plist) == _TRUE)
 			break;
 
-		pwlan = LIST_CONTAINOR(plist, struct wlan_network, list);
+		pwlan = LIST_CONTAINOR(plist, struct wlan_network, lru_list);
 
 		if (pwlan->fixed != _TRUE) {
-			if (oldest == NULL || rtw_time_after(oldest->last_scanned, pwlan->last_scanned))
-				oldest = pwlan;
+			oldest = pwlan;
+			break;
 		}
 
 		plist = get_next(plist);
@@ -930,6 +982,54 @@ static void update_current_network(_adapter *adapter, WLAN_BSSID_EX *pnetwork)
 }
 
 
+/*
+* the entry of scanned_queue to be replaced when free_bss_pool is empty
+* caller must hold scanned_queue.lock
+*/
+static struct wlan_network *rtw_scanned_network_to_evict(_adapter *adapter)
+{
+	struct mlme_priv *pmlmepriv = &(adapter->mlmepriv);
+	_list *plist, *phead;
+	struct wlan_network *pnetwork;
+	struct wlan_network *choice = NULL;
+
+#ifdef CONFIG_RSSI_PRIORITY
+	phead = get_list_head(&pmlmepriv->scanned_queue);
+#else
+	phead = &pmlmepriv->scanned_lru;
+#endif
+	plist = get_next(phead);
+
+	while (rtw_end_of_queue_search(phead, plist) == _FALSE) {
+#ifdef CONFIG_RSSI_PRIORITY
+		pnetwork = LIST_CONTAINOR(plist, struct wlan_network, list);
+#else
+		pnetwork = LIST_CONTAINOR(plist, struct wlan_network, lru_list);
+#endif
+		plist = get_next(plist);
+
+		if (pnetwork->fixed)
+			continue;
+
+		#ifdef CONFIG_RTW_MESH
+		if (MLME_IS_MESH(adapter) && MLME_IS_ASOC(adapter)
+			&& rtw_bss_is_same_mbss(&pmlmepriv->cur_network.network, &pnetwork->network))
+			continue;
+		#endif
+
+#ifdef CONFIG_RSSI_PRIORITY
+		if ((choice == NULL) || (pnetwork->network.PhyInfo.SignalStrength < choice->network.PhyInfo.SignalStrength))
+			choice = pnetwork;
+#else
+		/* LRU is in last_scanned order */
+		choice = pnetwork;
+		break;
+#endif
+	}
+
+	return choice;
+}
+
 /*
 
 Caller must hold pmlmepriv->lock first.
@@ -951,9 +1051,10 @@ bool rtw_update_scanned_network(_adapter *adapter, WLAN_BSSID_EX *target)
 	int target_find = 0;
 	u8 feature = 0;
 	bool update_ie = _FALSE;
+	bool new_in_scan = _FALSE;
 
 	_enter_critical_bh(&queue->lock, &irqL);
-	phead = get_list_head(queue);
+	phead = &pmlmepriv->scanned_hash[rtw_scanned_hash(target->MacAddress)];
 	plist = get_next(phead);
 
 #if 0
@@ -970,7 +1071,7 @@ bool rtw_update_scanned_network(_adapter *adapter, WLAN_BSSID_EX *target)
 		if (rtw_end_of_queue_search(phead, plist) == _TRUE)
 			break;
 
-		pnetwork = LIST_CONTAINOR(plist, struct wlan_network, list);
+		pnetwork = LIST_CONTAINOR(plist, struct wlan_network, hash_list);
 
 		rtw_bug_check(pnetwork, pnetwork, pnetwork, pnetwork);
 
@@ -987,29 +1088,6 @@ bool rtw_update_scanned_network(_adapter *adapter, WLAN_BSSID_EX *target)
 			break;
 		}
 
-		if (rtw_roam_flags(adapter)) {
-			/* TODO: don't  select netowrk in the same ess as choice if it's new enough*/
-		}
-		if (pnetwork->fixed) {
-			plist = get_next(plist);
-			continue;
-		}
-			
-#ifdef CONFIG_RSSI_PRIORITY
-		if ((choice == NULL) || (pnetwork->network.PhyInfo.SignalStrength < choice->network.PhyInfo.SignalStrength))
-			#ifdef CONFIG_RTW_MESH
-			if (!MLME_IS_MESH(adapter) || !MLME_IS_ASOC(adapter)
-				|| !rtw_bss_is_same_mbss(&pmlmepriv->cur_network.network, &pnetwork->network))
-			#endif
-				choice = pnetwork;
-#else
-		if (choice == NULL || rtw_time_after(choice->last_scanned, pnetwork->last_scanned))
-			#ifdef CONFIG_RTW_MESH
-			if (!MLME_IS_MESH(adapter) || !MLME_IS_ASOC(adapter)
-				|| !rtw_bss_is_same_mbss(&pmlmepriv->cur_network.network, &pnetwork->network))
-			#endif
-				choice = pnetwork;
-#endif
 		plist = get_next(plist);
 
 	}
@@ -1022,6 +1100,8 @@ bool rtw_update_scanned_network(_adapter *adapter, WLAN_BSSID_EX *target)
 		if (_rtw_queue_empty(&(pmlmepriv->free_bss_pool)) == _TRUE) {
 			/* If there are no more slots, expire the choice */
 			/* list_del_init(&choice->list); */
+			/* TODO: with rtw_roam_flags(), don't select netowrk in the same ess as choice if it's new enough */
+			choice = rtw_scanned_network_to_evict(adapter);
 			pnetwork = choice;
 			if (pnetwork == NULL)
 				goto unlock_scan_queue;
@@ -1038,10 +1118,11 @@ bool rtw_update_scanned_network(_adapter *adapter, WLAN_BSSID_EX *target)
 			rtw_hal_get_odm_var(adapter, HAL_ODM_ANTDIV_SELECT, &(target->PhyInfo.Optimum_antenna), NULL);
 #endif
 			_rtw_memcpy(&(pnetwork->network), target,  get_WLAN_BSSID_EX_sz(target));
-			/* pnetwork->last_scanned = rtw_get_current_time(); */
+			rtw_scanned_network_rehash(pmlmepriv, pnetwork);
+			new_in_scan = _TRUE;
 			/* variable initialize */
 			pnetwork->fixed = _FALSE;
-			pnetwork->last_scanned = rtw_get_current_time();
+			rtw_scanned_network_touch(pmlmepriv, pnetwork);
 			#if defined(CONFIG_RTW_MESH) && CONFIG_RTW_MESH_ACNODE_PREVENT
 			pnetwork->acnode_stime = 0;
 			pnetwork->acnode_notify_etime = 0;
@@ -1074,7 +1155,8 @@ bool rtw_update_scanned_network(_adapter *adapter, WLAN_BSSID_EX *target)
 			if (pnetwork->network.PhyInfo.SignalQuality == 101)
 				pnetwork->network.PhyInfo.SignalQuality = 0;
 
-			rtw_list_insert_tail(&(pnetwork->list), &(queue->queue));
+			rtw_scanned_network_link(pmlmepriv, pnetwork);
+			new_in_scan = _TRUE;
 
 		}
 	} else {
@@ -1082,11 +1164,13 @@ bool rtw_update_scanned_network(_adapter *adapter, WLAN_BSSID_EX *target)
 		 * be already expired. In this case we do the same as we found a new
 		 * net and call the new_net handler
 		 */
-		#if defined(CONFIG_RTW_MESH) && CONFIG_RTW_MESH_ACNODE_PREVENT
 		systime last_scanned = pnetwork->last_scanned;
-		#endif
 
-		pnetwork->last_scanned = rtw_get_current_time();
+		/* first seen in this scan */
+		if (rtw_time_after(pmlmepriv->scan_start_time, last_scanned))
+			new_in_scan = _TRUE;
+
+		rtw_scanned_network_touch(pmlmepriv, pnetwork);
 
 		/* target.Reserved[0]==BSS_TYPE_BCN, means that scanned network is a bcn frame. */
 		if ((pnetwork->network.IELength > target->IELength) && (target->Reserved[0] == BSS_TYPE_BCN))
@@ -1122,6 +1206,12 @@ bool rtw_update_scanned_network(_adapter *adapter, WLAN_BSSID_EX *target)
 unlock_scan_queue:
 	_exit_critical_bh(&queue->lock, &irqL);
 
+	/* count each BSS once per scan, by primary adapter only if buddy scans at the same time */
+	if (new_in_scan && check_fwstate(pmlmepriv, WIFI_SITE_MONITOR)
+		&& (is_primary_adapter(adapter) || !rtw_mi_buddy_check_fwstate(adapter, WIFI_SITE_MONITOR))
+	)
+		rtw_scan_hist_bss_found(adapter, target->Configuration.DSConfig);
+
 #ifdef CONFIG_RTW_MESH
 	if (pnetwork && MLME_IS_MESH(adapter)
 		&& check_fwstate(pmlmepriv, WIFI_ASOC_STATE)
@@ -1371,6 +1461,20 @@ void rtw_surveydone_event_callback(_adapter	*adapter, u8 *pbuf)
 			set_fwstate(pmlmepriv, _FW_UNDER_LINKING);
 			pmlmepriv->to_join = _FALSE;
 			s_ret = rtw_select_and_join_from_scanned_queue(pmlmepriv);
+			if (s_ret != _SUCCESS && s_ret != 2
+				&& pmlmepriv->fast_reconn_state == FAST_RECONN_SURVEY
+			) {
+				RTW_INFO("fast reconnect survey missed, fall back to full survey\n");
+				if (rtw_fast_reconn_fallback(adapter) == _SUCCESS) {
+					pmlmepriv->to_join = _TRUE;
+					_clr_fwstate_(pmlmepriv, _FW_UNDER_LINKING);
+					goto unlock;
+				}
+			}
+
+			if (pmlmepriv->fast_reconn_state == FAST_RECONN_SURVEY)
+				pmlmepriv->fast_reconn_state = FAST_RECONN_JOIN;
+
 			if (_SUCCESS == s_ret)
 				_set_timer(&pmlmepriv->assoc_timer, MAX_JOIN_TIMEOUT);
 			else if (s_ret == 2) { /* there is no need to wait for join */
@@ -1426,6 +1530,7 @@ void rtw_surveydone_event_callback(_adapter	*adapter, u8 *pbuf)
 
 	/* RTW_INFO("scan complete in %dms\n",rtw_get_passing_time_ms(pmlmepriv->scan_start_time)); */
 
+unlock:
 	_exit_critical_bh(&pmlmepriv->lock, &irqL);
 
 #ifdef CONFIG_P2P_PS
@@ -1623,7 +1728,7 @@ static void free_scanqueue(struct	mlme_priv *pmlmepriv)
 
 	while (plist != phead) {
 		ptemp = get_next(plist);
-		rtw_list_delete(plist);
+		rtw_scanned_network_unlink(LIST_CONTAINOR(plist, struct wlan_network, list));
 		rtw_list_insert_tail(plist, &free_queue->queue);
 		plist = ptemp;
 		pmlmepriv->num_of_scanned--;
@@ -1738,6 +1843,166 @@ void rtw_free_assoc_resources(_adapter *adapter, u8 lock_scanned_queue)
 
 }
 
+/*
+* rtw_join_timing_start - start timing of time-to-associate if not started
+* the caller has to lock pmlmepriv->lock
+*/
+void rtw_join_timing_start(_adapter *adapter)
+{
+	struct mlme_priv *mlme = &adapter->mlmepriv;
+
+	if (mlme->join_timing)
+		return;
+
+	mlme->join_timing = 1;
+	mlme->join_start_time = rtw_get_current_time();
+	mlme->fast_reconn_state = FAST_RECONN_NONE;
+}
+
+static void rtw_join_timing_end(_adapter *adapter)
+{
+	struct mlme_priv *mlme = &adapter->mlmepriv;
+	u8 fast = mlme->fast_reconn_state == FAST_RECONN_JOIN;
+
+	if (!mlme->join_timing)
+		return;
+
+	mlme->join_timing = 0;
+	mlme->join_lat_last_ms = rtw_get_passing_time_ms(mlme->join_start_time);
+	mlme->join_lat_hist[fast][rtw_log2_bucket(mlme->join_lat_last_ms, JOIN_LAT_HIST_NUM)]++;
+	if (fast)
+		mlme->fast_reconn_hit++;
+
+	RTW_INFO(FUNC_ADPT_FMT" time-to-associate:%ums%s\n", FUNC_ADPT_ARG(adapter)
+		, mlme->join_lat_last_ms, fast ? " (fast reconnect)" : "");
+}
+
+static void rtw_last_bss_update(_adapter *adapter)
+{
+	struct mlme_priv *mlme = &adapter->mlmepriv;
+	WLAN_BSSID_EX *bss = &mlme->cur_network.network;
+	struct rtw_last_bss *last = &mlme->last_bss;
+
+	if (!check_fwstate(mlme, WIFI_STATION_STATE))
+		return;
+
+	_rtw_memcpy(&last->ssid, &bss->Ssid, sizeof(NDIS_802_11_SSID));
+	_rtw_memcpy(last->bssid, bss->MacAddress, ETH_ALEN);
+	last->ch = bss->Configuration.DSConfig;
+	last->time = rtw_get_current_time();
+	last->valid = 1;
+}
+
+/*
+* rtw_fast_reconn_survey_parm - restrict the survey of a join to the channel of last BSS
+* @parm: survey parameter with the target SSID set
+*
+* Return _TRUE if @parm is restricted, the caller has to lock pmlmepriv->lock
+*/
+u8 rtw_fast_reconn_survey_parm(_adapter *adapter, struct sitesurvey_parm *parm)
+{
+	struct mlme_priv *mlme = &adapter->mlmepriv;
+	struct rtw_last_bss *last = &mlme->last_bss;
+	RT_CHANNEL_INFO *chset = adapter_to_rfctl(adapter)->channel_set;
+	int i;
+
+	if (mlme->fast_reconn_state != FAST_RECONN_NONE) {
+		/* the fast one didn't make it, this is a full survey */
+		if (mlme->fast_reconn_state != FAST_RECONN_FALLBACK) {
+			mlme->fast_reconn_state = FAST_RECONN_FALLBACK;
+			mlme->fast_reconn_fallback++;
+		}
+		return _FALSE;
+	}
+
+	if (!mlme->fast_reconn_exp_ms || !last->valid
+		|| !check_fwstate(mlme, WIFI_STATION_STATE)
+		|| rtw_get_passing_time_ms(last->time) > mlme->fast_reconn_exp_ms
+		|| rtw_chset_search_ch(chset, last->ch) < 0)
+		return _FALSE;
+
+	if (mlme->assoc_by_bssid) {
+		if (_rtw_memcmp(mlme->assoc_bssid, last->bssid, ETH_ALEN) == _FALSE)
+			return _FALSE;
+	} else if (mlme->assoc_ssid.SsidLength == 0
+		|| mlme->assoc_ssid.SsidLength != last->ssid.SsidLength
+		|| _rtw_memcmp(mlme->assoc_ssid.Ssid, last->ssid.Ssid, last->ssid.SsidLength) == _FALSE)
+		return _FALSE;
+
+	for (i = 0; i < RTW_FAST_RECONN_SURVEY_TIMES; i++) {
+		parm->ch[i].hw_value = last->ch;
+		parm->ch[i].flags = 0;
+	}
+	parm->ch_num = RTW_FAST_RECONN_SURVEY_TIMES;
+
+	mlme->fast_reconn_state = FAST_RECONN_SURVEY;
+	mlme->fast_reconn_cnt++;
+
+	RTW_INFO(FUNC_ADPT_FMT" fast reconnect to \"%s\" on ch%u\n"
+		, FUNC_ADPT_ARG(adapter), last->ssid.Ssid, last->ch);
+
+	return _TRUE;
+}
+
+/*
+* rtw_fast_reconn_fallback - issue full survey for join after single channel survey missed
+* the caller has to lock pmlmepriv->lock
+*/
+u8 rtw_fast_reconn_fallback(_adapter *adapter)
+{
+	struct mlme_priv *mlme = &adapter->mlmepriv;
+	struct sitesurvey_parm parm;
+	u8 ssc_chk;
+
+	if (mlme->fast_reconn_state != FAST_RECONN_SURVEY)
+		return _FAIL;
+
+	mlme->fast_reconn_state = FAST_RECONN_FALLBACK;
+	mlme->fast_reconn_fallback++;
+
+	ssc_chk = rtw_sitesurvey_condition_check(adapter, _FALSE);
+	if (ssc_chk != SS_ALLOW && ssc_chk != SS_DENY_BUSY_TRAFFIC)
+		return _FAIL;
+
+	rtw_init_sitesurvey_parm(adapter, &parm);
+	_rtw_memcpy(&parm.ssid[0], &mlme->assoc_ssid, sizeof(NDIS_802_11_SSID));
+	parm.ssid_num = 1;
+
+	return rtw_sitesurvey_cmd(adapter, &parm);
+}
+
+void dump_fast_reconn(void *sel, _adapter *adapter)
+{
+	struct mlme_priv *mlme = &adapter->mlmepriv;
+	struct rtw_last_bss *last = &mlme->last_bss;
+	int i, j;
+
+	if (last->valid)
+		RTW_PRINT_SEL(sel, "last_bss:\"%s\" "MAC_FMT" ch:%u age:%ums\n"
+			, last->ssid.Ssid, MAC_ARG(last->bssid), last->ch, rtw_get_passing_time_ms(last->time));
+	else
+		RTW_PRINT_SEL(sel, "last_bss:none\n");
+
+	RTW_PRINT_SEL(sel, "exp_ms:%u survey:%u hit:%u fallback:%u\n"
+		, mlme->fast_reconn_exp_ms, mlme->fast_reconn_cnt, mlme->fast_reconn_hit, mlme->fast_reconn_fallback);
+	RTW_PRINT_SEL(sel, "time-to-associate last:%ums\n", mlme->join_lat_last_ms);
+
+	for (j = 0; j < 2; j++) {
+		RTW_PRINT_SEL(sel, "%s(ms):", j ? "fast" : "normal");
+		for (i = 0; i < JOIN_LAT_HIST_NUM; i++) {
+			if (!mlme->join_lat_hist[j][i])
+				continue;
+			if (i == 0)
+				_RTW_PRINT_SEL(sel, " 0:%u", mlme->join_lat_hist[j][i]);
+			else if (i == JOIN_LAT_HIST_NUM - 1)
+				_RTW_PRINT_SEL(sel, " >=%u:%u", 1 << (i - 1), mlme->join_lat_hist[j][i]);
+			else
+				_RTW_PRINT_SEL(sel, " <%u:%u", 1 << i, mlme->join_lat_hist[j][i]);
+		}
+		_RTW_PRINT_SEL(sel, "\n");
+	}
+}
+
 /*
 *rtw_indicate_connect: the caller has to lock pmlmepriv->lock
 */
@@ -1756,6 +2021,9 @@ void rtw_indicate_connect(_adapter *padapter)
 		rtw_os_indicate_connect(padapter);
 	}
 
+	rtw_join_timing_end(padapter);
+	rtw_last_bss_update(padapter);
+
 	rtw_set_to_roam(padapter, 0);
 #ifdef CONFIG_INTEL_WIDI
 	if (padapter->mlmepriv.widi_state == INTEL_WIDI_STATE_ROAMING) {
@@ -1790,6 +2058,11 @@ void rtw_indicate_disconnect(_adapter *padapter, u16 reason, u8 locally_generate
 	if (check_fwstate(pmlmepriv, WIFI_UNDER_WPS))
 		pmlmepriv->wpa_phase = _TRUE;
 
+	/* the ongoing join, if any, ends without connection */
+	pmlmepriv->join_timing = 0;
+	if (check_fwstate(pmlmepriv, _FW_LINKED) && pmlmepriv->last_bss.valid)
+		pmlmepriv->last_bss.time = rtw_get_current_time();
+
 	_clr_fwstate_(pmlmepriv, _FW_UNDER_LINKING | WIFI_UNDER_WPS | WIFI_OP_CH_SWITCHING | WIFI_UNDER_KEY_HANDSHAKE);
 
 	/* force to clear cur_network_scanned's SELECTED REGISTRAR */
@@ -2070,9 +2343,11 @@ static struct sta_info *rtw_joinbss_update_stainfo(_adapter *padapter, struct wl
 		/* for A-MPDU Rx reordering buffer control for sta_info */
 		/* if A-MPDU Rx is enabled, reseting  rx_ordering_ctrl wstart_b(indicate_seq) to default value=0xffff */
 		/* todo: check if AP can send A-MPDU packets */
-		for (i = 0; i < 16 ; i++) {
-			/* preorder_ctrl = &precvpriv->recvreorder_ctrl[i]; */
-			preorder_ctrl = &psta->recvreorder_ctrl[i];
+		for (i = 0; i < TID_NUM; i++) {
+			/* allocated on ADDBA accept, see rtw_alloc_reorder_ctrl() */
+			preorder_ctrl = psta->recvreorder_ctrl[i];
+			if (!preorder_ctrl)
+				continue;
 			preorder_ctrl->enable = _FALSE;
 			preorder_ctrl->indicate_seq = 0xffff;
 			#ifdef DBG_RX_SEQ
@@ -2774,6 +3049,7 @@ u8 rtw_roam_nb_scan_list_set(
 		return ret;
 
 	rtw_init_sitesurvey_parm(padapter, pparm);
+	pparm->bg_scan = 1;
 	if (rtw_roam_busy_scan(padapter, pnb)) {
 		pparm->ch_num = 1;
 		pparm->ch[pmlmepriv->ch_cnt].hw_value = 
@@ -3249,6 +3525,7 @@ void rtw_drv_scan_by_self(_adapter *padapter, u8 reason)
 			parm.ch[i].flags = RTW_IEEE80211_CHAN_PASSIVE_SCAN;
 		}
 		parm.ch_num = 14;
+		parm.bg_scan = 1;
 		rtw_set_802_11_bssid_list_scan(padapter, &parm);
 		goto exit;
 	}
@@ -3259,7 +3536,9 @@ void rtw_drv_scan_by_self(_adapter *padapter, u8 reason)
 		goto exit;
 #endif
 
-	rtw_set_802_11_bssid_list_scan(padapter, NULL);
+	rtw_init_sitesurvey_parm(padapter, &parm);
+	parm.bg_scan = 1;
+	rtw_set_802_11_bssid_list_scan(padapter, &parm);
 exit:
 	return;
 }
@@ -764,6 +764,11 @@ void dump_chset(void *sel, RT_CHANNEL_INFO *ch_set)
 		_RTW_PRINT_SEL(sel, ", rx_count:%u", ch_set[i].rx_count);
 #endif
 
+		if (ch_set[i].scan_hist_num)
+			_RTW_PRINT_SEL(sel, ", scan_bss:%u.%03u, scan_load:%u, scan_hist:%u"
+				, ch_set[i].scan_bss_avg >> 3, (ch_set[i].scan_bss_avg & 0x7) * 125
+				, ch_set[i].scan_load, ch_set[i].scan_hist_num);
+
 #ifdef CONFIG_DFS_MASTER
 		if (rtw_is_dfs_ch(ch_set[i].ChannelNum)) {
 			if (CH_IS_NON_OCP(&ch_set[i]))
@@ -1579,7 +1584,7 @@ _continue:
 
 			_enter_critical_bh(&pstapriv->asoc_list_lock, &irqL);
 			if (rtw_is_list_empty(&psta->asoc_list)) {
-				psta->expire_to = pstapriv->expire_to;
+				rtw_sta_expire_arm(pstapriv, psta, pstapriv->expire_to);
 				rtw_list_insert_tail(&psta->asoc_list, &pstapriv->asoc_list);
 				pstapriv->asoc_list_cnt++;
 			}
@@ -1820,6 +1825,7 @@ unsigned int OnBeacon(_adapter *padapter, union recv_frame *precv_frame)
 	uint len = precv_frame->u.hdr.len;
 	WLAN_BSSID_EX *pbss;
 	int ret = _SUCCESS;
+	u32 bcn_crc;
 #ifdef CONFIG_TDLS
 	struct sta_info *ptdls_sta;
 	struct tdls_info *ptdlsinfo = &padapter->tdlsinfo;
@@ -1870,6 +1876,7 @@ unsigned int OnBeacon(_adapter *padapter, union recv_frame *precv_frame)
 						RTW_ERR("%s: get beacon keys failed\n", __func__);
 						_rtw_memset(&pmlmepriv->cur_beacon_keys, 0, sizeof(recv_beacon));
 					}
+					pmlmepriv->cur_bcn_crc_valid = _FALSE;
 					#ifdef CONFIG_BCN_CNT_CONFIRM_HDL
 					pmlmepriv->new_beacon_cnts = 0;
 					#endif
@@ -1924,17 +1931,31 @@ unsigned int OnBeacon(_adapter *padapter, union recv_frame *precv_frame)
 #ifdef CONFIG_RTW_80211R
 				rtw_ft_update_bcn(padapter, precv_frame);
 #endif
-				ret = rtw_check_bcn_info(padapter, pframe, len);
-				if (!ret) {
-					RTW_PRINT("ap has changed, disconnect now\n ");
-					receive_disconnect(padapter, pmlmeinfo->network.MacAddress , 0, _FALSE);
-					return _SUCCESS;
-				}
-				/* update WMM, ERP in the beacon */
-				/* todo: the timer is used instead of the number of the beacon received */
-				if ((sta_rx_pkts(psta) & 0xf) == 0) {
-					/* RTW_INFO("update_bcn_info\n"); */
+				bcn_crc = rtw_bcn_ie_crc(pframe, len);
+				if (pmlmepriv->cur_bcn_crc_valid && bcn_crc == pmlmepriv->cur_bcn_crc) {
+					/* same content as the last processed one, beacon keys and WMM, ERP, HT info are up to date */
+					pmlmepriv->bcn_crc_skip_cnt++;
+					#ifdef CONFIG_BCN_CNT_CONFIRM_HDL
+					pmlmepriv->new_beacon_cnts = 0;
+					#endif
+				} else {
+					pmlmepriv->bcn_crc_proc_cnt++;
+					ret = rtw_check_bcn_info(padapter, pframe, len);
+					if (!ret) {
+						RTW_PRINT("ap has changed, disconnect now\n ");
+						receive_disconnect(padapter, pmlmeinfo->network.MacAddress , 0, _FALSE);
+						return _SUCCESS;
+					}
+					/* update WMM, ERP in the beacon */
 					update_beacon_info(padapter, pframe, len, psta);
+
+					pmlmepriv->cur_bcn_crc = bcn_crc;
+					#ifdef CONFIG_BCN_CNT_CONFIRM_HDL
+					/* keys of this beacon are not adopted yet */
+					pmlmepriv->cur_bcn_crc_valid = pmlmepriv->new_beacon_cnts ? _FALSE : _TRUE;
+					#else
+					pmlmepriv->cur_bcn_crc_valid = _TRUE;
+					#endif
 				}
 
 				pmlmepriv->cur_network_scanned->network.Rssi = precv_frame->u.hdr.attrib.phy_info.recv_signal_power;
@@ -2172,7 +2193,7 @@ unsigned int OnAuth(_adapter *padapter, union recv_frame *precv_frame)
 	}
 
 	if (pstat->auth_seq == 0)
-		pstat->expire_to = pstapriv->auth_to;
+		rtw_sta_expire_arm(pstapriv, pstat, pstapriv->auth_to);
 
 #ifdef CONFIG_IOCTL_CFG80211
 	if (GET_CFG80211_REPORT_MGMT(adapter_wdev_data(padapter), IEEE80211_STYPE_AUTH) == _TRUE) {
@@ -2201,7 +2222,7 @@ unsigned int OnAuth(_adapter *padapter, union recv_frame *precv_frame)
 			{
 				pstat->state &= ~WIFI_FW_AUTH_NULL;
 				pstat->state |= WIFI_FW_AUTH_SUCCESS;
-				pstat->expire_to = pstapriv->assoc_to;
+				rtw_sta_expire_arm(pstapriv, pstat, pstapriv->assoc_to);
 			}
 			pstat->authalg = algorithm;
 		} else {
@@ -2214,8 +2235,15 @@ unsigned int OnAuth(_adapter *padapter, union recv_frame *precv_frame)
 		if (seq == 1) {
 			/* prepare for the challenging txt... */
 
-			/* get_random_bytes((void *)pstat->chg_txt, 128); */ /* TODO: */
-			_rtw_memset((void *)pstat->chg_txt, 78, 128);
+			struct sta_cold_info *cold = rtw_sta_cold_get(pstat);
+
+			if (!cold) {
+				status = _STATS_FAILURE_;
+				goto auth_fail;
+			}
+
+			/* get_random_bytes((void *)cold->chg_txt, 128); */ /* TODO: */
+			_rtw_memset((void *)cold->chg_txt, 78, 128);
 #ifdef CONFIG_IEEE80211W
 			if (pstat->bpairwise_key_installed != _TRUE && !(pstat->state & WIFI_FW_ASSOC_SUCCESS))
 #endif /* CONFIG_IEEE80211W */
@@ -2238,7 +2266,7 @@ unsigned int OnAuth(_adapter *padapter, union recv_frame *precv_frame)
 				goto auth_fail;
 			}
 
-			if (_rtw_memcmp((void *)(p + 2), pstat->chg_txt, 128)) {
+			if (pstat->cold && _rtw_memcmp((void *)(p + 2), pstat->cold->chg_txt, 128)) {
 #ifdef CONFIG_IEEE80211W
 				if (pstat->bpairwise_key_installed != _TRUE && !(pstat->state & WIFI_FW_ASSOC_SUCCESS))
 #endif /* CONFIG_IEEE80211W */
@@ -2246,7 +2274,7 @@ unsigned int OnAuth(_adapter *padapter, union recv_frame *precv_frame)
 					pstat->state &= (~WIFI_FW_AUTH_STATE);
 					pstat->state |= WIFI_FW_AUTH_SUCCESS;
 					/* challenging txt is correct... */
-					pstat->expire_to =  pstapriv->assoc_to;
+					rtw_sta_expire_arm(pstapriv, pstat, pstapriv->assoc_to);
 				}
 			} else {
 				RTW_INFO("auth rejected because challenge failure!\n");
@@ -2536,8 +2564,7 @@ unsigned int OnAssocReq(_adapter *padapter, union recv_frame *precv_frame)
 	}
 
 	/* (Extended) Supported rates */
-	status = rtw_ap_parse_sta_supported_rates(padapter, pstat
-		, pframe + WLAN_HDR_A3_LEN + ie_offset, pkt_len - WLAN_HDR_A3_LEN - ie_offset);
+	status = rtw_ap_parse_sta_supported_rates(padapter, pstat, &elems);
 	if (status != _STATS_SUCCESSFUL_)
 		goto OnAssocReqFail;
 
@@ -2547,8 +2574,7 @@ unsigned int OnAssocReq(_adapter *padapter, union recv_frame *precv_frame)
 		goto OnAssocReqFail;
 
 	/* check if there is WMM IE & support WWM-PS */
-	rtw_ap_parse_sta_wmm_ie(padapter, pstat
-		, pframe + WLAN_HDR_A3_LEN + ie_offset, pkt_len - WLAN_HDR_A3_LEN - ie_offset);
+	rtw_ap_parse_sta_wmm_ie(padapter, pstat, &elems);
 
 #ifdef CONFIG_RTS_FULL_BW
 	/*check vendor IE*/
@@ -2578,7 +2604,7 @@ unsigned int OnAssocReq(_adapter *padapter, union recv_frame *precv_frame)
 #ifdef CONFIG_P2P
 	pstat->is_p2p_device = _FALSE;
 	if (rtw_p2p_chk_role(pwdinfo, P2P_ROLE_GO)) {
-		p2pie = rtw_get_p2p_ie(pframe + WLAN_HDR_A3_LEN + ie_offset , pkt_len - WLAN_HDR_A3_LEN - ie_offset , NULL, &p2pielen);
+		p2pie = rtw_ie_idx_get_ie_ex(&elems.idx, WLAN_EID_VENDOR_SPECIFIC, P2P_OUI, 4, NULL, &p2pielen);
 		if (p2pie) {
 			pstat->is_p2p_device = _TRUE;
 			p2p_status_code = (u8)process_assoc_req_p2p_ie(pwdinfo, pframe, pkt_len, pstat);
@@ -2639,7 +2665,7 @@ unsigned int OnAssocReq(_adapter *padapter, union recv_frame *precv_frame)
 
 		_enter_critical_bh(&pstapriv->asoc_list_lock, &irqL);
 		if (rtw_is_list_empty(&pstat->asoc_list)) {
-			pstat->expire_to = pstapriv->expire_to;
+			rtw_sta_expire_arm(pstapriv, pstat, pstapriv->expire_to);
 			rtw_list_insert_tail(&pstat->asoc_list, &pstapriv->asoc_list);
 			pstapriv->asoc_list_cnt++;
 		}
@@ -3429,7 +3455,10 @@ bool rtw_rx_ampdu_set_accept(_adapter *adapter, u8 accept, u8 reason)
 u8 rx_ampdu_apply_sta_tid(_adapter *adapter, struct sta_info *sta, u8 tid, u8 accept, u8 size)
 {
 	u8 ret = 0;
-	struct recv_reorder_ctrl *reorder_ctl = &sta->recvreorder_ctrl[tid];
+	struct recv_reorder_ctrl *reorder_ctl = sta->recvreorder_ctrl[tid];
+
+	if (!reorder_ctl)
+		goto exit;
 
 	if (reorder_ctl->enable == _FALSE) {
 		if (reorder_ctl->ampdu_size != RX_AMPDU_SIZE_INVALID) {
@@ -3580,7 +3609,6 @@ unsigned int OnAction_back(_adapter *padapter, union recv_frame *precv_frame)
 {
 	u8 *addr;
 	struct sta_info *psta = NULL;
-	struct recv_reorder_ctrl *preorder_ctrl;
 	unsigned char		*frame_body;
 	unsigned char		category, action;
 	unsigned short	tid, status, reason_code = 0;
@@ -3664,7 +3692,7 @@ unsigned int OnAction_back(_adapter *padapter, union recv_frame *precv_frame)
 			if (psta->state & WIFI_STA_ALIVE_CHK_STATE) {
 				RTW_INFO("%s alive check - rx ADDBA response\n", __func__);
 				psta->htpriv.agg_enable_bitmap &= ~BIT(tid);
-				psta->expire_to = pstapriv->expire_to;
+				rtw_sta_expire_arm(pstapriv, psta, pstapriv->expire_to);
 				psta->state ^= WIFI_STA_ALIVE_CHK_STATE;
 			}
 
@@ -3681,9 +3709,15 @@ unsigned int OnAction_back(_adapter *padapter, union recv_frame *precv_frame)
 			} else if ((frame_body[3] & BIT(3)) == BIT(3)) {
 				tid = (frame_body[3] >> 4) & 0x0F;
 
-				preorder_ctrl = &psta->recvreorder_ctrl[tid];
-				preorder_ctrl->enable = _FALSE;
-				preorder_ctrl->ampdu_size = RX_AMPDU_SIZE_INVALID;
+				/* handled in RX context, no other RX of this STA can be holding it */
+#ifdef CONFIG_RECV_REORDERING_CTRL
+				if (psta->recvreorder_ctrl[tid]) {
+					/* deliver what is already received instead of dropping it */
+					_cancel_timer_ex(&psta->recvreorder_ctrl[tid]->reordering_ctrl_timer);
+					rtw_reorder_ctrl_indicate_all(psta->recvreorder_ctrl[tid]);
+				}
+#endif
+				rtw_free_reorder_ctrl(psta, tid);
 			}
 
 			RTW_INFO("%s(): DELBA: %x(%x)\n", __FUNCTION__, pmlmeinfo->agg_enable_bitmap, reason_code);
@@ -7713,14 +7747,19 @@ s32 dump_mgntframe_and_wait_ack_timeout(_adapter *padapter, struct xmit_frame *p
 	}
 
 	_enter_critical_mutex(&pxmitpriv->ack_tx_mutex, NULL);
-	pxmitpriv->ack_tx = _TRUE;
+	if (rtw_ack_tx_claim(pxmitpriv, timeout_ms) != _SUCCESS) {
+		/* ack report kept by asynchronous waiter */
+		_exit_critical_mutex(&pxmitpriv->ack_tx_mutex, NULL);
+		rtw_free_xmitbuf(&padapter->xmitpriv, pmgntframe->pxmitbuf);
+		rtw_free_xmitframe(&padapter->xmitpriv, pmgntframe);
+		return ret;
+	}
 	pxmitpriv->seq_no = seq_no++;
 	pmgntframe->ack_report = 1;
-	rtw_sctx_init(&(pxmitpriv->ack_tx_ops), timeout_ms);
 	if (rtw_hal_mgnt_xmit(padapter, pmgntframe) == _SUCCESS)
 		ret = rtw_sctx_wait(&(pxmitpriv->ack_tx_ops), __func__);
 
-	pxmitpriv->ack_tx = _FALSE;
+	rtw_ack_tx_release(pxmitpriv);
 	_exit_critical_mutex(&pxmitpriv->ack_tx_mutex, NULL);
 
 	return ret;
@@ -7737,6 +7776,130 @@ s32 dump_mgntframe_and_wait_ack(_adapter *padapter, struct xmit_frame *pmgntfram
 	return dump_mgntframe_and_wait_ack_timeout(padapter, pmgntframe, 500);
 }
 
+/*
+ * dump_mgntframe_and_ack_async - TX mgnt frame and report its ack by done_cb without waiting
+ * done_cb is called with RTW_SCTX_DONE_XXX status in TX report or timer context,
+ * or in caller context when frame can't be transmitted
+ * return _FAIL if ack report is not available, then the frame is sent without done_cb
+ */
+s32 dump_mgntframe_and_ack_async(_adapter *padapter, struct xmit_frame *pmgntframe, int timeout_ms
+	, void (*done_cb)(void *priv, int status), void *cb_priv)
+{
+#ifdef CONFIG_XMIT_ACK
+	struct xmit_priv *pxmitpriv = &(GET_PRIMARY_ADAPTER(padapter))->xmitpriv;
+
+	if (RTW_CANNOT_RUN(padapter)) {
+		rtw_free_xmitbuf(&padapter->xmitpriv, pmgntframe->pxmitbuf);
+		rtw_free_xmitframe(&padapter->xmitpriv, pmgntframe);
+		return _FAIL;
+	}
+
+	if (rtw_ack_tx_claim_async(pxmitpriv, timeout_ms, done_cb, cb_priv) != _SUCCESS) {
+		dump_mgntframe(padapter, pmgntframe);
+		return _FAIL;
+	}
+
+	pxmitpriv->seq_no++;
+	pmgntframe->ack_report = 1;
+	if (rtw_hal_mgnt_xmit(padapter, pmgntframe) != _SUCCESS)
+		rtw_ack_tx_done(pxmitpriv, RTW_SCTX_DONE_TX_DENY);
+
+	return _SUCCESS;
+#else /* !CONFIG_XMIT_ACK */
+	dump_mgntframe(padapter, pmgntframe);
+	return _FAIL;
+#endif /* !CONFIG_XMIT_ACK */
+}
+
+/* asynchronous mgnt frame TX with retry on no ack, see issue_mgnt_async() */
+struct mgnt_tx_async {
+	_adapter *adapter;
+	int (*issue)(struct mgnt_tx_async *req);
+	u8 ra[ETH_ALEN];
+	union {
+		struct {
+			u8 power_mode;
+		} null;
+		struct {
+			u8 tid;
+			u8 initiator;
+			u16 reason;
+		} del_ba;
+		struct {
+			u8 tid;
+			u8 size;
+			u16 status;
+		} addba_rsp;
+	} u;
+	u8 try_cnt;
+	u8 tx_cnt;
+	systime start;
+	mgnt_tx_async_cb done_cb;
+	void *priv;
+};
+
+#define MGNT_TX_ASYNC_ACK_TO 500
+
+static struct mgnt_tx_async *mgnt_tx_async_alloc(_adapter *adapter, const u8 *ra, int try_cnt
+	, mgnt_tx_async_cb done_cb, void *priv)
+{
+	struct mgnt_tx_async *req;
+
+	req = (struct mgnt_tx_async *)rtw_zmalloc(sizeof(struct mgnt_tx_async));
+	if (!req)
+		return NULL;
+
+	req->adapter = adapter;
+	_rtw_memcpy(req->ra, ra, ETH_ALEN);
+	req->try_cnt = rtw_max(try_cnt, 1);
+	req->start = rtw_get_current_time();
+	req->done_cb = done_cb;
+	req->priv = priv;
+
+	return req;
+}
+
+static int mgnt_tx_async_issue(struct mgnt_tx_async *req)
+{
+	req->tx_cnt++;
+	return req->issue(req);
+}
+
+static void mgnt_tx_async_done(void *priv, int status)
+{
+	struct mgnt_tx_async *req = (struct mgnt_tx_async *)priv;
+
+	/* not acked, try again from here without waiting */
+	if ((status == RTW_SCTX_DONE_CCX_PKT_FAIL || status == RTW_SCTX_DONE_TIMEOUT)
+		&& req->tx_cnt < req->try_cnt
+		&& !RTW_CANNOT_RUN(req->adapter)
+		&& mgnt_tx_async_issue(req) == _SUCCESS)
+		return;
+
+#ifdef DBG_XMIT_ACK
+	RTW_INFO(FUNC_ADPT_FMT" ra="MAC_FMT" status:%d, %u/%u in %u ms\n"
+		, FUNC_ADPT_ARG(req->adapter), MAC_ARG(req->ra), status
+		, req->tx_cnt, req->try_cnt, rtw_get_passing_time_ms(req->start));
+#endif
+
+	if (req->done_cb)
+		req->done_cb(req->adapter, req->ra, status == RTW_SCTX_DONE_SUCCESS, req->priv);
+	rtw_mfree((u8 *)req, sizeof(struct mgnt_tx_async));
+}
+
+/*
+ * issue_mgnt_async - start TX of req, req is freed after its done_cb
+ * return _FAIL if ack can't be reported, done_cb is not called and req is freed here
+ */
+static int issue_mgnt_async(struct mgnt_tx_async *req)
+{
+	if (mgnt_tx_async_issue(req) == _SUCCESS)
+		return _SUCCESS;
+
+	rtw_mfree((u8 *)req, sizeof(struct mgnt_tx_async));
+	return _FAIL;
+}
+
 
 int update_hidden_ssid(u8 *ies, u32 ies_len, u8 hidden_ssid_mode)
 {
@@ -8643,8 +8806,8 @@ void issue_auth(_adapter *padapter, struct sta_info *psta, unsigned short status
 		pframe = rtw_set_fixed_ie(pframe, _STATUS_CODE_, (unsigned char *)&val16, &(pattrib->pktlen));
 
 		/* added challenging text... */
-		if ((psta->auth_seq == 2) && (psta->state & WIFI_FW_AUTH_STATE) && (use_shared_key == 1))
-			pframe = rtw_set_ie(pframe, _CHLGETXT_IE_, 128, psta->chg_txt, &(pattrib->pktlen));
+		if ((psta->auth_seq == 2) && (psta->state & WIFI_FW_AUTH_STATE) && (use_shared_key == 1) && psta->cold)
+			pframe = rtw_set_ie(pframe, _CHLGETXT_IE_, 128, psta->cold->chg_txt, &(pattrib->pktlen));
 #endif
 	} else {
 		_rtw_memcpy(pwlanhdr->addr1, get_my_bssid(&pmlmeinfo->network), ETH_ALEN);
@@ -9434,8 +9597,12 @@ void issue_reassocreq(_adapter *padapter)
 	_issue_assocreq(padapter, _TRUE);
 }
 
-/* when wait_ack is ture, this function shoule be called at process context */
-static int _issue_nulldata(_adapter *padapter, unsigned char *da, unsigned int power_mode, int wait_ack)
+/*
+ * when wait_ack is ture, this function shoule be called at process context
+ * when rpt_sta is not NULL, TX report is requested without waiting and is attributed to the macid of rpt_sta
+ */
+static int _issue_nulldata(_adapter *padapter, unsigned char *da, unsigned int power_mode, int wait_ack, struct sta_info *rpt_sta
+	, struct mgnt_tx_async *async)
 {
 	int ret = _FAIL;
 	struct xmit_frame			*pmgntframe;
@@ -9469,6 +9636,17 @@ static int _issue_nulldata(_adapter *padapter, unsigned char *da, unsigned int p
 	update_mgntframe_attrib(padapter, pattrib);
 	pattrib->retry_ctrl = _FALSE;
 
+	if (rpt_sta) {
+		/* AC queue with macid of the STA, TX report carries the macid */
+		pattrib->mac_id = rpt_sta->cmn.mac_id;
+		pattrib->qsel = QSLT_VO;
+		pmgntframe->ack_report = 1;
+		#ifdef CONFIG_TX_CMPL_TRACK
+		/* report is told apart from data frames' of the macid by tx_cmpl_track */
+		pattrib->aka_probe = 1;
+		#endif
+	}
+
 	_rtw_memset(pmgntframe->buf_addr, 0, WLANHDR_OFFSET + TXDESC_OFFSET);
 
 	pframe = (u8 *)(pmgntframe->buf_addr) + TXDESC_OFFSET;
@@ -9512,7 +9690,9 @@ static int _issue_nulldata(_adapter *padapter, unsigned char *da, unsigned int p
 
 	pattrib->last_txcmdsz = pattrib->pktlen;
 
-	if (wait_ack)
+	if (async)
+		ret = dump_mgntframe_and_ack_async(padapter, pmgntframe, MGNT_TX_ASYNC_ACK_TO, mgnt_tx_async_done, async);
+	else if (wait_ack)
 		ret = dump_mgntframe_and_wait_ack(padapter, pmgntframe);
 	else {
 		dump_mgntframe(padapter, pmgntframe);
@@ -9546,7 +9726,7 @@ int issue_nulldata(_adapter *padapter, unsigned char *da, unsigned int power_mod
 		da = get_my_bssid(&(pmlmeinfo->network));
 
 	do {
-		ret = _issue_nulldata(padapter, da, power_mode, wait_ms > 0 ? _TRUE : _FALSE);
+		ret = _issue_nulldata(padapter, da, power_mode, wait_ms > 0 ? _TRUE : _FALSE, NULL, NULL);
 
 		i++;
 
@@ -9579,6 +9759,53 @@ exit:
 	return ret;
 }
 
+static int mgnt_tx_async_nulldata(struct mgnt_tx_async *req)
+{
+	return _issue_nulldata(req->adapter, req->ra, req->u.null.power_mode, _FALSE, NULL, req);
+}
+
+/*
+ * issue_nulldata_async - TX null data without waiting ack, ack is reported by done_cb
+ * up to try_cnt TX are tried until acked, done_cb can be NULL
+ * da == NULL for station mode
+ * return _FAIL if ack can't be reported, null data may be still sent without done_cb
+ */
+int issue_nulldata_async(_adapter *padapter, unsigned char *da, unsigned int power_mode, int try_cnt
+	, mgnt_tx_async_cb done_cb, void *priv)
+{
+	struct mlme_ext_priv *pmlmeext = &(padapter->mlmeextpriv);
+	struct mlme_ext_info *pmlmeinfo = &(pmlmeext->mlmext_info);
+	struct mgnt_tx_async *req;
+
+	if (rtw_rfctl_is_tx_blocked_by_ch_waiting(adapter_to_rfctl(padapter)))
+		return _FAIL;
+
+	/* da == NULL, assum it's null data for sta to ap */
+	if (da == NULL)
+		da = get_my_bssid(&(pmlmeinfo->network));
+
+	req = mgnt_tx_async_alloc(padapter, da, try_cnt, done_cb, priv);
+	if (!req) {
+		_issue_nulldata(padapter, da, power_mode, _FALSE, NULL, NULL);
+		return _FAIL;
+	}
+	req->issue = mgnt_tx_async_nulldata;
+	req->u.null.power_mode = power_mode;
+
+	return issue_mgnt_async(req);
+}
+
+#ifdef CONFIG_XMIT_ACK
+/*
+ * issue null data to psta without waiting ack,
+ * the result is reported by TX report of psta's macid
+ */
+int issue_nulldata_tx_rpt(_adapter *padapter, struct sta_info *psta)
+{
+	return _issue_nulldata(padapter, psta->cmn.mac_addr, 0, _FALSE, psta, NULL);
+}
+#endif
+
 /* when wait_ack is ture, this function shoule be called at process context */
 static int _issue_qos_nulldata(_adapter *padapter, unsigned char *da, u16 tid, u8 ps, int wait_ack)
 {
@@ -10028,13 +10255,14 @@ void issue_action_SA_Query(_adapter *padapter, unsigned char *raddr, unsigned ch
  * @status: status/reason code. used by ADDBA_RESP, DELBA
  * @initiator: if we are the initiator of AMPDU association. used by DELBA
  * @wait_ack: used xmit ack
+ * @async: report ack asynchronously to this request, wait_ack is ignored
  *
  * Returns:
- * _SUCCESS: No xmit ack is used or acked
+ * _SUCCESS: No xmit ack is used or acked, or ack will be reported to async
  * _FAIL: not acked when using xmit ack
  */
 static int issue_action_ba(_adapter *padapter, unsigned char *raddr, unsigned char action
-		   , u8 tid, u8 size, u16 status, u8 initiator, int wait_ack)
+		   , u8 tid, u8 size, u16 status, u8 initiator, int wait_ack, struct mgnt_tx_async *async)
 {
 	int ret = _FAIL;
 	u8	category = RTW_WLAN_CATEGORY_BACK;
@@ -10177,7 +10405,9 @@ static int issue_action_ba(_adapter *padapter, unsigned char *raddr, unsigned ch
 
 	pattrib->last_txcmdsz = pattrib->pktlen;
 
-	if (wait_ack)
+	if (async)
+		ret = dump_mgntframe_and_ack_async(padapter, pmgntframe, MGNT_TX_ASYNC_ACK_TO, mgnt_tx_async_done, async);
+	else if (wait_ack)
 		ret = dump_mgntframe_and_wait_ack(padapter, pmgntframe);
 	else {
 		dump_mgntframe(padapter, pmgntframe);
@@ -10203,6 +10433,7 @@ inline void issue_addba_req(_adapter *adapter, unsigned char *ra, u8 tid)
 			, 0 /* unused */
 			, 0 /* unused */
 			, _FALSE
+			, NULL
 		       );
 	RTW_INFO(FUNC_ADPT_FMT" ra="MAC_FMT" tid=%u\n"
 		 , FUNC_ADPT_ARG(adapter), MAC_ARG(ra), tid);
@@ -10225,6 +10456,7 @@ inline void issue_addba_rsp(_adapter *adapter, unsigned char *ra, u8 tid, u16 st
 			, status
 			, 0 /* unused */
 			, _FALSE
+			, NULL
 		       );
 	RTW_INFO(FUNC_ADPT_FMT" ra="MAC_FMT" status=%u, tid=%u, size=%u\n"
 		 , FUNC_ADPT_ARG(adapter), MAC_ARG(ra), status, tid, size);
@@ -10257,6 +10489,7 @@ inline u8 issue_addba_rsp_wait_ack(_adapter *adapter, unsigned char *ra, u8 tid,
 				      , status
 				      , 0 /* unused */
 				      , _TRUE
+				      , NULL
 				     );
 
 		i++;
@@ -10302,6 +10535,7 @@ inline void issue_del_ba(_adapter *adapter, unsigned char *ra, u8 tid, u16 reaso
 			, reason
 			, initiator
 			, _FALSE
+			, NULL
 		       );
 	RTW_INFO(FUNC_ADPT_FMT" ra="MAC_FMT" reason=%u, tid=%u, initiator=%u\n"
 		 , FUNC_ADPT_ARG(adapter), MAC_ARG(ra), reason, tid, initiator);
@@ -10335,6 +10569,7 @@ int issue_del_ba_ex(_adapter *adapter, unsigned char *ra, u8 tid, u16 reason, u8
 				      , reason
 				      , initiator
 				      , wait_ms > 0 ? _TRUE : _FALSE
+				      , NULL
 				     );
 
 		i++;
@@ -10363,6 +10598,104 @@ exit:
 	return ret;
 }
 
+static int mgnt_tx_async_addba_rsp(struct mgnt_tx_async *req)
+{
+	return issue_action_ba(req->adapter, req->ra, RTW_WLAN_ACTION_ADDBA_RESP
+			       , req->u.addba_rsp.tid
+			       , req->u.addba_rsp.size
+			       , req->u.addba_rsp.status
+			       , 0 /* unused */
+			       , _FALSE
+			       , req
+			      );
+}
+
+/**
+ * issue_addba_rsp_async - TX ADDBA_RESP without waiting ack, ack is reported by done_cb
+ * @adapter: the adapter to TX
+ * @ra: receiver address
+ * @tid: tid
+ * @status: status code
+ * @size: the announced AMPDU buffer size
+ * @try_cnt: the maximal TX count to try until acked
+ * @done_cb: called with ack result, can be NULL
+ * @priv: passed to done_cb
+ *
+ * Returns _FAIL if ack can't be reported, ADDBA_RESP may be still sent without done_cb
+ */
+int issue_addba_rsp_async(_adapter *adapter, unsigned char *ra, u8 tid, u16 status, u8 size
+			  , int try_cnt, mgnt_tx_async_cb done_cb, void *priv)
+{
+	struct mgnt_tx_async *req;
+
+	if (rtw_rfctl_is_tx_blocked_by_ch_waiting(adapter_to_rfctl(adapter)))
+		return _FAIL;
+
+	req = mgnt_tx_async_alloc(adapter, ra, try_cnt, done_cb, priv);
+	if (!req) {
+		issue_addba_rsp(adapter, ra, tid, status, size);
+		return _FAIL;
+	}
+	req->issue = mgnt_tx_async_addba_rsp;
+	req->u.addba_rsp.tid = tid;
+	req->u.addba_rsp.size = size;
+	req->u.addba_rsp.status = status;
+
+	RTW_INFO(FUNC_ADPT_FMT" ra="MAC_FMT" status=%u, tid=%u, size=%u\n"
+		 , FUNC_ADPT_ARG(adapter), MAC_ARG(ra), status, tid, size);
+
+	return issue_mgnt_async(req);
+}
+
+static int mgnt_tx_async_del_ba(struct mgnt_tx_async *req)
+{
+	return issue_action_ba(req->adapter, req->ra, RTW_WLAN_ACTION_DELBA
+			       , req->u.del_ba.tid
+			       , 0 /* unused */
+			       , req->u.del_ba.reason
+			       , req->u.del_ba.initiator
+			       , _FALSE
+			       , req
+			      );
+}
+
+/**
+ * issue_del_ba_async - TX DELBA without waiting ack, ack is reported by done_cb
+ * @adapter: the adapter to TX
+ * @ra: receiver address
+ * @tid: tid
+ * @reason: reason code
+ * @initiator: if we are the initiator of AMPDU association. used by DELBA
+ * @try_cnt: the maximal TX count to try until acked
+ * @done_cb: called with ack result, can be NULL
+ * @priv: passed to done_cb
+ *
+ * Returns _FAIL if ack can't be reported, DELBA may be still sent without done_cb
+ */
+int issue_del_ba_async(_adapter *adapter, unsigned char *ra, u8 tid, u16 reason, u8 initiator
+		       , int try_cnt, mgnt_tx_async_cb done_cb, void *priv)
+{
+	struct mgnt_tx_async *req;
+
+	if (rtw_rfctl_is_tx_blocked_by_ch_waiting(adapter_to_rfctl(adapter)))
+		return _FAIL;
+
+	req = mgnt_tx_async_alloc(adapter, ra, try_cnt, done_cb, priv);
+	if (!req) {
+		issue_del_ba(adapter, ra, tid, reason, initiator);
+		return _FAIL;
+	}
+	req->issue = mgnt_tx_async_del_ba;
+	req->u.del_ba.tid = tid;
+	req->u.del_ba.reason = reason;
+	req->u.del_ba.initiator = initiator;
+
+	RTW_INFO(FUNC_ADPT_FMT" ra="MAC_FMT" reason=%u, tid=%u, initiator=%u\n"
+		 , FUNC_ADPT_ARG(adapter), MAC_ARG(ra), reason, tid, initiator);
+
+	return issue_mgnt_async(req);
+}
+
 void issue_action_BSSCoexistPacket(_adapter *padapter)
 {
 	_irqL	irqL;
@@ -10676,11 +11009,16 @@ static unsigned int _send_delba_sta_tid(_adapter *adapter, u8 initiator, struct
 
 	if (initiator == 0) {
 		/* recipient */
-		if (force || sta->recvreorder_ctrl[tid].enable == _TRUE) {
-			u8 ampdu_size_bak = sta->recvreorder_ctrl[tid].ampdu_size;
+		struct recv_reorder_ctrl *reorder_ctl = sta->recvreorder_ctrl[tid];
 
-			sta->recvreorder_ctrl[tid].enable = _FALSE;
-			sta->recvreorder_ctrl[tid].ampdu_size = RX_AMPDU_SIZE_INVALID;
+		if (force || (reorder_ctl && reorder_ctl->enable == _TRUE)) {
+			u8 ampdu_size_bak = RX_AMPDU_SIZE_INVALID;
+
+			if (reorder_ctl) {
+				ampdu_size_bak = reorder_ctl->ampdu_size;
+				reorder_ctl->enable = _FALSE;
+				reorder_ctl->ampdu_size = RX_AMPDU_SIZE_INVALID;
+			}
 
 			if (rtw_del_rx_ampdu_test_trigger_no_tx_fail())
 				ret = _FAIL;
@@ -10689,8 +11027,8 @@ static unsigned int _send_delba_sta_tid(_adapter *adapter, u8 initiator, struct
 			else
 				issue_del_ba(adapter, sta->cmn.mac_addr, tid, 37, initiator);
 
-			if (ret == _FAIL && sta->recvreorder_ctrl[tid].enable == _FALSE)
-				sta->recvreorder_ctrl[tid].ampdu_size = ampdu_size_bak;
+			if (ret == _FAIL && reorder_ctl && reorder_ctl->enable == _FALSE)
+				reorder_ctl->ampdu_size = ampdu_size_bak;
 		}
 	} else if (initiator == 1) {
 		/* originator */
@@ -10911,6 +11249,7 @@ u8 collect_bss_info(_adapter *padapter, union recv_frame *precv_frame, WLAN_BSSI
 	u8	*pframe = precv_frame->u.hdr.rx_data;
 	u32	packet_len = precv_frame->u.hdr.len;
 	u8 ie_offset;
+	struct rtw_ie_idx ie_idx;
 	HAL_DATA_TYPE	*pHalData = GET_HAL_DATA(padapter);
 	struct registry_priv	*pregistrypriv = &padapter->registrypriv;
 	struct mlme_ext_priv	*pmlmeext = &padapter->mlmeextpriv;
@@ -10970,8 +11309,11 @@ u8 collect_bss_info(_adapter *padapter, union recv_frame *precv_frame, WLAN_BSSI
 	rtw_hal_get_odm_var(padapter, HAL_ODM_ANTDIV_SELECT, &(bssid->PhyInfo.Optimum_antenna), NULL);
 #endif
 
+	rtw_ie_idx_build(&ie_idx, bssid->IEs + ie_offset
+		, bssid->IELength > ie_offset ? bssid->IELength - ie_offset : 0);
+
 	/* checking SSID */
-	p = rtw_get_ie(bssid->IEs + ie_offset, _SSID_IE_, &len, bssid->IELength - ie_offset);
+	p = rtw_ie_idx_get_ie(&ie_idx, _SSID_IE_, &len);
 	if (p == NULL) {
 		RTW_INFO("marc: cannot find SSID for survey event\n");
 		return _FAIL;
@@ -10991,7 +11333,7 @@ u8 collect_bss_info(_adapter *padapter, union recv_frame *precv_frame, WLAN_BSSI
 
 	/* checking rate info... */
 	i = 0;
-	p = rtw_get_ie(bssid->IEs + ie_offset, _SUPPORTEDRATES_IE_, &len, bssid->IELength - ie_offset);
+	p = rtw_ie_idx_get_ie(&ie_idx, _SUPPORTEDRATES_IE_, &len);
 	if (p != NULL) {
 		if (len > NDIS_802_11_LENGTH_RATES_EX) {
 			RTW_INFO("%s()-%d: IE too long (%d) for survey event\n", __FUNCTION__, __LINE__, len);
@@ -11006,7 +11348,7 @@ u8 collect_bss_info(_adapter *padapter, union recv_frame *precv_frame, WLAN_BSSI
 		i = len;
 	}
 
-	p = rtw_get_ie(bssid->IEs + ie_offset, _EXT_SUPPORTEDRATES_IE_, &len, bssid->IELength - ie_offset);
+	p = rtw_ie_idx_get_ie(&ie_idx, _EXT_SUPPORTEDRATES_IE_, &len);
 	if (p != NULL) {
 		if (len > (NDIS_802_11_LENGTH_RATES_EX - i)) {
 			RTW_INFO("%s()-%d: IE too long (%d) for survey event\n", __FUNCTION__, __LINE__, len);
@@ -11060,7 +11402,7 @@ u8 collect_bss_info(_adapter *padapter, union recv_frame *precv_frame, WLAN_BSSI
 		return _FAIL;
 
 	/* Checking for DSConfig */
-	p = rtw_get_ie(bssid->IEs + ie_offset, _DSSET_IE_, &len, bssid->IELength - ie_offset);
+	p = rtw_ie_idx_get_ie(&ie_idx, _DSSET_IE_, &len);
 
 	bssid->Configuration.DSConfig = 0;
 	bssid->Configuration.Length = 0;
@@ -11070,7 +11412,7 @@ u8 collect_bss_info(_adapter *padapter, union recv_frame *precv_frame, WLAN_BSSI
 	else {
 		/* In 5G, some ap do not have DSSET IE */
 		/* checking HT info for channel */
-		p = rtw_get_ie(bssid->IEs + ie_offset, _HT_ADD_INFO_IE_, &len, bssid->IELength - ie_offset);
+		p = rtw_ie_idx_get_ie(&ie_idx, _HT_ADD_INFO_IE_, &len);
 		if (p) {
 			struct HT_info_element *HT_info = (struct HT_info_element *)(p + 2);
 			bssid->Configuration.DSConfig = HT_info->primary_channel;
@@ -11095,8 +11437,8 @@ u8 collect_bss_info(_adapter *padapter, union recv_frame *precv_frame, WLAN_BSSI
 		u8 *mesh_id_ie, *mesh_conf_ie;
 		sint mesh_id_ie_len, mesh_conf_ie_len;
 
-		mesh_id_ie = rtw_get_ie(bssid->IEs + ie_offset, WLAN_EID_MESH_ID, &mesh_id_ie_len, bssid->IELength - ie_offset);
-		mesh_conf_ie = rtw_get_ie(bssid->IEs + ie_offset, WLAN_EID_MESH_CONFIG, &mesh_conf_ie_len, bssid->IELength - ie_offset);
+		mesh_id_ie = rtw_ie_idx_get_ie(&ie_idx, WLAN_EID_MESH_ID, &mesh_id_ie_len);
+		mesh_conf_ie = rtw_ie_idx_get_ie(&ie_idx, WLAN_EID_MESH_CONFIG, &mesh_conf_ie_len);
 		if (mesh_id_ie || mesh_conf_ie) {
 			if (!mesh_id_ie) {
 				RTW_INFO("cannot find Mesh ID for survey event\n");
@@ -11141,7 +11483,7 @@ u8 collect_bss_info(_adapter *padapter, union recv_frame *precv_frame, WLAN_BSSI
 	if ((pregistrypriv->wifi_spec == 1) && (_FALSE == pmlmeinfo->bwmode_updated)) {
 		struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
 #ifdef CONFIG_80211N_HT
-		p = rtw_get_ie(bssid->IEs + ie_offset, _HT_CAPABILITY_IE_, &len, bssid->IELength - ie_offset);
+		p = rtw_ie_idx_get_ie(&ie_idx, _HT_CAPABILITY_IE_, &len);
 		if (p && len > 0) {
 			struct HT_caps_element	*pHT_caps;
 			pHT_caps = (struct HT_caps_element *)(p + 2);
@@ -11175,7 +11517,7 @@ u8 collect_bss_info(_adapter *padapter, union recv_frame *precv_frame, WLAN_BSSI
 		bssid->PhyInfo.SignalQuality = 101;
 
 #ifdef CONFIG_RTW_80211K
-	p = rtw_get_ie(bssid->IEs + ie_offset, _EID_RRM_EN_CAP_IE_, &len, bssid->IELength - ie_offset);
+	p = rtw_ie_idx_get_ie(&ie_idx, _EID_RRM_EN_CAP_IE_, &len);
 	if (p)
 		_rtw_memcpy(bssid->PhyInfo.rm_en_cap, (p + 2), *(p + 1));
 
@@ -11265,6 +11607,8 @@ void start_clnt_join(_adapter *padapter)
 	caps = rtw_get_capability((WLAN_BSSID_EX *)pnetwork);
 	update_capinfo(padapter, caps);
 
+	padapter->mlmepriv.cur_bcn_crc_valid = _FALSE;
+
 	/* check if sta is ASIX peer and fix IOT issue if it is. */
 	if (_rtw_memcmp(get_my_bssid(&pmlmeinfo->network) , ASIX_ID , 3)) {
 		u8 iot_flag = _TRUE;
@@ -11376,6 +11720,8 @@ void start_clnt_auth(_adapter *padapter)
 	pmlmeinfo->reassoc_count = 0;
 	pmlmeinfo->link_count = 0;
 	pmlmeext->retry = 0;
+	pmlmeext->ka_null_acked = 0;
+	pmlmeext->ka_null_pending = 0;
 
 #ifdef CONFIG_RTW_80211R
 	if (rtw_ft_roam(padapter)) {
@@ -12260,6 +12606,9 @@ static void rtw_mlmeext_disconnect(_adapter *padapter)
 		rtw_warn_on(1);
 	}
 
+	/* keep alive null data of this link, if still in flight, is no longer of interest */
+	pmlmeext->ka_null_pending = 0;
+
 	/* set_opmode_cmd(padapter, infra_client_with_mlme); */
 #ifdef CONFIG_HW_P0_TSF_SYNC
 	if (self_action == MLME_STA_DISCONNECTED)
@@ -12545,10 +12894,28 @@ When station does not receive any packet in MAX_CONTINUAL_NORXPACKET_COUNT*2 sec
 recipient station will teardown the block ack by issuing DELBA frame.
 
 *********************************************************************/
+static void rtw_delba_check_done(_adapter *adapter, const u8 *ra, bool acked, void *priv)
+{
+	u8 tid = (u8)(SIZE_PTR)priv;
+	struct sta_info *psta;
+	struct recv_reorder_ctrl *reorder_ctl;
+
+	if (!acked)
+		return;
+
+	psta = rtw_get_stainfo(&adapter->stapriv, ra);
+	if (!psta)
+		return;
+
+	/* not set up again by ADDBA in the meantime */
+	reorder_ctl = psta->recvreorder_ctrl[tid];
+	if (reorder_ctl && reorder_ctl->enable == _FALSE)
+		reorder_ctl->ampdu_size = RX_AMPDU_SIZE_INVALID;
+}
+
 void rtw_delba_check(_adapter *padapter, struct sta_info *psta, u8 from_timer)
 {
 	int	i = 0;
-	int ret = _SUCCESS;
 	struct mlme_ext_priv	*pmlmeext = &padapter->mlmeextpriv;
 	struct mlme_ext_info	*pmlmeinfo = &(pmlmeext->mlmext_info);
 
@@ -12562,17 +12929,21 @@ void rtw_delba_check(_adapter *padapter, struct sta_info *psta, u8 from_timer)
 	*/
 	if (pmlmeinfo->assoc_AP_vendor == HT_IOT_PEER_BROADCOM) {
 		for (i = 0; i < TID_NUM ; i++) {
-			if ((psta->recvreorder_ctrl[i].enable) && 
+			struct recv_reorder_ctrl *reorder_ctl = psta->recvreorder_ctrl[i];
+
+			if (reorder_ctl && (reorder_ctl->enable) && 
                         (sta_rx_data_qos_pkts(psta, i) == sta_last_rx_data_qos_pkts(psta, i)) ) {			
 					if (_TRUE == rtw_inc_and_chk_continual_no_rx_packet(psta, i)) {					
 						/* send a DELBA frame to the peer STA with the Reason Code field set to TIMEOUT */
-						if (!from_timer)
-							ret = issue_del_ba_ex(padapter, psta->cmn.mac_addr, i, 39, 0, 3, 1);
-						else
+						reorder_ctl->enable = _FALSE;
+						if (!from_timer) {
+							/* ampdu_size is invalidated when acked */
+							issue_del_ba_async(padapter, psta->cmn.mac_addr, i, 39, 0, 3
+								, rtw_delba_check_done, (void *)(SIZE_PTR)i);
+						} else {
 							issue_del_ba(padapter,  psta->cmn.mac_addr, i, 39, 0);
-						psta->recvreorder_ctrl[i].enable = _FALSE;
-						if (ret != _FAIL)
-							psta->recvreorder_ctrl[i].ampdu_size = RX_AMPDU_SIZE_INVALID;
+							reorder_ctl->ampdu_size = RX_AMPDU_SIZE_INVALID;
+						}
 						rtw_reset_continual_no_rx_packet(psta, i);
 					}				
 			} else {
@@ -12752,6 +13123,33 @@ void linked_status_chk_tdls(_adapter *padapter)
 #endif /* CONFIG_TDLS */
 
 /* from_timer == 1 means driver is in LPS */
+
+static void linked_ka_nulldata_done(_adapter *adapter, const u8 *ra, bool acked, void *priv)
+{
+	struct mlme_ext_priv *pmlmeext = &adapter->mlmeextpriv;
+
+	if (acked)
+		pmlmeext->ka_null_acked = 1;
+	pmlmeext->ka_null_pending = 0;
+}
+
+/*
+ * linked_ka_nulldata - keep alive null data without waiting ack
+ * the ack is consumed by next linked_status_chk()
+ */
+static void linked_ka_nulldata(_adapter *adapter, u8 *da, u8 ps, int try_cnt)
+{
+	struct mlme_ext_priv *pmlmeext = &adapter->mlmeextpriv;
+
+	if (pmlmeext->ka_null_pending)
+		return;
+
+	/* set before issue, done_cb may be called in issue_nulldata_async() */
+	pmlmeext->ka_null_pending = 1;
+	if (issue_nulldata_async(adapter, da, ps, try_cnt, linked_ka_nulldata_done, NULL) != _SUCCESS)
+		pmlmeext->ka_null_pending = 0;
+}
+
 void linked_status_chk(_adapter *padapter, u8 from_timer)
 {
 	u32	i;
@@ -12865,6 +13263,15 @@ void linked_status_chk(_adapter *padapter, u8 from_timer)
 			if (sta_last_tx_pkts(psta) == sta_tx_pkts(psta))
 				tx_chk = _FAIL;
 
+			/* keep alive null data issued by previous check is acked */
+			if (pmlmeext->ka_null_acked) {
+				pmlmeext->ka_null_acked = 0;
+				tx_chk = _SUCCESS;
+				/* if p2p disabled, set rx_chk _SUCCESS to reset retry count */
+				if (pmlmeext->active_keep_alive_check && !is_p2p_enable)
+					rx_chk = _SUCCESS;
+			}
+
 #ifdef CONFIG_ACTIVE_KEEP_ALIVE_CHECK
 			if (!from_timer && pmlmeext->active_keep_alive_check && (rx_chk == _FAIL || tx_chk == _FAIL)
 			) {
@@ -12898,13 +13305,16 @@ void linked_status_chk(_adapter *padapter, u8 from_timer)
 					issue_probereq_ex(padapter, &pmlmeinfo->network.Ssid, psta->cmn.mac_addr, 0, 0, 3, 1);
 
 				if ((tx_chk != _SUCCESS && pmlmeinfo->link_count++ == link_count_limit) || rx_chk != _SUCCESS) {
-					if (rtw_mi_check_fwstate(padapter, _FW_UNDER_SURVEY))
-						tx_chk = issue_nulldata(padapter, psta->cmn.mac_addr, 1, 3, 1);
-					else
-						tx_chk = issue_nulldata(padapter, psta->cmn.mac_addr, 0, 3, 1);
-					/* if tx acked and p2p disabled, set rx_chk _SUCCESS to reset retry count */
-					if (tx_chk == _SUCCESS && !is_p2p_enable)
-						rx_chk = _SUCCESS;
+					u8 ps = rtw_mi_check_fwstate(padapter, _FW_UNDER_SURVEY) ? 1 : 0;
+
+					if (backup_ch > 0) {
+						/* must be done before back to the original operation channel */
+						tx_chk = issue_nulldata(padapter, psta->cmn.mac_addr, ps, 3, 1);
+						/* if tx acked and p2p disabled, set rx_chk _SUCCESS to reset retry count */
+						if (tx_chk == _SUCCESS && !is_p2p_enable)
+							rx_chk = _SUCCESS;
+					} else
+						linked_ka_nulldata(padapter, psta->cmn.mac_addr, ps, 3);
 				}
 
 				/* back to the original operation channel */
@@ -12939,13 +13349,14 @@ bypass_active_keep_alive:
 					if (from_timer || rtw_mi_check_fwstate(padapter, _FW_UNDER_SURVEY))
 						tx_chk = issue_nulldata(padapter, NULL, 1, 0, 0);
 					else
-						tx_chk = issue_nulldata(padapter, NULL, 0, 1, 1);
+						linked_ka_nulldata(padapter, NULL, 0, 1);
 				}
 			}
 
 			if (rx_chk == _FAIL) {
 				pmlmeext->retry++;
-				if (pmlmeext->retry > rx_chk_limit) {
+				/* wait for the result of keep alive null data in flight */
+				if (pmlmeext->retry > rx_chk_limit && !pmlmeext->ka_null_pending) {
 					RTW_PRINT(FUNC_ADPT_FMT" disconnect or roaming\n",
 						  FUNC_ADPT_ARG(padapter));
 					receive_disconnect(padapter, pmlmeinfo->network.MacAddress
@@ -13275,6 +13686,7 @@ void rtw_ft_update_bcn(_adapter *padapter, union recv_frame *precv_frame)
 					RTW_ERR("%s: get beacon keys failed\n", __func__);
 					_rtw_memset(&pmlmepriv->cur_beacon_keys, 0, sizeof(recv_beacon));
 				}
+				pmlmepriv->cur_bcn_crc_valid = _FALSE;
 				#ifdef CONFIG_BCN_CNT_CONFIRM_HDL
 				pmlmepriv->new_beacon_cnts = 0;
 				#endif
@@ -14323,6 +14735,10 @@ u8 rtw_scan_backop_decision(_adapter *adapter)
 		|| (MSTATE_STA_NUM(&mstate) && mlmeext_chk_scan_backop_flags_sta(mlmeext, SS_BACKOP_EN_NL)))
 		backop_flags |= mlmeext_scan_backop_flags_sta(mlmeext);
 
+	/* background scan always goes back to operating channel when linked */
+	if (mlmeext->sitesurvey_res.bg_scan && MSTATE_STA_LD_NUM(&mstate))
+		backop_flags |= mlmeext_scan_backop_flags_sta(mlmeext) | SS_BACKOP_EN;
+
 #ifdef CONFIG_AP_MODE
 	if ((MSTATE_AP_LD_NUM(&mstate) && mlmeext_chk_scan_backop_flags_ap(mlmeext, SS_BACKOP_EN))
 		|| (MSTATE_AP_NUM(&mstate) && mlmeext_chk_scan_backop_flags_ap(mlmeext, SS_BACKOP_EN_NL)))
@@ -14337,10 +14753,101 @@ u8 rtw_scan_backop_decision(_adapter *adapter)
 
 	return backop_flags;
 }
+
+static const struct {
+	u8 slice_ch_num; /* 0: use scan_cnt_max */
+	u16 slice_backop_ms; /* 0: use backop_ms */
+	u16 offch_budget_ms;
+} ss_bg_policy[SS_BG_TL_NUM] = {
+	[SS_BG_TL_IDLE] = {0, 0, 600},
+	[SS_BG_TL_LIGHT] = {1, 100, 300},
+	[SS_BG_TL_BUSY] = {1, 300, 200},
+};
+
+static u8 rtw_scan_bg_traffic_level(_adapter *adapter)
+{
+	struct dvobj_priv *dvobj = adapter_to_dvobj(adapter);
+	_adapter *iface;
+	u32 pkt_num = 0;
+	int i;
+
+	if (dvobj->traffic_stat.cur_tx_tp + dvobj->traffic_stat.cur_rx_tp >= RTW_BG_SCAN_TP_BUSY)
+		return SS_BG_TL_BUSY;
+
+	for (i = 0; i < dvobj->iface_nums; i++) {
+		iface = dvobj->padapters[i];
+		if (!iface || !rtw_is_adapter_up(iface))
+			continue;
+		pkt_num += iface->mlmepriv.LinkDetectInfo.NumTxOkInPeriod
+			+ iface->mlmepriv.LinkDetectInfo.NumRxUnicastOkInPeriod;
+	}
+
+	return pkt_num >= RTW_BG_SCAN_PKT_LIGHT ? SS_BG_TL_LIGHT : SS_BG_TL_IDLE;
+}
+
+/* decide off-channel slice of scan, by live traffic for background scan */
+static void rtw_scan_slice_decision(_adapter *adapter)
+{
+	struct ss_res *ss = &adapter->mlmeextpriv.sitesurvey_res;
+
+	ss->slice_ch_num = ss->scan_cnt_max;
+	ss->slice_backop_ms = ss->backop_ms;
+	if (!ss->bg_scan)
+		return;
+
+	ss->bg_tl = rtw_scan_bg_traffic_level(adapter);
+	if (ss_bg_policy[ss->bg_tl].slice_ch_num)
+		ss->slice_ch_num = rtw_min(ss->slice_ch_num, ss_bg_policy[ss->bg_tl].slice_ch_num);
+	if (ss_bg_policy[ss->bg_tl].slice_backop_ms)
+		ss->slice_backop_ms = ss_bg_policy[ss->bg_tl].slice_backop_ms;
+	ss->offch_budget_ms = ss_bg_policy[ss->bg_tl].offch_budget_ms;
+}
+
+/*
+ * rtw_scan_offch_budget_chk - check if next slice fits in off-channel budget
+ * a slice is always allowed in a fresh window, so scan makes progress
+ * even when budget is less than a single channel dwell
+ */
+static bool rtw_scan_offch_budget_chk(_adapter *adapter)
+{
+	struct ss_res *ss = &adapter->mlmeextpriv.sitesurvey_res;
+	u32 slice_ms;
+
+	if (!ss->bg_scan)
+		return _TRUE;
+
+	if (rtw_get_passing_time_ms(ss->offch_win_time) >= RTW_BG_SCAN_BUDGET_WIN_MS) {
+		ss->offch_win_time = rtw_get_current_time();
+		ss->offch_win_ms = 0;
+	}
+
+	slice_ms = ss->slice_ch_num * ss->scan_ch_ms;
+	if (ss->offch_win_ms == 0 || ss->offch_win_ms + slice_ms <= ss->offch_budget_ms)
+		return _TRUE;
+
+	return _FALSE;
+}
+
+static void rtw_scan_offch_start(_adapter *adapter)
+{
+	struct ss_res *ss = &adapter->mlmeextpriv.sitesurvey_res;
+
+	ss->offch_time = rtw_get_current_time();
+	if (ss->bg_scan)
+		ss->bg_slice_cnt++;
+}
+
+static void rtw_scan_offch_end(_adapter *adapter)
+{
+	struct ss_res *ss = &adapter->mlmeextpriv.sitesurvey_res;
+	u32 offch_ms = rtw_get_passing_time_ms(ss->offch_time);
+
+	ss->offch_win_ms = rtw_min(ss->offch_win_ms + offch_ms, 0xFFFF);
+}
 #endif
 
 #define SCANNING_TIMEOUT_EX	2000
-u32 rtw_scan_timeout_decision(_adapter *padapter)
+u32 rtw_scan_timeout_decision(_adapter *padapter, struct sitesurvey_parm *pparm)
 {
 	u32 back_op_times= 0;
 	u8 max_chan_num;
@@ -14355,7 +14862,10 @@ u32 rtw_scan_timeout_decision(_adapter *padapter)
 		max_chan_num = MAX_CHANNEL_NUM_2G;/*single band*/
 
 	#ifdef CONFIG_SCAN_BACKOP
-	if (rtw_scan_backop_decision(padapter))
+	/* background scan may wait for off-channel budget on every channel */
+	if (pparm && pparm->bg_scan && rtw_mi_check_status(padapter, MI_LINKED))
+		back_op_times = max_chan_num * RTW_BG_SCAN_BUDGET_WIN_MS;
+	else if (rtw_scan_backop_decision(padapter))
 		back_op_times = (max_chan_num / ss->scan_cnt_max) * ss->backop_ms;
 	#endif
 
@@ -14367,7 +14877,7 @@ u32 rtw_scan_timeout_decision(_adapter *padapter)
 		scan_ms = rtw_acs_get_adv_st(padapter);
 	else
 	#endif /*CONFIG_RTW_ACS*/
-		scan_ms = ss->scan_ch_ms;
+		scan_ms = RTW_SCAN_DWELL_BUSY(ss->scan_ch_ms);
 
 	ss->scan_timeout_ms = (scan_ms * max_chan_num) + back_op_times + SCANNING_TIMEOUT_EX;
 	#ifdef DBG_SITESURVEY
@@ -14376,6 +14886,156 @@ u32 rtw_scan_timeout_decision(_adapter *padapter)
 	return ss->scan_timeout_ms;
 }
 
+/* scans before history is used for dwell time */
+#define RTW_SCAN_HIST_MIN 2
+/* every RTW_SCAN_HIST_REFRESH scans use full dwell time to refresh history */
+#define RTW_SCAN_HIST_REFRESH 4
+/* CLM + NHM ratio in percent below which channel is idle, or above which busy */
+#define RTW_SCAN_LOAD_IDLE 10
+#define RTW_SCAN_LOAD_BUSY 50
+/* average BSS found per scan above which channel is busy */
+#define RTW_SCAN_BSS_BUSY 4
+
+static u8 rtw_scan_ch_score(_adapter *adapter, u8 ch)
+{
+	RT_CHANNEL_INFO *chset = adapter_to_chset(adapter);
+	int set_idx = rtw_chset_search_ch(chset, ch);
+
+#if defined(CONFIG_RTW_WNM) || defined(CONFIG_RTW_80211K)
+	{
+		struct roam_nb_info *nb = &adapter->mlmepriv.nb_info;
+		int i;
+
+		if (nb->nb_rpt_valid) {
+			for (i = 0; i < nb->nb_rpt_ch_list_num; i++)
+				if (nb->nb_rpt_ch_list[i].hw_value == ch)
+					return 0xFF;
+		}
+	}
+#endif
+
+	/* channel without history goes first to learn */
+	if (set_idx < 0 || !chset[set_idx].scan_hist_num)
+		return 0xFF;
+
+	return chset[set_idx].scan_bss_avg;
+}
+
+/*
+ * rtw_scan_ch_order - order channels by BSS found in previous scans
+ * so that scan results which matter most are got early, when scan is
+ * aborted or split by rtw_scan_sparse() as well
+ */
+static void rtw_scan_ch_order(_adapter *adapter, struct rtw_ieee80211_channel *ch, u8 ch_num)
+{
+	u8 score[RTW_CHANNEL_SCAN_AMOUNT];
+	struct rtw_ieee80211_channel tmp_ch;
+	u8 tmp_score;
+	int i, j;
+
+	if (dvobj_to_regsty(adapter_to_dvobj(adapter))->wifi_spec
+		|| ch_num > RTW_CHANNEL_SCAN_AMOUNT)
+		return;
+
+	for (i = 0; i < ch_num; i++)
+		score[i] = rtw_scan_ch_score(adapter, ch[i].hw_value);
+
+	/* stable, keeps repeated channels adjacent */
+	for (i = 1; i < ch_num; i++) {
+		tmp_ch = ch[i];
+		tmp_score = score[i];
+		for (j = i - 1; j >= 0 && score[j] < tmp_score; j--) {
+			ch[j + 1] = ch[j];
+			score[j + 1] = score[j];
+		}
+		ch[j + 1] = tmp_ch;
+		score[j + 1] = tmp_score;
+	}
+}
+
+/*
+ * rtw_scan_ch_dwell - mark scan channel visited and get its dwell time by history
+ * shorten on channel found idle by previous scans, lengthen on busy one
+ */
+static u32 rtw_scan_ch_dwell(_adapter *adapter, u8 ch, u32 scan_ms)
+{
+	struct ss_res *ss = &adapter->mlmeextpriv.sitesurvey_res;
+	RT_CHANNEL_INFO *chset = adapter_to_chset(adapter);
+	int set_idx;
+
+	set_idx = rtw_chset_search_ch(chset, ch);
+	if (set_idx < 0)
+		return scan_ms;
+	chset[set_idx].scan_visited = 1;
+
+	if (dvobj_to_regsty(adapter_to_dvobj(adapter))->wifi_spec || ss->duration)
+		return scan_ms;
+
+	if (chset[set_idx].scan_hist_num < RTW_SCAN_HIST_MIN
+		|| (chset[set_idx].scan_hist_num % RTW_SCAN_HIST_REFRESH) == 0)
+		return scan_ms;
+
+	if (chset[set_idx].scan_bss_avg == 0 && chset[set_idx].scan_load < RTW_SCAN_LOAD_IDLE)
+		return RTW_SCAN_DWELL_IDLE(scan_ms);
+
+	if (chset[set_idx].scan_bss_avg >= RTW_SCAN_BSS_BUSY * 8 || chset[set_idx].scan_load >= RTW_SCAN_LOAD_BUSY) {
+		#ifdef CONFIG_SCAN_BACKOP
+		/* don't stay longer off channel for background scan with traffic */
+		if (ss->bg_scan && ss->bg_tl != SS_BG_TL_IDLE)
+			return scan_ms;
+		#endif
+		return RTW_SCAN_DWELL_BUSY(scan_ms);
+	}
+
+	return scan_ms;
+}
+
+/* a BSS not yet seen in this scan is found on ch, called by rtw_update_scanned_network() */
+void rtw_scan_hist_bss_found(_adapter *adapter, u8 ch)
+{
+	RT_CHANNEL_INFO *chset = adapter_to_chset(adapter);
+	int set_idx = rtw_chset_search_ch(chset, ch);
+
+	if (set_idx >= 0 && chset[set_idx].scan_bss_cnt < 0xFF)
+		chset[set_idx].scan_bss_cnt++;
+}
+
+/* fold result of this scan into history of visited channels */
+static void rtw_scan_hist_update(_adapter *adapter)
+{
+	RT_CHANNEL_INFO *chset = adapter_to_chset(adapter);
+	u8 cnt, load;
+	int i;
+
+	for (i = 0; i < MAX_CHANNEL_NUM && chset[i].ChannelNum != 0; i++) {
+		if (!chset[i].scan_visited)
+			continue;
+
+		cnt = rtw_min(chset[i].scan_bss_cnt, 31);
+		load = 0;
+#ifdef CONFIG_RTW_ACS
+		if (IS_ACS_ENABLE(adapter)) {
+			/* same interference measure as ACS channel selection */
+			load = rtw_min(rtw_acs_get_clm_ratio_by_ch_idx(adapter, i)
+				+ rtw_acs_get_num_ratio_by_ch_idx(adapter, i), 100);
+		}
+#endif
+
+		if (!chset[i].scan_hist_num) {
+			chset[i].scan_bss_avg = cnt << 3;
+			chset[i].scan_load = load;
+		} else {
+			chset[i].scan_bss_avg = (chset[i].scan_bss_avg * 3 + (cnt << 3)) >> 2;
+			chset[i].scan_load = (chset[i].scan_load * 3 + load) >> 2;
+		}
+
+		if (chset[i].scan_hist_num == 0xFF)
+			chset[i].scan_hist_num = RTW_SCAN_HIST_REFRESH;
+		else
+			chset[i].scan_hist_num++;
+	}
+}
+
 static int rtw_scan_ch_decision(_adapter *padapter, struct rtw_ieee80211_channel *out,
 		u32 out_num, struct rtw_ieee80211_channel *in, u32 in_num)
 {
@@ -14445,6 +15105,8 @@ static int rtw_scan_ch_decision(_adapter *padapter, struct rtw_ieee80211_channel
 		}
 	}
 
+	rtw_scan_ch_order(padapter, out, j);
+
 	/* scan_sparse */
 	j = rtw_scan_sparse(padapter, out, j);
 
@@ -14466,6 +15128,11 @@ static void sitesurvey_res_reset(_adapter *adapter, struct sitesurvey_parm *parm
 	ss->igi_before_scan = 0;
 #ifdef CONFIG_SCAN_BACKOP
 	ss->scan_cnt = 0;
+	ss->bg_scan = parm->bg_scan;
+	ss->bg_tl = SS_BG_TL_IDLE;
+	ss->offch_win_time = rtw_get_current_time();
+	ss->offch_win_ms = 0;
+	rtw_scan_slice_decision(adapter);
 #endif
 #if defined(CONFIG_ANTENNA_DIVERSITY) || defined(DBG_SCAN_SW_ANTDIV_BL)
 	ss->is_sw_antdiv_bl_scan = 0;
@@ -14489,6 +15156,10 @@ static void sitesurvey_res_reset(_adapter *adapter, struct sitesurvey_parm *parm
 	for (i = 0; i < MAX_CHANNEL_NUM; i++)
 		chset[i].hidden_bss_cnt = 0;
 #endif
+	for (i = 0; i < MAX_CHANNEL_NUM; i++) {
+		chset[i].scan_visited = 0;
+		chset[i].scan_bss_cnt = 0;
+	}
 
 	ss->bw = parm->bw;
 	ss->igi = parm->igi;
@@ -14546,7 +15217,7 @@ static u8 sitesurvey_pick_ch_behavior(_adapter *padapter, u8 *ch, RT_SCAN_TYPE *
 
 #ifdef CONFIG_DFS
 		#ifdef CONFIG_SCAN_BACKOP
-		if (!(backop_flags && ss->scan_cnt >= ss->scan_cnt_max))
+		if (!(backop_flags && ss->scan_cnt >= ss->slice_ch_num))
 		#endif
 		{
 			#ifdef CONFIG_RTW_WIFI_HAL
@@ -14591,7 +15262,7 @@ static u8 sitesurvey_pick_ch_behavior(_adapter *padapter, u8 *ch, RT_SCAN_TYPE *
 
 		#ifdef CONFIG_SCAN_BACKOP
 		if (backop_flags) {
-			if (ss->scan_cnt < ss->scan_cnt_max)
+			if (ss->scan_cnt < ss->slice_ch_num)
 				ss->scan_cnt++;
 			else {
 				mlmeext_assign_scan_backop_flags(pmlmeext, backop_flags);
@@ -14821,6 +15492,7 @@ u8 rtw_ps_annc(_adapter *adapter, bool ps)
 					set_channel_bwmode(iface, ch, offset, bw);
 				}
 				#endif /* CONFIG_MCC_MODE */
+				/* must be acked before leaving channel, and PS=1/PS=0 kept in order */
 				issue_nulldata(iface, NULL, ps, 3, 500);
 				ps_anc = 1;
 			}
@@ -15105,6 +15777,9 @@ operation_by_state:
 		val8 = 1; /* under site survey */
 		rtw_hal_set_hwreg(padapter, HW_VAR_MLME_SITESURVEY, (u8 *)(&val8));
 
+#ifdef CONFIG_SCAN_BACKOP
+		rtw_scan_offch_start(padapter);
+#endif
 		mlmeext_set_scan_state(pmlmeext, SCAN_PROCESS);
 		goto operation_by_state;
 
@@ -15173,6 +15848,8 @@ operation_by_state:
 			scan_ms = ss->scan_ch_ms;
 #endif
 
+		scan_ms = rtw_scan_ch_dwell(padapter, scan_ch, scan_ms);
+
 #if defined(CONFIG_ANTENNA_DIVERSITY) || defined(DBG_SCAN_SW_ANTDIV_BL)
 		if (ss->is_sw_antdiv_bl_scan)
 			scan_ms = scan_ms / 2;
@@ -15219,6 +15896,7 @@ operation_by_state:
 				);
 		#endif /*DBG_SITESURVEY*/
 		set_channel_bwmode(padapter, back_ch, back_ch_offset, back_bw);
+		rtw_scan_offch_end(padapter);
 
 		sitesurvey_set_msr(padapter, _FALSE);
 
@@ -15233,6 +15911,8 @@ operation_by_state:
 
 		mlmeext_set_scan_state(pmlmeext, SCAN_BACK_OP);
 		ss->backop_time = rtw_get_current_time();
+		/* follow live traffic for next slice */
+		rtw_scan_slice_decision(padapter);
 
 		if (mlmeext_chk_scan_backop_flags(pmlmeext, SS_BACKOP_TX_RESUME))
 			rtw_mi_os_xmit_schedule(padapter);
@@ -15242,12 +15922,17 @@ operation_by_state:
 	}
 
 	case SCAN_BACK_OP:
-		if (rtw_get_passing_time_ms(ss->backop_time) >= ss->backop_ms
-		    || pmlmeext->scan_abort
-		   ) {
+		if (pmlmeext->scan_abort) {
 			mlmeext_set_scan_state(pmlmeext, SCAN_LEAVING_OP);
 			goto operation_by_state;
 		}
+		if (rtw_get_passing_time_ms(ss->backop_time) >= ss->slice_backop_ms) {
+			if (rtw_scan_offch_budget_chk(padapter)) {
+				mlmeext_set_scan_state(pmlmeext, SCAN_LEAVING_OP);
+				goto operation_by_state;
+			}
+			ss->bg_defer_cnt++;
+		}
 		set_survey_timer(pmlmeext, 50);
 		break;
 
@@ -15286,6 +15971,7 @@ operation_by_state:
 		val8 = 1; /* under site survey */
 		rtw_hal_set_hwreg(padapter, HW_VAR_MLME_SITESURVEY, (u8 *)(&val8));
 
+		rtw_scan_offch_start(padapter);
 		mlmeext_set_scan_state(pmlmeext, SCAN_PROCESS);
 		goto operation_by_state;
 
@@ -15378,6 +16064,10 @@ operation_by_state:
 
 		mlmeext_set_scan_state(pmlmeext, SCAN_DISABLE);
 
+		rtw_scan_hist_update(padapter);
+#ifdef CONFIG_SCAN_BACKOP
+		ss->bg_scan = 0;
+#endif
 		report_surveydone_event(padapter);
 #ifdef CONFIG_RTW_ACS
 		if (IS_ACS_ENABLE(padapter))
@@ -15685,18 +16375,30 @@ u8 add_ba_rsp_hdl(_adapter *padapter, unsigned char *pbuf)
 	struct recv_reorder_ctrl *preorder_ctrl;
 	struct sta_priv *pstapriv = &padapter->stapriv;
 	struct sta_info *psta;
-	u8 ret = _TRUE;
+	u16 status = pparm->status;
 
 	psta = rtw_get_stainfo(pstapriv, pparm->addr);
 	if (!psta)
 		goto exit;
 
-	preorder_ctrl = &psta->recvreorder_ctrl[pparm->tid];
-	ret = issue_addba_rsp_wait_ack(padapter, pparm->addr, pparm->tid, pparm->status, pparm->size, 3, 50);
+	/* reordering ctrl is only needed when this addba req is accepted */
+	if (status == 0)
+		preorder_ctrl = rtw_alloc_reorder_ctrl(psta, pparm->tid);
+	else
+		preorder_ctrl = psta->recvreorder_ctrl[pparm->tid];
+
+	if (status == 0 && !preorder_ctrl)
+		status = 37;
+
+	/* the result is not used, don't hold cmd thread for the ack */
+	issue_addba_rsp_async(padapter, pparm->addr, pparm->tid, status, pparm->size, 3, NULL, NULL);
+
+	if (!preorder_ctrl)
+		goto exit;
 
 #ifdef CONFIG_UPDATE_INDICATE_SEQ_WHILE_PROCESS_ADDBA_REQ
 	/* status = 0 means accept this addba req, so update indicate seq = start_seq under this compile flag */
-	if (pparm->status == 0) {
+	if (status == 0) {
 		preorder_ctrl->indicate_seq = pparm->start_seq;
 		#ifdef DBG_RX_SEQ
 		RTW_INFO("DBG_RX_SEQ "FUNC_ADPT_FMT" tid:%u SN_UPDATE indicate_seq:%d, start_seq:%d\n"
@@ -15715,10 +16417,10 @@ u8 add_ba_rsp_hdl(_adapter *padapter, unsigned char *pbuf)
 	  * status = 0 means accept this addba req
 	  * status = 37 means reject this addba req
 	  */
-	if (pparm->status == 0) {
+	if (status == 0) {
 		preorder_ctrl->enable = _TRUE;
 		preorder_ctrl->ampdu_size = pparm->size;
-	} else if (pparm->status == 37)
+	} else if (status == 37)
 		preorder_ctrl->enable = _FALSE;
 
 exit:
@@ -15892,7 +16594,7 @@ u8 chk_bmc_sleepq_hdl(_adapter *padapter, unsigned char *pbuf)
 
 			rtw_list_delete(&pxmitframe->list);
 
-			psta_bmc->sleepq_len--;
+			rtw_sleepq_frame_out(psta_bmc, pxmitframe);
 			if (psta_bmc->sleepq_len > 0)
 				pxmitframe->attrib.mdata = 1;
 			else
@@ -44,6 +44,7 @@ static u32 go_add_group_info_attr(struct wifidirect_info *pwdinfo, u8 *pbuf)
 	u16 attr_len = 0;
 	u8 tmplen, *pdata_attr, *pstart, *pcur;
 	struct sta_info *psta = NULL;
+	struct sta_cold_info *cold;
 	_adapter *padapter = pwdinfo->padapter;
 	struct sta_priv *pstapriv = &padapter->stapriv;
 
@@ -70,46 +71,47 @@ static u32 go_add_group_info_attr(struct wifidirect_info *pwdinfo, u8 *pbuf)
 		plist = get_next(plist);
 
 
-		if (psta->is_p2p_device) {
+		if (psta->is_p2p_device && psta->cold) {
+			cold = psta->cold;
 			tmplen = 0;
 
 			pcur++;
 
 			/* P2P device address */
-			_rtw_memcpy(pcur, psta->dev_addr, ETH_ALEN);
+			_rtw_memcpy(pcur, cold->dev_addr, ETH_ALEN);
 			pcur += ETH_ALEN;
 
 			/* P2P interface address */
 			_rtw_memcpy(pcur, psta->cmn.mac_addr, ETH_ALEN);
 			pcur += ETH_ALEN;
 
-			*pcur = psta->dev_cap;
+			*pcur = cold->dev_cap;
 			pcur++;
 
 			/* *(u16*)(pcur) = cpu_to_be16(psta->config_methods); */
-			RTW_PUT_BE16(pcur, psta->config_methods);
+			RTW_PUT_BE16(pcur, cold->config_methods);
 			pcur += 2;
 
-			_rtw_memcpy(pcur, psta->primary_dev_type, 8);
+			_rtw_memcpy(pcur, cold->primary_dev_type, 8);
 			pcur += 8;
 
-			*pcur = psta->num_of_secdev_type;
+			*pcur = cold->num_of_secdev_type;
 			pcur++;
 
-			_rtw_memcpy(pcur, psta->secdev_types_list, psta->num_of_secdev_type * 8);
-			pcur += psta->num_of_secdev_type * 8;
+			_rtw_memcpy(pcur, cold->secdev_types_list, cold->num_of_secdev_type * 8);
+			pcur += cold->num_of_secdev_type * 8;
 
-			if (psta->dev_name_len > 0) {
+			if (cold->dev_name_len > 0) {
 				/* *(u16*)(pcur) = cpu_to_be16( WPS_ATTR_DEVICE_NAME ); */
 				RTW_PUT_BE16(pcur, WPS_ATTR_DEVICE_NAME);
 				pcur += 2;
 
 				/* *(u16*)(pcur) = cpu_to_be16( psta->dev_name_len ); */
-				RTW_PUT_BE16(pcur, psta->dev_name_len);
+				RTW_PUT_BE16(pcur, cold->dev_name_len);
 				pcur += 2;
 
-				_rtw_memcpy(pcur, psta->dev_name, psta->dev_name_len);
-				pcur += psta->dev_name_len;
+				_rtw_memcpy(pcur, cold->dev_name, cold->dev_name_len);
+				pcur += cold->dev_name_len;
 			}
 
 
@@ -2318,6 +2320,7 @@ u32 process_probe_req_p2p_ie(struct wifidirect_info *pwdinfo, u8 *pframe, uint l
 u32 process_assoc_req_p2p_ie(struct wifidirect_info *pwdinfo, u8 *pframe, uint len, struct sta_info *psta)
 {
 	u8 status_code = P2P_STATUS_SUCCESS;
+	struct sta_cold_info *cold;
 	u8 *pbuf, *pattr_content = NULL;
 	u32 attr_contentlen = 0;
 	u16 cap_attr = 0;
@@ -2330,6 +2333,11 @@ u32 process_assoc_req_p2p_ie(struct wifidirect_info *pwdinfo, u8 *pframe, uint l
 	if (!rtw_p2p_chk_role(pwdinfo, P2P_ROLE_GO))
 		return P2P_STATUS_FAIL_REQUEST_UNABLE;
 
+	/* P2P client info is kept in cold block */
+	cold = rtw_sta_cold_get(psta);
+	if (!cold)
+		return P2P_STATUS_FAIL_REQUEST_UNABLE;
+
 	frame_type = get_frame_sub_type(pframe);
 	if (frame_type == WIFI_ASSOCREQ)
 		ie_offset = _ASOCREQ_IE_OFFSET_;
@@ -2352,7 +2360,7 @@ u32 process_assoc_req_p2p_ie(struct wifidirect_info *pwdinfo, u8 *pframe, uint l
 		if (rtw_get_p2p_attr_content(p2p_ie, p2p_ielen, P2P_ATTR_CAPABILITY, (u8 *)&cap_attr, (uint *) &attr_contentlen)) {
 			RTW_INFO("[%s] Got P2P Capability Attr!!\n", __FUNCTION__);
 			cap_attr = le16_to_cpu(cap_attr);
-			psta->dev_cap = cap_attr & 0xff;
+			cold->dev_cap = cap_attr & 0xff;
 		}
 
 		/* Check Extended Listen Timing ATTR */
@@ -2369,16 +2377,16 @@ u32 process_assoc_req_p2p_ie(struct wifidirect_info *pwdinfo, u8 *pframe, uint l
 
 				rtw_get_p2p_attr_content(p2p_ie, p2p_ielen, P2P_ATTR_DEVICE_INFO , pattr_content, (uint *)&attr_contentlen);
 
-				_rtw_memcpy(psta->dev_addr, 	pattr_content, ETH_ALEN);/* P2P Device Address */
+				_rtw_memcpy(cold->dev_addr, 	pattr_content, ETH_ALEN);/* P2P Device Address */
 
 				pattr_content += ETH_ALEN;
 
-				_rtw_memcpy(&psta->config_methods, pattr_content, 2);/* Config Methods */
-				psta->config_methods = be16_to_cpu(psta->config_methods);
+				_rtw_memcpy(&cold->config_methods, pattr_content, 2);/* Config Methods */
+				cold->config_methods = be16_to_cpu(cold->config_methods);
 
 				pattr_content += 2;
 
-				_rtw_memcpy(psta->primary_dev_type, pattr_content, 8);
+				_rtw_memcpy(cold->primary_dev_type, pattr_content, 8);
 
 				pattr_content += 8;
 
@@ -2386,28 +2394,28 @@ u32 process_assoc_req_p2p_ie(struct wifidirect_info *pwdinfo, u8 *pframe, uint l
 				pattr_content += 1;
 
 				if (num_of_secdev_type == 0)
-					psta->num_of_secdev_type = 0;
+					cold->num_of_secdev_type = 0;
 				else {
 					u32 len;
 
-					psta->num_of_secdev_type = num_of_secdev_type;
+					cold->num_of_secdev_type = num_of_secdev_type;
 
-					len = (sizeof(psta->secdev_types_list) < (num_of_secdev_type * 8)) ? (sizeof(psta->secdev_types_list)) : (num_of_secdev_type * 8);
+					len = (sizeof(cold->secdev_types_list) < (num_of_secdev_type * 8)) ? (sizeof(cold->secdev_types_list)) : (num_of_secdev_type * 8);
 
-					_rtw_memcpy(psta->secdev_types_list, pattr_content, len);
+					_rtw_memcpy(cold->secdev_types_list, pattr_content, len);
 
 					pattr_content += (num_of_secdev_type * 8);
 				}
 
 
 				/* dev_name_len = attr_contentlen - ETH_ALEN - 2 - 8 - 1 - (num_of_secdev_type*8); */
-				psta->dev_name_len = 0;
+				cold->dev_name_len = 0;
 				if (WPS_ATTR_DEVICE_NAME == be16_to_cpu(*(u16 *)pattr_content)) {
 					dev_name_len = be16_to_cpu(*(u16 *)(pattr_content + 2));
 
-					psta->dev_name_len = (sizeof(psta->dev_name) < dev_name_len) ? sizeof(psta->dev_name) : dev_name_len;
+					cold->dev_name_len = (sizeof(cold->dev_name) < dev_name_len) ? sizeof(cold->dev_name) : dev_name_len;
 
-					_rtw_memcpy(psta->dev_name, pattr_content + 4, psta->dev_name_len);
+					_rtw_memcpy(cold->dev_name, pattr_content + 4, cold->dev_name_len);
 				}
 
 				rtw_mfree(pbuf, attr_contentlen);
@@ -2464,8 +2472,9 @@ u32 process_p2p_devdisc_req(struct wifidirect_info *pwdinfo, u8 *pframe, uint le
 
 						plist = get_next(plist);
 
-						if (psta->is_p2p_device && (psta->dev_cap & P2P_DEVCAP_CLIENT_DISCOVERABILITY) &&
-						    _rtw_memcmp(psta->dev_addr, dev_addr, ETH_ALEN)) {
+						if (psta->is_p2p_device && psta->cold
+						    && (psta->cold->dev_cap & P2P_DEVCAP_CLIENT_DISCOVERABILITY)
+						    && _rtw_memcmp(psta->cold->dev_addr, dev_addr, ETH_ALEN)) {
 
 							/* _exit_critical_bh(&pstapriv->asoc_list_lock, &irqL); */
 							/* issue GO Discoverability Request */
@@ -1633,7 +1633,7 @@ sint validate_recv_ctrl_frame(_adapter *padapter, union recv_frame *precv_frame)
 
 		if (psta->state & WIFI_STA_ALIVE_CHK_STATE) {
 			RTW_INFO("%s alive check-rx ps-poll\n", __func__);
-			psta->expire_to = pstapriv->expire_to;
+			rtw_sta_expire_arm(pstapriv, psta, pstapriv->expire_to);
 			psta->state ^= WIFI_STA_ALIVE_CHK_STATE;
 		}
 
@@ -1656,7 +1656,7 @@ sint validate_recv_ctrl_frame(_adapter *padapter, union recv_frame *precv_frame)
 
 				rtw_list_delete(&pxmitframe->list);
 
-				psta->sleepq_len--;
+				rtw_sleepq_frame_out(psta, pxmitframe);
 
 				if (psta->sleepq_len > 0)
 					pxmitframe->attrib.mdata = 1;
@@ -1704,6 +1704,7 @@ sint validate_recv_ctrl_frame(_adapter *padapter, union recv_frame *precv_frame)
 					} else {
 						RTW_INFO("error!psta->sleepq_len=%d\n", psta->sleepq_len);
 						psta->sleepq_len = 0;
+						psta->sleepq_bytes = 0;
 					}
 
 					rtw_tim_map_clear(padapter, pstapriv->tim_bitmap, psta->cmn.aid);
@@ -2163,7 +2164,7 @@ pre_validate_status_chk:
 	if (!IS_MCAST(pattrib->ra)) {
 
 		if (pattrib->qos)
-			precv_frame->u.hdr.preorder_ctrl = &psta->recvreorder_ctrl[pattrib->priority];
+			precv_frame->u.hdr.preorder_ctrl = psta->recvreorder_ctrl[pattrib->priority];
 
 		if (recv_ucast_pn_decache(precv_frame) == _FAIL) {
 			#ifdef DBG_RX_DROP_FRAME
@@ -3617,6 +3618,26 @@ void rtw_reordering_ctrl_timeout_handler(void *pcontext)
 	_exit_critical_bh(&ppending_recvframe_queue->lock, &irql);
 
 }
+
+/*
+* Indicate all frames held by the reordering buffer in sequence order, holes are
+* skipped as on reordering timeout. Used before the buffer control is detached.
+*/
+void rtw_reorder_ctrl_indicate_all(struct recv_reorder_ctrl *preorder_ctrl)
+{
+	_irqL irql;
+	_adapter *padapter = preorder_ctrl->padapter;
+	_queue *ppending_recvframe_queue = &preorder_ctrl->pending_recvframe_queue;
+
+	_enter_critical_bh(&ppending_recvframe_queue->lock, &irql);
+
+	preorder_ctrl->bReorderWaiting = _FALSE;
+
+	while (!rtw_is_list_empty(get_list_head(ppending_recvframe_queue)))
+		recv_indicatepkts_in_order(padapter, preorder_ctrl, _TRUE);
+
+	_exit_critical_bh(&ppending_recvframe_queue->lock, &irql);
+}
 #endif /* defined(CONFIG_80211N_HT) && defined(CONFIG_RECV_REORDERING_CTRL) */
 
 static void recv_set_iseq_before_mpdu_process(union recv_frame *rframe, u16 seq_num, const char *caller)
@@ -1125,6 +1125,41 @@ inline void rtw_txpwr_lmt_add(struct rf_ctl_t *rfctl, const char *regd_name
 		, band, bw, tlrs, ntx_idx, ch_idx, lmt);
 }
 
+/* add an entry with all its limit values given, for loading binary form of limit table */
+void rtw_txpwr_lmt_ent_add_with_nlen(struct rf_ctl_t *rfctl, const char *regd_name, u32 nlen
+	, const s8 *lmt_2g, const s8 *lmt_5g)
+{
+	struct txpwr_lmt_ent *ent;
+	_irqL irqL;
+
+	if (!regd_name || !nlen || !lmt_2g) {
+		rtw_warn_on(1);
+		goto exit;
+	}
+
+	ent = (struct txpwr_lmt_ent *)rtw_zvmalloc(sizeof(struct txpwr_lmt_ent) + nlen + 1);
+	if (!ent)
+		goto exit;
+
+	_rtw_init_listhead(&ent->list);
+	_rtw_memcpy(ent->regd_name, regd_name, nlen);
+	_rtw_memcpy(ent->lmt_2g, lmt_2g, sizeof(ent->lmt_2g));
+	#ifdef CONFIG_IEEE80211_BAND_5GHZ
+	if (lmt_5g)
+		_rtw_memcpy(ent->lmt_5g, lmt_5g, sizeof(ent->lmt_5g));
+	#endif
+
+	_enter_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
+
+	rtw_list_insert_tail(&ent->list, &rfctl->txpwr_lmt_list);
+	rfctl->txpwr_regd_num++;
+
+	_exit_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
+
+exit:
+	return;
+}
+
 struct txpwr_lmt_ent *_rtw_txpwr_lmt_get_by_name(struct rf_ctl_t *rfctl, const char *regd_name)
 {
 	struct txpwr_lmt_ent *ent;
@@ -220,6 +220,20 @@ static u32 getcrc32(u8 *buf, sint len)
 	return ~crc;    /* transmit complement, per CRC-32 spec */
 }
 
+/*
+* rtw_crc32_update - continue CRC-32 over buf
+* preload crc with 0xffffffff and complement the final value, as getcrc32()
+*/
+u32 rtw_crc32_update(u32 crc, const u8 *buf, sint len)
+{
+	if (bcrc32initialized == 0)
+		crc32_init();
+
+	for (; len > 0; ++buf, --len)
+		crc = crc32_table[(crc ^ *buf) & 0xff] ^ (crc >> 8);
+	return crc;
+}
+
 
 /*
 	Need to consider the fragment  situation
@@ -210,6 +210,7 @@ void _rtw_init_stainfo(struct sta_info *psta)
 #ifdef CONFIG_AP_MODE
 	_rtw_init_listhead(&psta->asoc_list);
 	_rtw_init_listhead(&psta->auth_list);
+	_rtw_init_listhead(&psta->expire_list);
 	psta->bpairwise_key_installed = _FALSE;
 
 #ifdef CONFIG_RTW_80211R
@@ -240,11 +241,17 @@ u32	_rtw_init_sta_priv(struct	sta_priv *pstapriv)
 	_rtw_init_queue(&pstapriv->free_sta_queue);
 
 	_rtw_spinlock_init(&pstapriv->sta_hash_lock);
+	_rtw_init_queue(&pstapriv->free_reorder_ctrl_queue);
+	ATOMIC_SET(&pstapriv->reorder_ctrl_cnt, 0);
+	ATOMIC_SET(&pstapriv->cold_cnt, 0);
 
 	/* _rtw_init_queue(&pstapriv->asoc_q); */
 	pstapriv->asoc_sta_count = 0;
 	_rtw_init_queue(&pstapriv->sleep_q);
 	_rtw_init_queue(&pstapriv->wakeup_q);
+	pstapriv->sleepq_max_len = rtw_min(adapter->registrypriv.ps_sleepq_max_len, NR_XMITFRAME / 2);
+	pstapriv->sleepq_max_bytes = adapter->registrypriv.ps_sleepq_max_bytes;
+	pstapriv->sleepq_ovf_drop = 0;
 
 	psta = (struct sta_info *)(pstapriv->pstainfo_buf);
 
@@ -265,6 +272,9 @@ u32	_rtw_init_sta_priv(struct	sta_priv *pstapriv)
 	pstapriv->max_aid = macid_ctl->num;
 	pstapriv->rr_aid = 0;
 	pstapriv->started_aid = 1;
+	_rtw_spinlock_init(&pstapriv->aid_lock);
+	_rtw_memset(pstapriv->aid_map, 0, sizeof(pstapriv->aid_map));
+	pstapriv->aid_used_cnt = 0;
 	pstapriv->sta_aid = rtw_zmalloc(pstapriv->max_aid * sizeof(struct sta_info *));
 	if (!pstapriv->sta_aid)
 		goto exit;
@@ -283,6 +293,11 @@ u32	_rtw_init_sta_priv(struct	sta_priv *pstapriv)
 	pstapriv->asoc_list_cnt = 0;
 	pstapriv->auth_list_cnt = 0;
 
+	for (i = 0; i < STA_EXPIRE_WHEEL_SIZE; i++)
+		_rtw_init_listhead(&pstapriv->expire_wheel[i]);
+	_rtw_spinlock_init(&pstapriv->expire_wheel_lock);
+	pstapriv->expire_tick = 0;
+
 	pstapriv->auth_to = 3; /* 3*2 = 6 sec */
 	pstapriv->assoc_to = 3;
 	/* pstapriv->expire_to = 900; */ /* 900*2 = 1800 sec = 30 min, expire after no any traffic. */
@@ -418,16 +433,20 @@ void rtw_mfree_sta_priv_lock(struct	sta_priv *pstapriv)
 #ifdef CONFIG_AP_MODE
 	_rtw_spinlock_free(&pstapriv->asoc_list_lock);
 	_rtw_spinlock_free(&pstapriv->auth_list_lock);
+	_rtw_spinlock_free(&pstapriv->expire_wheel_lock);
+	_rtw_spinlock_free(&pstapriv->aid_lock);
 #endif
 
 }
 
+static void rtw_reorder_ctrl_pool_deinit(struct sta_priv *pstapriv);
+static void rtw_sta_cold_free(struct sta_info *psta);
+
 u32	_rtw_free_sta_priv(struct	sta_priv *pstapriv)
 {
 	_irqL	irqL;
 	_list	*phead, *plist;
 	struct sta_info *psta = NULL;
-	struct recv_reorder_ctrl *preorder_ctrl;
 	int	index;
 
 	if (pstapriv) {
@@ -443,15 +462,17 @@ u32	_rtw_free_sta_priv(struct	sta_priv *pstapriv)
 				psta = LIST_CONTAINOR(plist, struct sta_info , hash_list);
 				plist = get_next(plist);
 
-				for (i = 0; i < 16 ; i++) {
-					preorder_ctrl = &psta->recvreorder_ctrl[i];
-					_cancel_timer_ex(&preorder_ctrl->reordering_ctrl_timer);
-				}
+				for (i = 0; i < TID_NUM; i++)
+					rtw_free_reorder_ctrl(psta, i);
+				rtw_sta_cold_free(psta);
 			}
 		}
 		_exit_critical_bh(&pstapriv->sta_hash_lock, &irqL);
 		/*===============================*/
 
+		rtw_reorder_ctrl_pool_deinit(pstapriv);
+		_rtw_spinlock_free(&pstapriv->free_reorder_ctrl_queue.lock);
+
 		rtw_mfree_sta_priv_lock(pstapriv);
 
 #if CONFIG_RTW_MACADDR_ACL
@@ -488,6 +509,242 @@ static void rtw_init_recv_timer(struct recv_reorder_ctrl *preorder_ctrl)
 #endif
 }
 
+static void rtw_flush_reorder_ctrl(struct recv_reorder_ctrl *preorder_ctrl)
+{
+	_queue *pfree_recv_queue = &preorder_ctrl->padapter->recvpriv.free_recv_queue;
+	_queue *ppending_recvframe_queue = &preorder_ctrl->pending_recvframe_queue;
+	union recv_frame *prframe;
+	_list *phead, *plist;
+	_irqL irqL;
+
+	_cancel_timer_ex(&preorder_ctrl->reordering_ctrl_timer);
+
+	_enter_critical_bh(&ppending_recvframe_queue->lock, &irqL);
+
+	phead =	get_list_head(ppending_recvframe_queue);
+	plist = get_next(phead);
+
+	while (!rtw_is_list_empty(phead)) {
+		prframe = LIST_CONTAINOR(plist, union recv_frame, u);
+
+		plist = get_next(plist);
+
+		rtw_list_delete(&(prframe->u.hdr.list));
+
+		rtw_free_recvframe(prframe, pfree_recv_queue);
+	}
+
+	_exit_critical_bh(&ppending_recvframe_queue->lock, &irqL);
+}
+
+/*
+* A-MPDU Rx reordering buffer control of TID is attached to the STA when ADDBA
+* request is accepted, and detached on DELBA or when the STA is freed.
+* RX path and reordering timer reference it without lock, so a detached one is
+* only returned to sta_priv.free_reorder_ctrl_queue for reuse, memory is freed
+* by rtw_reorder_ctrl_pool_deinit() at driver unload when RX has stopped.
+*/
+struct recv_reorder_ctrl *rtw_alloc_reorder_ctrl(struct sta_info *psta, u8 tid)
+{
+	_adapter *padapter = psta->padapter;
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	_queue *pool = &pstapriv->free_reorder_ctrl_queue;
+	struct recv_reorder_ctrl *preorder_ctrl = NULL;
+	_irqL irqL;
+
+	if (tid >= TID_NUM)
+		return NULL;
+
+	if (psta->recvreorder_ctrl[tid])
+		return psta->recvreorder_ctrl[tid];
+
+	_enter_critical_bh(&pool->lock, &irqL);
+	if (!rtw_is_list_empty(get_list_head(pool))) {
+		preorder_ctrl = LIST_CONTAINOR(get_next(get_list_head(pool)), struct recv_reorder_ctrl, list);
+		rtw_list_delete(&preorder_ctrl->list);
+	}
+	_exit_critical_bh(&pool->lock, &irqL);
+
+	if (preorder_ctrl) {
+		/* a stale RX reference may have used it after detached */
+		rtw_flush_reorder_ctrl(preorder_ctrl);
+	} else {
+		preorder_ctrl = (struct recv_reorder_ctrl *)rtw_zmalloc(sizeof(struct recv_reorder_ctrl));
+		if (!preorder_ctrl) {
+			RTW_WARN(FUNC_ADPT_FMT" sta:"MAC_FMT" tid:%u alloc fail\n"
+				, FUNC_ADPT_ARG(padapter), MAC_ARG(psta->cmn.mac_addr), tid);
+			return NULL;
+		}
+
+		preorder_ctrl->padapter = padapter;
+		_rtw_init_listhead(&preorder_ctrl->list);
+		_rtw_init_queue(&preorder_ctrl->pending_recvframe_queue);
+		rtw_init_recv_timer(preorder_ctrl);
+		ATOMIC_INC(&pstapriv->reorder_ctrl_cnt);
+	}
+
+	preorder_ctrl->tid = tid;
+	preorder_ctrl->enable = _FALSE;
+	preorder_ctrl->indicate_seq = 0xffff;
+	#ifdef DBG_RX_SEQ
+	RTW_INFO("DBG_RX_SEQ "FUNC_ADPT_FMT" tid:%u SN_CLEAR indicate_seq:%d\n"
+		, FUNC_ADPT_ARG(padapter), tid, preorder_ctrl->indicate_seq);
+	#endif
+	preorder_ctrl->wend_b = 0xffff;
+	/* preorder_ctrl->wsize_b = (NR_RECVBUFF-2); */
+	preorder_ctrl->wsize_b = 64;/* 64; */
+	preorder_ctrl->ampdu_size = RX_AMPDU_SIZE_INVALID;
+	preorder_ctrl->bReorderWaiting = _FALSE;
+
+	/* make sure RX path sees an initialized one */
+	rtw_wmb();
+	psta->recvreorder_ctrl[tid] = preorder_ctrl;
+
+	return preorder_ctrl;
+}
+
+void rtw_free_reorder_ctrl(struct sta_info *psta, u8 tid)
+{
+	_queue *pool = &psta->padapter->stapriv.free_reorder_ctrl_queue;
+	struct recv_reorder_ctrl *preorder_ctrl = psta->recvreorder_ctrl[tid];
+	_irqL irqL;
+
+	if (!preorder_ctrl)
+		return;
+
+	psta->recvreorder_ctrl[tid] = NULL;
+
+	rtw_flush_reorder_ctrl(preorder_ctrl);
+
+	_enter_critical_bh(&pool->lock, &irqL);
+	rtw_list_insert_tail(&preorder_ctrl->list, get_list_head(pool));
+	_exit_critical_bh(&pool->lock, &irqL);
+}
+
+/* called at driver unload, after all STAs have detached their reorder ctrls */
+static void rtw_reorder_ctrl_pool_deinit(struct sta_priv *pstapriv)
+{
+	_queue *pool = &pstapriv->free_reorder_ctrl_queue;
+	struct recv_reorder_ctrl *preorder_ctrl;
+	_irqL irqL;
+
+	_enter_critical_bh(&pool->lock, &irqL);
+	while (!rtw_is_list_empty(get_list_head(pool))) {
+		preorder_ctrl = LIST_CONTAINOR(get_next(get_list_head(pool)), struct recv_reorder_ctrl, list);
+		rtw_list_delete(&preorder_ctrl->list);
+		_exit_critical_bh(&pool->lock, &irqL);
+
+		rtw_flush_reorder_ctrl(preorder_ctrl);
+		_rtw_spinlock_free(&preorder_ctrl->pending_recvframe_queue.lock);
+		rtw_mfree(preorder_ctrl, sizeof(struct recv_reorder_ctrl));
+		ATOMIC_DEC(&pstapriv->reorder_ctrl_cnt);
+
+		_enter_critical_bh(&pool->lock, &irqL);
+	}
+	_exit_critical_bh(&pool->lock, &irqL);
+}
+
+struct sta_cold_info *rtw_sta_cold_get(struct sta_info *psta)
+{
+	if (!psta->cold) {
+		psta->cold = (struct sta_cold_info *)rtw_zmalloc(sizeof(struct sta_cold_info));
+		if (psta->cold)
+			ATOMIC_INC(&psta->padapter->stapriv.cold_cnt);
+	}
+
+	return psta->cold;
+}
+
+static void rtw_sta_cold_free(struct sta_info *psta)
+{
+	if (psta->cold) {
+		rtw_mfree(psta->cold, sizeof(struct sta_cold_info));
+		psta->cold = NULL;
+		ATOMIC_DEC(&psta->padapter->stapriv.cold_cnt);
+	}
+}
+
+void dump_sta_mem(void *sel, _adapter *adapter)
+{
+	struct sta_priv *stapriv = &adapter->stapriv;
+	int reorder_cnt = ATOMIC_READ(&stapriv->reorder_ctrl_cnt);
+	int cold_cnt = ATOMIC_READ(&stapriv->cold_cnt);
+	u32 cold_sz = sizeof(struct sta_cold_info);
+
+	RTW_PRINT_SEL(sel, "sta_info:%u bytes * NUM_STA:%u = %u bytes\n"
+		, (u32)sizeof(struct sta_info), NUM_STA, (u32)(sizeof(struct sta_info) * NUM_STA));
+	RTW_PRINT_SEL(sel, "recv_reorder_ctrl:%u bytes * %d allocated = %u bytes (%u bytes * TID_NUM per STA if embedded)\n"
+		, (u32)sizeof(struct recv_reorder_ctrl), reorder_cnt
+		, (u32)(sizeof(struct recv_reorder_ctrl) * reorder_cnt), (u32)(sizeof(struct recv_reorder_ctrl) * TID_NUM));
+	RTW_PRINT_SEL(sel, "sta_cold_info:%u bytes * %d allocated = %u bytes\n"
+		, cold_sz, cold_cnt, cold_sz * cold_cnt);
+}
+
+#ifdef CONFIG_AP_MODE
+/*
+* Arm expire check of psta @ticks expire_timeout_chk() ticks later, 0 to disarm.
+* STA is put in the wheel slot of its deadline tick, lock order: asoc/auth list lock -> expire_wheel_lock
+*/
+void rtw_sta_expire_arm(struct sta_priv *pstapriv, struct sta_info *psta, u32 ticks)
+{
+	_irqL irqL;
+
+	_enter_critical_bh(&pstapriv->expire_wheel_lock, &irqL);
+
+	psta->expire_to = ticks;
+	rtw_list_delete(&psta->expire_list);
+	if (ticks) {
+		psta->expire_tick = pstapriv->expire_tick + ticks;
+		rtw_list_insert_tail(&psta->expire_list
+			, &pstapriv->expire_wheel[psta->expire_tick & (STA_EXPIRE_WHEEL_SIZE - 1)]);
+	}
+
+	_exit_critical_bh(&pstapriv->expire_wheel_lock, &irqL);
+}
+
+/*
+* Advance expire tick and take STAs whose deadline is reached out of the wheel
+* @list: to fill stainfo offset of due STAs, NUM_STA entries
+* return number of due STAs
+*/
+u8 rtw_sta_expire_tick(struct sta_priv *pstapriv, char *list)
+{
+	_irqL irqL;
+	_list *phead, *plist;
+	struct sta_info *psta;
+	int stainfo_offset;
+	u8 num = 0;
+
+	_enter_critical_bh(&pstapriv->expire_wheel_lock, &irqL);
+
+	pstapriv->expire_tick++;
+	phead = &pstapriv->expire_wheel[pstapriv->expire_tick & (STA_EXPIRE_WHEEL_SIZE - 1)];
+	plist = get_next(phead);
+
+	while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
+		psta = LIST_CONTAINOR(plist, struct sta_info, expire_list);
+		plist = get_next(plist);
+
+		/* armed for a later round of the wheel */
+		if (psta->expire_tick != pstapriv->expire_tick)
+			continue;
+
+		rtw_list_delete(&psta->expire_list);
+		psta->expire_to = 0;
+
+		stainfo_offset = rtw_stainfo_offset(pstapriv, psta);
+		if (stainfo_offset_valid(stainfo_offset))
+			list[num++] = stainfo_offset;
+	}
+
+	pstapriv->expire_due_cnt += num;
+
+	_exit_critical_bh(&pstapriv->expire_wheel_lock, &irqL);
+
+	return num;
+}
+#endif /* CONFIG_AP_MODE */
+
 /* struct	sta_info *rtw_alloc_stainfo(_queue *pfree_sta_queue, unsigned char *hwaddr) */
 struct	sta_info *rtw_alloc_stainfo(struct	sta_priv *pstapriv, const u8 *hwaddr)
 {
@@ -496,7 +753,6 @@ struct	sta_info *rtw_alloc_stainfo(struct	sta_priv *pstapriv, const u8 *hwaddr)
 	_list	*phash_list;
 	struct sta_info	*psta;
 	_queue *pfree_sta_queue;
-	struct recv_reorder_ctrl *preorder_ctrl;
 	int i = 0;
 	u16  wRxSeqInitialValue = 0xffff;
 
@@ -557,26 +813,7 @@ struct	sta_info *rtw_alloc_stainfo(struct	sta_priv *pstapriv, const u8 *hwaddr)
 		rtw_init_tdls_timer(pstapriv->padapter, psta);
 #endif /* CONFIG_TDLS */
 
-		/* for A-MPDU Rx reordering buffer control */
-		for (i = 0; i < 16 ; i++) {
-			preorder_ctrl = &psta->recvreorder_ctrl[i];
-			preorder_ctrl->padapter = pstapriv->padapter;
-			preorder_ctrl->tid = i;
-			preorder_ctrl->enable = _FALSE;
-			preorder_ctrl->indicate_seq = 0xffff;
-			#ifdef DBG_RX_SEQ
-			RTW_INFO("DBG_RX_SEQ "FUNC_ADPT_FMT" tid:%u SN_CLEAR indicate_seq:%d\n"
-				, FUNC_ADPT_ARG(pstapriv->padapter), i, preorder_ctrl->indicate_seq);
-			#endif
-			preorder_ctrl->wend_b = 0xffff;
-			/* preorder_ctrl->wsize_b = (NR_RECVBUFF-2); */
-			preorder_ctrl->wsize_b = 64;/* 64; */
-			preorder_ctrl->ampdu_size = RX_AMPDU_SIZE_INVALID;
-
-			_rtw_init_queue(&preorder_ctrl->pending_recvframe_queue);
-
-			rtw_init_recv_timer(preorder_ctrl);
-		}
+		/* A-MPDU Rx reordering buffer control is allocated by rtw_alloc_reorder_ctrl() when ADDBA is accepted */
 
 
 		/* init for DM */
@@ -612,7 +849,6 @@ u32	rtw_free_stainfo(_adapter *padapter , struct sta_info *psta)
 	int i;
 	_irqL irqL0;
 	_queue *pfree_sta_queue;
-	struct recv_reorder_ctrl *preorder_ctrl;
 	struct	sta_xmit_priv	*pstaxmitpriv;
 	struct	xmit_priv	*pxmitpriv = &padapter->xmitpriv;
 	struct	sta_priv *pstapriv = &padapter->stapriv;
@@ -661,6 +897,7 @@ u32	rtw_free_stainfo(_adapter *padapter , struct sta_info *psta)
 
 	rtw_free_xmitframe_queue(pxmitpriv, &psta->sleep_q);
 	psta->sleepq_len = 0;
+	psta->sleepq_bytes = 0;
 
 	/* vo */
 	/* _enter_critical_bh(&(pxmitpriv->vo_pending.lock), &irqL0); */
@@ -702,6 +939,10 @@ u32	rtw_free_stainfo(_adapter *padapter , struct sta_info *psta)
 	pstaxmitpriv->bk_q.qcnt = 0;
 	/* _exit_critical_bh(&(pxmitpriv->bk_pending.lock), &irqL0); */
 
+#ifdef CONFIG_TX_AMSDU
+	_rtw_memset(pstaxmitpriv->amsdu_ctl, 0, sizeof(pstaxmitpriv->amsdu_ctl));
+#endif
+
 	rtw_os_wake_queue_at_free_stainfo(padapter, pending_qcnt);
 
 	_exit_critical_bh(&pxmitpriv->lock, &irqL0);
@@ -719,39 +960,11 @@ u32	rtw_free_stainfo(_adapter *padapter , struct sta_info *psta)
 	psta->tdls_sta_state = TDLS_STATE_NONE;
 #endif /* CONFIG_TDLS */
 
-	/* for A-MPDU Rx reordering buffer control, cancel reordering_ctrl_timer */
-	for (i = 0; i < 16 ; i++) {
-		_irqL irqL;
-		_list	*phead, *plist;
-		union recv_frame *prframe;
-		_queue *ppending_recvframe_queue;
-		_queue *pfree_recv_queue = &padapter->recvpriv.free_recv_queue;
-
-		preorder_ctrl = &psta->recvreorder_ctrl[i];
-
-		_cancel_timer_ex(&preorder_ctrl->reordering_ctrl_timer);
-
-
-		ppending_recvframe_queue = &preorder_ctrl->pending_recvframe_queue;
-
-		_enter_critical_bh(&ppending_recvframe_queue->lock, &irqL);
-
-		phead =	get_list_head(ppending_recvframe_queue);
-		plist = get_next(phead);
-
-		while (!rtw_is_list_empty(phead)) {
-			prframe = LIST_CONTAINOR(plist, union recv_frame, u);
+	/* for A-MPDU Rx reordering buffer control, cancel reordering_ctrl_timer and free pending frames */
+	for (i = 0; i < TID_NUM; i++)
+		rtw_free_reorder_ctrl(psta, i);
 
-			plist = get_next(plist);
-
-			rtw_list_delete(&(prframe->u.hdr.list));
-
-			rtw_free_recvframe(prframe, pfree_recv_queue);
-		}
-
-		_exit_critical_bh(&ppending_recvframe_queue->lock, &irqL);
-
-	}
+	rtw_sta_cold_free(psta);
 
 	if (!((psta->state & WIFI_AP_STATE) || MacAddr_isBcst(psta->cmn.mac_addr)) && is_pre_link_sta == _FALSE)
 		rtw_hal_set_odm_var(padapter, HAL_ODM_STA_INFO, psta, _FALSE);
@@ -775,7 +988,7 @@ u32	rtw_free_stainfo(_adapter *padapter , struct sta_info *psta)
 	}
 	_exit_critical_bh(&pstapriv->auth_list_lock, &irqL0);
 
-	psta->expire_to = 0;
+	rtw_sta_expire_arm(pstapriv, psta, 0);
 #ifdef CONFIG_ATMEL_RC_PATCH
 	psta->flag_atmel_rc = 0;
 #endif
@@ -798,10 +1011,7 @@ u32	rtw_free_stainfo(_adapter *padapter , struct sta_info *psta)
 
 		/* rtw_indicate_sta_disassoc_event(padapter, psta); */
 
-		if ((psta->cmn.aid > 0) && (pstapriv->sta_aid[psta->cmn.aid - 1] == psta)) {
-			pstapriv->sta_aid[psta->cmn.aid - 1] = NULL;
-			psta->cmn.aid = 0;
-		}
+		rtw_aid_free(pstapriv, psta);
 	}
 
 #endif /* CONFIG_NATIVEAP_MLME	 */
@@ -981,33 +1191,119 @@ struct sta_info *rtw_get_bcmc_stainfo(_adapter *padapter)
 }
 
 #ifdef CONFIG_AP_MODE
+/*
+* rtw_aid_find_free - first unbound AID from start, wrapping around
+* return 0 if all AIDs are bound
+*/
+static u16 rtw_aid_find_free(struct sta_priv *stapriv, u16 start)
+{
+	u16 words = AID_MAP_WORDS(stapriv->max_aid);
+	u16 idx = start - 1;
+	u16 w = idx / 32;
+	u32 busy;
+	u8 bit;
+	int n;
+
+	/* the word of start is visited twice, bits above start first and bits below start last */
+	for (n = 0; n <= words; n++, w = (w + 1) % words) {
+		busy = stapriv->aid_map[w];
+		if (n == 0)
+			busy |= BIT(idx % 32) - 1;
+		if (w == words - 1 && stapriv->max_aid % 32)
+			busy |= ~(BIT(stapriv->max_aid % 32) - 1);
+
+		bit = rtw_ffz32(busy);
+		if (bit < 32)
+			return w * 32 + bit + 1;
+	}
+
+	return 0;
+}
+
+/* bind AID to sta, caller must make sure the AID is unbound */
+void rtw_aid_bind(struct sta_priv *stapriv, struct sta_info *sta, u16 aid)
+{
+	_irqL irqL;
+
+	if (aid == 0 || aid > stapriv->max_aid) {
+		rtw_warn_on(1);
+		return;
+	}
+
+	_enter_critical_bh(&stapriv->aid_lock, &irqL);
+	sta->cmn.aid = aid;
+	stapriv->sta_aid[aid - 1] = sta;
+	if (!(stapriv->aid_map[(aid - 1) / 32] & BIT((aid - 1) % 32))) {
+		stapriv->aid_map[(aid - 1) / 32] |= BIT((aid - 1) % 32);
+		stapriv->aid_used_cnt++;
+	}
+	_exit_critical_bh(&stapriv->aid_lock, &irqL);
+}
+
 u16 rtw_aid_alloc(_adapter *adapter, struct sta_info *sta)
 {
 	struct sta_priv *stapriv = &adapter->stapriv;
-	u16 aid, i, used_cnt = 0;
+	_irqL irqL;
+	u16 aid = 0;
 
-	for (i = 0; i < stapriv->max_aid; i++) {
-		aid = ((i + stapriv->started_aid - 1) % stapriv->max_aid) + 1;
-		if (stapriv->sta_aid[aid - 1] == NULL)
-			break;
-		if (++used_cnt >= stapriv->max_num_sta)
-			break;
-	}
+	_enter_critical_bh(&stapriv->aid_lock, &irqL);
 
-	/* check for aid limit and assoc limit  */
-	if (i >= stapriv->max_aid || used_cnt >= stapriv->max_num_sta)
-		aid = 0;
+	/* check for assoc limit, then aid limit */
+	if (stapriv->aid_used_cnt >= stapriv->max_num_sta)
+		goto unlock;
+
+	aid = rtw_aid_find_free(stapriv, stapriv->started_aid);
+	if (!aid)
+		goto unlock;
+
+	stapriv->aid_map[(aid - 1) / 32] |= BIT((aid - 1) % 32);
+	stapriv->aid_used_cnt++;
+	stapriv->sta_aid[aid - 1] = sta;
+	if (stapriv->rr_aid)
+		stapriv->started_aid = (aid % stapriv->max_aid) + 1;
+
+unlock:
+	_exit_critical_bh(&stapriv->aid_lock, &irqL);
 
 	sta->cmn.aid = aid;
-	if (aid) {
-		stapriv->sta_aid[aid - 1] = sta;
-		if (stapriv->rr_aid)
-			stapriv->started_aid = (aid % stapriv->max_aid) + 1;
-	}
 
 	return aid;
 }
 
+/* unbind the AID of sta if it is still bound to sta */
+void rtw_aid_free(struct sta_priv *stapriv, struct sta_info *sta)
+{
+	_irqL irqL;
+	u16 aid = sta->cmn.aid;
+
+	if (aid == 0 || aid > stapriv->max_aid)
+		return;
+
+	_enter_critical_bh(&stapriv->aid_lock, &irqL);
+	if (stapriv->sta_aid[aid - 1] == sta) {
+		stapriv->sta_aid[aid - 1] = NULL;
+		if (stapriv->aid_map[(aid - 1) / 32] & BIT((aid - 1) % 32)) {
+			stapriv->aid_map[(aid - 1) / 32] &= ~BIT((aid - 1) % 32);
+			stapriv->aid_used_cnt--;
+		}
+		sta->cmn.aid = 0;
+	}
+	_exit_critical_bh(&stapriv->aid_lock, &irqL);
+}
+
+void rtw_aid_free_all(struct sta_priv *stapriv)
+{
+	_irqL irqL;
+	int i;
+
+	_enter_critical_bh(&stapriv->aid_lock, &irqL);
+	for (i = 0; i < stapriv->max_aid; i++)
+		stapriv->sta_aid[i] = NULL;
+	_rtw_memset(stapriv->aid_map, 0, sizeof(stapriv->aid_map));
+	stapriv->aid_used_cnt = 0;
+	_exit_critical_bh(&stapriv->aid_lock, &irqL);
+}
+
 void dump_aid_status(void *sel, _adapter *adapter)
 {
 	struct sta_priv *stapriv = &adapter->stapriv;
@@ -1019,13 +1315,13 @@ void dump_aid_status(void *sel, _adapter *adapter)
 		return;
 
 	for (i = 1; i <= stapriv->max_aid; i++) {
-		if (stapriv->sta_aid[i - 1]) {
+		if (stapriv->aid_map[(i - 1) / 32] & BIT((i - 1) % 32)) {
 			aid_bmp[i / 8] |= BIT(i % 8);
 			++used_cnt;
 		}
 	}
 
-	RTW_PRINT_SEL(sel, "used_cnt:%u/%u\n", used_cnt, stapriv->max_aid);
+	RTW_PRINT_SEL(sel, "used_cnt:%u/%u (%u)\n", used_cnt, stapriv->max_aid, stapriv->aid_used_cnt);
 	RTW_MAP_DUMP_SEL(sel, "aid_map:", aid_bmp, stapriv->aid_bmp_len);
 	RTW_PRINT_SEL(sel, "\n");
 
@@ -1048,12 +1344,28 @@ const char *const _acl_mode_str[RTW_ACL_MODE_MAX] = {
 	"DENY_UNLESS_LISTED",
 };
 
+/* caller must hold acl->acl_node_q.lock */
+struct rtw_wlan_acl_node *rtw_acl_node_find(struct wlan_acl_pool *acl, const u8 *addr)
+{
+	_list *head, *list;
+	struct rtw_wlan_acl_node *acl_node;
+
+	head = &acl->hash[acl_hash(addr)];
+	list = get_next(head);
+	while (rtw_end_of_queue_search(head, list) == _FALSE) {
+		acl_node = LIST_CONTAINOR(list, struct rtw_wlan_acl_node, hash_list);
+		if (_rtw_memcmp(acl_node->addr, addr, ETH_ALEN))
+			return acl_node;
+		list = get_next(list);
+	}
+
+	return NULL;
+}
+
 u8 _rtw_access_ctrl(_adapter *adapter, u8 period, const u8 *mac_addr)
 {
 	u8 res = _TRUE;
 	_irqL irqL;
-	_list *list, *head;
-	struct rtw_wlan_acl_node *acl_node;
 	u8 match = _FALSE;
 	struct sta_priv *stapriv = &adapter->stapriv;
 	struct wlan_acl_pool *acl;
@@ -1072,19 +1384,8 @@ u8 _rtw_access_ctrl(_adapter *adapter, u8 period, const u8 *mac_addr)
 		goto exit;
 
 	_enter_critical_bh(&(acl_node_q->lock), &irqL);
-	head = get_list_head(acl_node_q);
-	list = get_next(head);
-	while (rtw_end_of_queue_search(head, list) == _FALSE) {
-		acl_node = LIST_CONTAINOR(list, struct rtw_wlan_acl_node, list);
-		list = get_next(list);
-
-		if (_rtw_memcmp(acl_node->addr, mac_addr, ETH_ALEN)) {
-			if (acl_node->valid == _TRUE) {
-				match = _TRUE;
-				break;
-			}
-		}
-	}
+	if (rtw_acl_node_find(acl, mac_addr))
+		match = _TRUE;
 	_exit_critical_bh(&(acl_node_q->lock), &irqL);
 
 	if (acl->mode == RTW_ACL_MODE_ACCEPT_UNLESS_LISTED)
@@ -1129,24 +1430,50 @@ void dump_macaddr_acl(void *sel, _adapter *adapter)
 }
 #endif /* CONFIG_RTW_MACADDR_ACL */
 
+#if CONFIG_RTW_PRE_LINK_STA
+#define pre_link_sta_hash(addr) (wifi_mac_hash(addr) & (RTW_PRE_LINK_STA_HASH_NUM - 1))
+
+/* caller must hold pre_link_sta_ctl->lock */
+static struct pre_link_sta_node_t *rtw_pre_link_sta_node_find(struct pre_link_sta_ctl_t *pre_link_sta_ctl, const u8 *addr)
+{
+	_list *head, *list;
+	struct pre_link_sta_node_t *node;
+
+	head = &pre_link_sta_ctl->hash[pre_link_sta_hash(addr)];
+	list = get_next(head);
+	while (rtw_end_of_queue_search(head, list) == _FALSE) {
+		node = LIST_CONTAINOR(list, struct pre_link_sta_node_t, hash_list);
+		if (_rtw_memcmp(node->addr, addr, ETH_ALEN) == _TRUE)
+			return node;
+		list = get_next(list);
+	}
+
+	return NULL;
+}
+
+/* caller must hold pre_link_sta_ctl->lock */
+static void rtw_pre_link_sta_node_release(struct pre_link_sta_ctl_t *pre_link_sta_ctl, struct pre_link_sta_node_t *node)
+{
+	rtw_list_delete(&node->hash_list);
+	node->valid = _FALSE;
+	pre_link_sta_ctl->used_map &= ~BIT(node - pre_link_sta_ctl->node);
+	pre_link_sta_ctl->num--;
+}
+#endif /* CONFIG_RTW_PRE_LINK_STA */
+
 bool rtw_is_pre_link_sta(struct sta_priv *stapriv, u8 *addr)
 {
 #if CONFIG_RTW_PRE_LINK_STA
 	struct pre_link_sta_ctl_t *pre_link_sta_ctl = &stapriv->pre_link_sta_ctl;
-	struct sta_info *sta = NULL;
 	u8 exist = _FALSE;
-	int i;
 	_irqL irqL;
 
+	if (!pre_link_sta_ctl->num)
+		return _FALSE;
+
 	_enter_critical_bh(&(pre_link_sta_ctl->lock), &irqL);
-	for (i = 0; i < RTW_PRE_LINK_STA_NUM; i++) {
-		if (pre_link_sta_ctl->node[i].valid == _TRUE
-			&& _rtw_memcmp(pre_link_sta_ctl->node[i].addr, addr, ETH_ALEN) == _TRUE
-		) {
-			exist = _TRUE;
-			break;
-		}
-	}
+	if (rtw_pre_link_sta_node_find(pre_link_sta_ctl, addr))
+		exist = _TRUE;
 	_exit_critical_bh(&(pre_link_sta_ctl->lock), &irqL);
 
 	return exist;
@@ -1161,31 +1488,24 @@ struct sta_info *rtw_pre_link_sta_add(struct sta_priv *stapriv, u8 *hwaddr)
 	struct pre_link_sta_ctl_t *pre_link_sta_ctl = &stapriv->pre_link_sta_ctl;
 	struct pre_link_sta_node_t *node = NULL;
 	struct sta_info *sta = NULL;
-	u8 exist = _FALSE;
-	int i;
+	u8 i;
 	_irqL irqL;
 
 	if (rtw_check_invalid_mac_address(hwaddr, _FALSE) == _TRUE)
 		goto exit;
 
 	_enter_critical_bh(&(pre_link_sta_ctl->lock), &irqL);
-	for (i = 0; i < RTW_PRE_LINK_STA_NUM; i++) {
-		if (pre_link_sta_ctl->node[i].valid == _TRUE
-			&& _rtw_memcmp(pre_link_sta_ctl->node[i].addr, hwaddr, ETH_ALEN) == _TRUE
-		) {
+	node = rtw_pre_link_sta_node_find(pre_link_sta_ctl, hwaddr);
+	if (!node) {
+		i = rtw_ffz32(pre_link_sta_ctl->used_map);
+		if (i < RTW_PRE_LINK_STA_NUM) {
 			node = &pre_link_sta_ctl->node[i];
-			exist = _TRUE;
-			break;
+			_rtw_memcpy(node->addr, hwaddr, ETH_ALEN);
+			node->valid = _TRUE;
+			rtw_list_insert_tail(&node->hash_list, &pre_link_sta_ctl->hash[pre_link_sta_hash(hwaddr)]);
+			pre_link_sta_ctl->used_map |= BIT(i);
+			pre_link_sta_ctl->num++;
 		}
-
-		if (node == NULL && pre_link_sta_ctl->node[i].valid == _FALSE)
-			node = &pre_link_sta_ctl->node[i];
-	}
-
-	if (exist == _FALSE && node) {
-		_rtw_memcpy(node->addr, hwaddr, ETH_ALEN);
-		node->valid = _TRUE;
-		pre_link_sta_ctl->num++;
 	}
 	_exit_critical_bh(&(pre_link_sta_ctl->lock), &irqL);
 
@@ -1215,26 +1535,16 @@ void rtw_pre_link_sta_del(struct sta_priv *stapriv, u8 *hwaddr)
 	struct pre_link_sta_node_t *node = NULL;
 	struct sta_info *sta = NULL;
 	u8 exist = _FALSE;
-	int i;
 	_irqL irqL;
 
 	if (rtw_check_invalid_mac_address(hwaddr, _FALSE) == _TRUE)
 		goto exit;
 
 	_enter_critical_bh(&(pre_link_sta_ctl->lock), &irqL);
-	for (i = 0; i < RTW_PRE_LINK_STA_NUM; i++) {
-		if (pre_link_sta_ctl->node[i].valid == _TRUE
-			&& _rtw_memcmp(pre_link_sta_ctl->node[i].addr, hwaddr, ETH_ALEN) == _TRUE
-		) {
-			node = &pre_link_sta_ctl->node[i];
-			exist = _TRUE;
-			break;
-		}
-	}
-
-	if (exist == _TRUE && node) {
-		node->valid = _FALSE;
-		pre_link_sta_ctl->num--;
+	node = rtw_pre_link_sta_node_find(pre_link_sta_ctl, hwaddr);
+	if (node) {
+		rtw_pre_link_sta_node_release(pre_link_sta_ctl, node);
+		exist = _TRUE;
 	}
 	_exit_critical_bh(&(pre_link_sta_ctl->lock), &irqL);
 
@@ -1266,11 +1576,11 @@ void rtw_pre_link_sta_ctl_reset(struct sta_priv *stapriv)
 
 	_enter_critical_bh(&(pre_link_sta_ctl->lock), &irqL);
 	for (i = 0; i < RTW_PRE_LINK_STA_NUM; i++) {
-		if (pre_link_sta_ctl->node[i].valid == _FALSE)
+		node = &pre_link_sta_ctl->node[i];
+		if (node->valid == _FALSE)
 			continue;
-		_rtw_memcpy(&(addrs[j][0]), pre_link_sta_ctl->node[i].addr, ETH_ALEN);
-		pre_link_sta_ctl->node[i].valid = _FALSE;
-		pre_link_sta_ctl->num--;
+		_rtw_memcpy(&(addrs[j][0]), node->addr, ETH_ALEN);
+		rtw_pre_link_sta_node_release(pre_link_sta_ctl, node);
 		j++;
 	}
 	_exit_critical_bh(&(pre_link_sta_ctl->lock), &irqL);
@@ -1292,8 +1602,13 @@ void rtw_pre_link_sta_ctl_init(struct sta_priv *stapriv)
 
 	_rtw_spinlock_init(&pre_link_sta_ctl->lock);
 	pre_link_sta_ctl->num = 0;
-	for (i = 0; i < RTW_PRE_LINK_STA_NUM; i++)
+	pre_link_sta_ctl->used_map = 0;
+	for (i = 0; i < RTW_PRE_LINK_STA_HASH_NUM; i++)
+		_rtw_init_listhead(&pre_link_sta_ctl->hash[i]);
+	for (i = 0; i < RTW_PRE_LINK_STA_NUM; i++) {
+		_rtw_init_listhead(&pre_link_sta_ctl->node[i].hash_list);
 		pre_link_sta_ctl->node[i].valid = _FALSE;
+	}
 }
 
 void rtw_pre_link_sta_ctl_deinit(struct sta_priv *stapriv)
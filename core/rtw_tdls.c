@@ -2485,7 +2485,7 @@ int On_TDLS_Peer_Traffic_Rsp(_adapter *padapter, union recv_frame *precv_frame,
 				xmitframe_plist = get_next(xmitframe_plist);
 				rtw_list_delete(&pxmitframe->list);
 
-				ptdls_sta->sleepq_len--;
+				rtw_sleepq_frame_out(ptdls_sta, pxmitframe);
 				ptdls_sta->sleepq_ac_len--;
 				if (ptdls_sta->sleepq_len > 0) {
 					pxmitframe->attrib.mdata = 1;
@@ -2504,6 +2504,7 @@ int On_TDLS_Peer_Traffic_Rsp(_adapter *padapter, union recv_frame *precv_frame,
 			else {
 				RTW_INFO("error!psta->sleepq_len=%d\n", ptdls_sta->sleepq_len);
 				ptdls_sta->sleepq_len = 0;
+				ptdls_sta->sleepq_bytes = 0;
 			}
 
 			_exit_critical_bh(&ptdls_sta->sleep_q.lock, &irqL);
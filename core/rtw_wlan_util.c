@@ -2494,7 +2494,7 @@ int rtw_get_bcn_keys(ADAPTER *Adapter, u8 *pframe, u32 packet_len,
 			return _FALSE;
 	}
 
-	if (rtw_ies_get_supported_rate(pos, left, recv_beacon->rate_set, &recv_beacon->rate_num) == _FAIL)
+	if (rtw_ie_idx_get_supported_rate(&elems.idx, recv_beacon->rate_set, &recv_beacon->rate_num) == _FAIL)
 		return _FALSE;
 
 	if (cckratesonly_included(recv_beacon->rate_set, recv_beacon->rate_num) == _TRUE)
@@ -2511,7 +2511,7 @@ int rtw_get_bcn_keys(ADAPTER *Adapter, u8 *pframe, u32 packet_len,
 		recv_beacon->proto_cap |= PROTO_CAP_11AC;
 
 	/* check bw and channel offset */
-	rtw_ies_get_chbw(pos, left, &recv_beacon->ch, &recv_beacon->bw, &recv_beacon->offset, 1, 1);
+	rtw_ie_idx_get_chbw(&elems.idx, &recv_beacon->ch, &recv_beacon->bw, &recv_beacon->offset, 1, 1);
 	if (!recv_beacon->ch) {
 		/* we don't find channel IE, so don't check it */
 		/* RTW_INFO("Oops: %s we don't find channel IE, so don't check it\n", __func__); */
@@ -2573,6 +2573,38 @@ void rtw_dump_bcn_keys(void *sel, struct beacon_keys *recv_beacon)
 		, recv_beacon->pairwise_cipher, recv_beacon->akm);
 }
 
+/*
+* rtw_bcn_ie_crc - CRC-32 of the beacon content used by rtw_check_bcn_info() and update_beacon_info()
+* timestamp, DTIM count/bitmap of TIM and BSS load are excluded since they change beacon by beacon
+*/
+u32 rtw_bcn_ie_crc(u8 *pframe, u32 packet_len)
+{
+	u8 *pos = pframe + WLAN_HDR_A3_LEN + _BEACON_IE_OFFSET_;
+	int left = packet_len - WLAN_HDR_A3_LEN - _BEACON_IE_OFFSET_;
+	u32 crc = 0xffffffff;
+
+	/* beacon interval and capability */
+	crc = rtw_crc32_update(crc, pframe + WLAN_HDR_A3_LEN + 8, 4);
+
+	while (left >= 2 && pos[1] + 2 <= left) {
+		if (pos[0] == _TIM_IE_) {
+			/* DTIM period only */
+			if (pos[1] >= 2)
+				crc = rtw_crc32_update(crc, pos + 3, 1);
+		} else if (pos[0] != EID_QBSSLoad)
+			crc = rtw_crc32_update(crc, pos, pos[1] + 2);
+
+		left -= pos[1] + 2;
+		pos += pos[1] + 2;
+	}
+
+	/* broken tail */
+	if (left > 0)
+		crc = rtw_crc32_update(crc, pos, left);
+
+	return ~crc;
+}
+
 int rtw_check_bcn_info(ADAPTER *Adapter, u8 *pframe, u32 packet_len)
 {
 #define BCNKEY_VERIFY_PROTO_CAP 0
@@ -3439,9 +3471,17 @@ void update_sta_basic_rate(struct sta_info *psta, u8 wireless_mode)
 }
 
 int rtw_ies_get_supported_rate(u8 *ies, uint ies_len, u8 *rate_set, u8 *rate_num)
+{
+	struct rtw_ie_idx idx;
+
+	rtw_ie_idx_build(&idx, ies, ies_len);
+	return rtw_ie_idx_get_supported_rate(&idx, rate_set, rate_num);
+}
+
+int rtw_ie_idx_get_supported_rate(struct rtw_ie_idx *idx, u8 *rate_set, u8 *rate_num)
 {
 	u8 *ie, *p;
-	unsigned int ie_len;
+	sint ie_len;
 	int i, j;
 
 	struct support_rate_handler support_rate_tbl[] = {
@@ -3463,7 +3503,7 @@ int rtw_ies_get_supported_rate(u8 *ies, uint ies_len, u8 *rate_set, u8 *rate_num
 		return _FALSE;
 
 	*rate_num = 0;
-	ie = rtw_get_ie(ies, _SUPPORTEDRATES_IE_, &ie_len, ies_len);
+	ie = rtw_ie_idx_get_ie(idx, _SUPPORTEDRATES_IE_, &ie_len);
 	if (ie == NULL)
 		goto ext_rate;
 
@@ -3481,7 +3521,7 @@ int rtw_ies_get_supported_rate(u8 *ies, uint ies_len, u8 *rate_set, u8 *rate_num
 	}
 
 ext_rate:
-	ie = rtw_get_ie(ies, _EXT_SUPPORTEDRATES_IE_, &ie_len, ies_len);
+	ie = rtw_ie_idx_get_ie(idx, _EXT_SUPPORTEDRATES_IE_, &ie_len);
 	if (ie) {
 		/* get valid extended supported rates */
 		for (i = 0; i < 12; i++) {
@@ -3539,6 +3579,11 @@ void process_addba_req(_adapter *padapter, u8 *paddba_req, u8 *addr)
 
 
 	accept = rtw_rx_ampdu_is_accept(padapter);
+
+	/* attach reordering ctrl now, BAR may come before add_ba_rsp_hdl() runs */
+	if (accept == _TRUE && !rtw_alloc_reorder_ctrl(psta, tid))
+		accept = _FALSE;
+
 	if (padapter->fix_rx_ampdu_size != RX_AMPDU_SIZE_INVALID)
 		size = padapter->fix_rx_ampdu_size;
 	else {
@@ -3569,7 +3614,9 @@ void rtw_process_bar_frame(_adapter *padapter, union recv_frame *precv_frame)
 		goto exit;
 
 	tid = ((cpu_to_le16((*(u16 *)(pframe + 16))) & 0xf000) >> 12);
-	preorder_ctrl = &psta->recvreorder_ctrl[tid];
+	preorder_ctrl = psta->recvreorder_ctrl[tid];
+	if (preorder_ctrl == NULL)
+		goto exit;
 	start_seq = ((cpu_to_le16(*(u16 *)(pframe + 18))) >> 4);
 	preorder_ctrl->indicate_seq = start_seq;
 
@@ -3806,6 +3853,72 @@ void rtw_iface_bcmc_sec_cam_map_restore(_adapter *adapter)
 		rtw_sec_cam_map_set(&cam_ctl->used, cam_id);
 }
 #endif
+static inline u32 rtw_macid_map_word(struct macid_bmp *map, u8 w)
+{
+	if (w == 0)
+		return map->m0;
+#if (MACID_NUM_SW_LIMIT > 32)
+	else if (w == 1)
+		return map->m1;
+#endif
+#if (MACID_NUM_SW_LIMIT > 64)
+	else if (w == 2)
+		return map->m2;
+#endif
+#if (MACID_NUM_SW_LIMIT > 96)
+	else if (w == 3)
+		return map->m3;
+#endif
+	return 0xFFFFFFFF;
+}
+
+static inline u32 rtw_sec_cam_map_word(struct sec_cam_bmp *map, u8 w)
+{
+	if (w == 0)
+		return map->m0;
+#if (SEC_CAM_ENT_NUM_SW_LIMIT > 32)
+	else if (w == 1)
+		return map->m1;
+#endif
+#if (SEC_CAM_ENT_NUM_SW_LIMIT > 64)
+	else if (w == 2)
+		return map->m2;
+#endif
+#if (SEC_CAM_ENT_NUM_SW_LIMIT > 96)
+	else if (w == 3)
+		return map->m3;
+#endif
+	return 0xFFFFFFFF;
+}
+
+/*
+* rtw_macid_find_free - lowest macid not used, word by word
+* @cam_ctl: if not NULL, sec cam id of the same value must be free too (BMC STA)
+* @rsvd: bitmap of macid 0~31 not to be allocated
+* return macid_ctl->num if no available macid
+*/
+static u8 rtw_macid_find_free(struct macid_ctl_t *macid_ctl, struct cam_ctl_t *cam_ctl, u32 rsvd)
+{
+	u32 busy;
+	u8 w, bit, id;
+
+	for (w = 0; w * 32 < macid_ctl->num; w++) {
+		busy = rtw_macid_map_word(&macid_ctl->used, w);
+		if (cam_ctl)
+			busy |= rtw_sec_cam_map_word(&cam_ctl->used, w);
+		if (w == 0)
+			busy |= rsvd;
+
+		bit = rtw_ffz32(busy);
+		if (bit < 32) {
+			id = w * 32 + bit;
+			return id < macid_ctl->num ? id : macid_ctl->num;
+		}
+	}
+
+	return macid_ctl->num;
+}
+
 void rtw_alloc_macid(_adapter *padapter, struct sta_info *psta)
 {
 	int i;
@@ -3814,8 +3927,7 @@ void rtw_alloc_macid(_adapter *padapter, struct sta_info *psta)
 	struct dvobj_priv *dvobj = adapter_to_dvobj(padapter);
 	struct macid_ctl_t *macid_ctl = dvobj_to_macidctl(dvobj);
 	struct macid_bmp *used_map = &macid_ctl->used;
-	/* static u8 last_id = 0;  for testing */
-	u8 last_id = 0;
+	u32 rsvd = 0;
 	u8 is_bc_sta = _FALSE;
 
 	if (_rtw_memcmp(psta->cmn.mac_addr, adapter_mac_addr(padapter), ETH_ALEN)) {
@@ -3840,29 +3952,15 @@ void rtw_alloc_macid(_adapter *padapter, struct sta_info *psta)
 		goto assigned;
 	}
 
-	_enter_critical_bh(&macid_ctl->lock, &irqL);
-
-	for (i = last_id; i < macid_ctl->num; i++) {
 #ifdef CONFIG_MCC_MODE
-		/* macid 0/1 reserve for mcc for mgnt queue macid */
-		if (MCC_EN(padapter)) {
-			if (i == MCC_ROLE_STA_GC_MGMT_QUEUE_MACID)
-				continue;
-			if (i == MCC_ROLE_SOFTAP_GO_MGMT_QUEUE_MACID)
-				continue;
-		}
+	/* macid 0/1 reserve for mcc for mgnt queue macid */
+	if (MCC_EN(padapter))
+		rsvd = BIT(MCC_ROLE_STA_GC_MGMT_QUEUE_MACID) | BIT(MCC_ROLE_SOFTAP_GO_MGMT_QUEUE_MACID);
 #endif /* CONFIG_MCC_MODE */
 
-		if (is_bc_sta) {
-			struct cam_ctl_t *cam_ctl = dvobj_to_sec_camctl(dvobj);
+	_enter_critical_bh(&macid_ctl->lock, &irqL);
 
-			if ((!rtw_macid_is_used(macid_ctl, i)) && (!rtw_sec_camid_is_used(cam_ctl, i)))
-				break;
-		} else {
-			if (!rtw_macid_is_used(macid_ctl, i))
-				break;
-		}
-	}
+	i = rtw_macid_find_free(macid_ctl, is_bc_sta ? dvobj_to_sec_camctl(dvobj) : NULL, rsvd);
 
 	if (i < macid_ctl->num) {
 
@@ -3880,9 +3978,6 @@ void rtw_alloc_macid(_adapter *padapter, struct sta_info *psta)
 		macid_ctl->sta[i] = psta;
 
 		/* TODO ch_g? */
-
-		last_id++;
-		last_id %= macid_ctl->num;
 	}
 
 	_exit_critical_bh(&macid_ctl->lock, &irqL);
@@ -137,6 +137,13 @@ s32	_rtw_init_xmit_priv(struct xmit_priv *pxmitpriv, _adapter *padapter)
 
 	pxmitpriv->free_xmitframe_cnt = NR_XMITFRAME;
 
+	for (i = 0; i < 4; i++) {
+		pxmitpriv->xmitframe_ac_rsvd[i] = rtw_min(padapter->registrypriv.tx_ac_rsvd[i], NR_XMITFRAME / 8);
+		pxmitpriv->xmitframe_ac_quota[i] = rtw_min(padapter->registrypriv.tx_ac_quota[i], NR_XMITFRAME);
+		pxmitpriv->xmitframe_ac_cnt[i] = 0;
+		pxmitpriv->tx_ac_drop[i] = 0;
+	}
+
 	pxmitpriv->frag_len = MAX_FRAG_THRESHOLD;
 
 
@@ -192,6 +199,7 @@ s32	_rtw_init_xmit_priv(struct xmit_priv *pxmitpriv, _adapter *padapter)
 	}
 
 	pxmitpriv->free_xmitbuf_cnt = NR_XMITBUFF;
+	pxmitpriv->xmitbuf_rsvd = rtw_min(padapter->registrypriv.tx_xmitbuf_rsvd, NR_XMITBUFF / 2);
 
 	/* init xframe_ext queue,  the same count as extbuf */
 	_rtw_init_queue(&pxmitpriv->free_xframe_ext_queue);
@@ -317,6 +325,22 @@ s32	_rtw_init_xmit_priv(struct xmit_priv *pxmitpriv, _adapter *padapter)
 	pxmitpriv->ack_tx = _FALSE;
 	_rtw_mutex_init(&pxmitpriv->ack_tx_mutex);
 	rtw_sctx_init(&pxmitpriv->ack_tx_ops, 0);
+	pxmitpriv->ack_tx_async = _FALSE;
+	rtw_init_timer(&pxmitpriv->ack_tx_timer, padapter, rtw_ack_tx_timeout_hdl, pxmitpriv);
+#ifdef PLATFORM_LINUX
+	init_completion(&pxmitpriv->ack_tx_free);
+#endif
+#endif
+
+#ifdef CONFIG_TX_CMPL_TRACK
+	_rtw_spinlock_init(&pxmitpriv->tx_cmpl_lock);
+	pxmitpriv->tx_cmpl_sample = 0;
+	pxmitpriv->tx_cmpl_cnt = 0;
+#endif
+#ifdef CONFIG_RTW_HOST_RA
+	pxmitpriv->host_ra_en = 0;
+	pxmitpriv->host_ra_sample_intvl = HOST_RA_SAMPLE_INTVL_DEF;
+	pxmitpriv->host_ra_rpt_intvl = HOST_RA_RPT_INTVL_DEF;
 #endif
 
 #ifdef CONFIG_TX_AMSDU
@@ -442,6 +466,9 @@ void _rtw_free_xmit_priv(struct xmit_priv *pxmitpriv)
 
 #ifdef CONFIG_XMIT_ACK
 	_rtw_mutex_free(&pxmitpriv->ack_tx_mutex);
+#endif
+#ifdef CONFIG_TX_CMPL_TRACK
+	_rtw_spinlock_free(&pxmitpriv->tx_cmpl_lock);
 #endif
 	rtw_free_xmit_block(padapter);
 out:
@@ -2381,26 +2408,228 @@ s32 check_amsdu_tx_support(_adapter *padapter)
 	return ret;
 }
 
-s32 rtw_xmitframe_coalesce_amsdu(_adapter *padapter, struct xmit_frame *pxmitframe, struct xmit_frame *pxmitframe_queue)
+u8 rtw_amsdu_prio_to_qidx(u8 priority)
 {
+	switch (priority) {
+	case 1:
+	case 2:
+		return BK_QUEUE_INX;
+	case 4:
+	case 5:
+		return VI_QUEUE_INX;
+	case 6:
+	case 7:
+		return VO_QUEUE_INX;
+	case 0:
+	case 3:
+	default:
+		return BE_QUEUE_INX;
+	}
+}
 
-	struct pkt_file pktfile;
-	struct pkt_attrib *pattrib;
-	_pkt *pkt;
+const char *const _amsdu_flush_reason_str[] = {
+	"BURST",
+	"FULL",
+	"TIMEOUT",
+	"BUDGET",
+	"UNKNOWN",
+};
 
-	struct pkt_file pktfile_queue;
-	struct pkt_attrib *pattrib_queue;
-	_pkt *pkt_queue;
+static u32 rtw_amsdu_adapt_lat_budget(_adapter *padapter, u8 qidx)
+{
+	u32 budget = padapter->tx_amsdu_lat_budget;
+
+	switch (qidx) {
+	case VO_QUEUE_INX:
+		return budget >> 2;
+	case VI_QUEUE_INX:
+		return budget >> 1;
+	case BK_QUEUE_INX:
+		return budget << 1;
+	default:
+		return budget;
+	}
+}
 
-	s32 llc_sz, mem_sz;
+/*
+ * rtw_amsdu_adapt_decide - choose subframe count and flush timeout for the next A-MSDU
+ * @psta: receiver of the A-MSDU
+ * @priority: user priority of the frame at hand
+ * @qlen: number of frames still pending behind the frame at hand for this station/AC
+ * @pkt_len: MSDU length of the frame at hand
+ *
+ * The subframe count is the largest one whose drain time at the measured TX
+ * throughput of @psta stays within the AC latency budget, capped by how many
+ * frames are expected to be available (queue depth and its EWMA). A shallow
+ * queue sends the frame right away, a deep queue packs fully. The flush
+ * timeout is the expected time for the missing subframes to arrive.
+ *
+ * Returns: subframe count, 1 means send without coalescing
+ */
+u8 rtw_amsdu_adapt_decide(_adapter *padapter, struct sta_info *psta, u8 priority, u16 qlen, u16 pkt_len)
+{
+	struct rtw_amsdu_ctl *ctl;
+	u8 qidx = rtw_amsdu_prio_to_qidx(priority);
+	u32 tp_kbits, budget_us, sub_us, avail, num, max_num;
+
+	if (!psta)
+		return 1;
+
+	ctl = &psta->sta_xmitpriv.amsdu_ctl[qidx];
+
+	/* EWMA with weight 1/8, qlen_avg is fixed point << 3 */
+	ctl->qlen_avg = ctl->qlen_avg - (ctl->qlen_avg >> 3) + rtw_min(qlen, (u16)0x1FFF);
+
+	max_num = rtw_min(padapter->tx_amsdu_max_num, RTW_AMSDU_ADAPT_MAX_NUM);
+	if (max_num < 1)
+		max_num = 1;
+
+	/* frames expected to be available: what is queued now, or what usually is */
+	avail = rtw_max((u32)qlen, (u32)(ctl->qlen_avg >> 3)) + 1;
+
+	if (avail <= 1 || max_num == 1) {
+		ctl->num = 1;
+		ctl->timeout_ms = 0;
+		ctl->reason = RTW_AMSDU_FLUSH_BURST;
+		goto exit;
+	}
+
+	tp_kbits = psta->sta_stats.smooth_tx_tp_kbits;
+	if (tp_kbits == 0)
+		tp_kbits = adapter_to_dvobj(padapter)->traffic_stat.cur_tx_tp * 1000;
+
+	budget_us = rtw_amsdu_adapt_lat_budget(padapter, qidx);
+	num = rtw_min(avail, max_num);
+	ctl->reason = RTW_AMSDU_FLUSH_FULL;
+
+	if (tp_kbits) {
+		/* drain time of one subframe at the measured rate, in us */
+		sub_us = ((u32)pkt_len * 8 * 1000) / tp_kbits;
+		if (sub_us && num * sub_us > budget_us) {
+			num = rtw_max(budget_us / sub_us, (u32)1);
+			ctl->reason = RTW_AMSDU_FLUSH_BUDGET;
+		}
+	} else {
+		/* no rate measured yet, aggregate modestly */
+		sub_us = 0;
+		num = rtw_min(num, (u32)2);
+	}
+
+	ctl->num = num;
+
+	if (num <= (u32)qlen + 1) {
+		/* everything needed is already queued */
+		ctl->timeout_ms = 0;
+	} else {
+		u32 wait_us = sub_us ? (num - qlen - 1) * sub_us : budget_us;
+
+		wait_us = rtw_min(wait_us, budget_us);
+		ctl->timeout_ms = rtw_min((u32)RTW_AMSDU_ADAPT_MAX_TIMEOUT_MS, rtw_max((wait_us + 999) / 1000, (u32)1));
+	}
+
+	/* VO never waits for more subframes */
+	if (qidx == VO_QUEUE_INX)
+		ctl->timeout_ms = 0;
 
+exit:
+	return ctl->num;
+}
+
+/*
+ * rtw_amsdu_adapt_flush - account an A-MSDU (or single MSDU) released to HW
+ * @num: number of subframes actually coalesced
+ * @reason: enum rtw_amsdu_flush_reason
+ */
+void rtw_amsdu_adapt_flush(_adapter *padapter, u8 priority, u8 num, u8 reason)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	u8 qidx = rtw_amsdu_prio_to_qidx(priority);
+
+	if (num > RTW_AMSDU_ADAPT_MAX_NUM)
+		num = RTW_AMSDU_ADAPT_MAX_NUM;
+	if (reason >= RTW_AMSDU_FLUSH_NUM)
+		reason = RTW_AMSDU_FLUSH_FULL;
+
+	pxmitpriv->amsdu_adapt_num_cnt[qidx][num]++;
+	pxmitpriv->amsdu_adapt_flush_cnt[qidx][reason]++;
+}
+
+void rtw_amsdu_adapt_stats_reset(_adapter *padapter)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+
+	_rtw_memset(pxmitpriv->amsdu_adapt_num_cnt, 0, sizeof(pxmitpriv->amsdu_adapt_num_cnt));
+	_rtw_memset(pxmitpriv->amsdu_adapt_flush_cnt, 0, sizeof(pxmitpriv->amsdu_adapt_flush_cnt));
+}
+
+/* put the MSDU of pxmitframe at pframe as an A-MSDU subframe, padded to 4 bytes unless it's the last one */
+static u8 *rtw_amsdu_put_subframe(_adapter *padapter, u8 *pframe, struct xmit_frame *pxmitframe, u8 last, u32 *txcmdsz)
+{
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+	struct pkt_file pktfile;
+	s32 llc_sz, mem_sz;
 	s32 padding = 0;
+	u16 *len;
+
+	_rtw_open_pktfile(pxmitframe->pkt, &pktfile);
+	_rtw_pktfile_read(&pktfile, NULL, pattrib->pkt_hdrlen);
 
+#ifdef CONFIG_RTW_MESH
+	if (MLME_IS_MESH(padapter)) {
+		/* mDA(6), mSA(6), len(2), mctrl */
+		_rtw_memcpy(pframe, pattrib->mda, ETH_ALEN);
+		pframe += ETH_ALEN;
+		_rtw_memcpy(pframe, pattrib->msa, ETH_ALEN);
+		pframe += ETH_ALEN;
+		len = (u16*)pframe;
+		pframe += 2;
+		rtw_mesh_tx_build_mctrl(padapter, pattrib, pframe);
+		pframe += XATTRIB_GET_MCTRL_LEN(pattrib);
+	} else
+#endif
+	{
+		/* 802.3 MAC Header  DA(6)  SA(6)  Len(2) */
+		_rtw_memcpy(pframe, pattrib->dst, ETH_ALEN);
+		pframe += ETH_ALEN;
+		_rtw_memcpy(pframe, pattrib->src, ETH_ALEN);
+		pframe += ETH_ALEN;
+		len = (u16*)pframe;
+		pframe += 2;
+	}
+
+	llc_sz = rtw_put_snap(pframe, pattrib->ether_type);
+	pframe += llc_sz;
+
+	mem_sz = _rtw_pktfile_read(&pktfile, pframe, pattrib->pktlen);
+	pframe += mem_sz;
+
+	*len = htons(XATTRIB_GET_MCTRL_LEN(pattrib) + llc_sz + mem_sz);
+
+	/* the last subframe has no padding */
+	if (!last) {
+		padding = 4 - ((ETH_HLEN + XATTRIB_GET_MCTRL_LEN(pattrib) + llc_sz + mem_sz) & (4-1));
+		if (padding == 4)
+			padding = 0;
+		pframe += padding;
+	}
+
+	*txcmdsz += ETH_HLEN + XATTRIB_GET_MCTRL_LEN(pattrib) + llc_sz + mem_sz + padding;
+
+	return pframe;
+}
+
+/*
+ * rtw_xmitframe_coalesce_amsdu - build an A-MSDU into pxmitframe->buf_addr
+ * The MAC header is the one of @pxmitframe, whose MSDU is the first subframe,
+ * followed by the MSDUs of @subframes in order.
+ */
+s32 rtw_xmitframe_coalesce_amsdu(_adapter *padapter, struct xmit_frame *pxmitframe, struct xmit_frame **subframes, u8 sub_num)
+{
+	struct pkt_attrib *pattrib;
 	u8 *pframe, *mem_start;
 	u8 hw_hdr_offset;
-
-	u16* len;
 	u8 *pbuf_start;
+	u8 i;
 	s32 res = _SUCCESS;
 
 	if (pxmitframe->buf_addr == NULL) {
@@ -2433,8 +2662,6 @@ s32 rtw_xmitframe_coalesce_amsdu(_adapter *padapter, struct xmit_frame *pxmitfra
 		goto exit;
 	}
 
-	llc_sz = 0;
-
 	pframe = mem_start;
 
 	//SetMFrag(mem_start);
@@ -2454,118 +2681,184 @@ s32 rtw_xmitframe_coalesce_amsdu(_adapter *padapter, struct xmit_frame *pxmitfra
 
 	pattrib->last_txcmdsz = pattrib->hdrlen + pattrib->iv_len;
 
-	if(pxmitframe_queue)
-	{
-		pattrib_queue = &pxmitframe_queue->attrib;
-		pkt_queue = pxmitframe_queue->pkt;
-
-		_rtw_open_pktfile(pkt_queue, &pktfile_queue);
-		_rtw_pktfile_read(&pktfile_queue, NULL, pattrib_queue->pkt_hdrlen);
-
-		#ifdef CONFIG_RTW_MESH
-		if (MLME_IS_MESH(padapter)) {
-			/* mDA(6), mSA(6), len(2), mctrl */
-			_rtw_memcpy(pframe, pattrib_queue->mda, ETH_ALEN);
-			pframe += ETH_ALEN;
-			_rtw_memcpy(pframe, pattrib_queue->msa, ETH_ALEN);
-			pframe += ETH_ALEN;
-			len = (u16*)pframe;
-			pframe += 2;
-			rtw_mesh_tx_build_mctrl(padapter, pattrib_queue, pframe);
-			pframe += XATTRIB_GET_MCTRL_LEN(pattrib_queue);
-		} else
-		#endif
-		{
-			/* 802.3 MAC Header DA(6)  SA(6)  Len(2)*/
-			_rtw_memcpy(pframe, pattrib_queue->dst, ETH_ALEN);
-			pframe += ETH_ALEN;
-			_rtw_memcpy(pframe, pattrib_queue->src, ETH_ALEN);
-			pframe += ETH_ALEN;
-			len = (u16*)pframe;
-			pframe += 2;
-		}
+	pframe = rtw_amsdu_put_subframe(padapter, pframe, pxmitframe, sub_num == 0, &pattrib->last_txcmdsz);
+	for (i = 0; i < sub_num; i++)
+		pframe = rtw_amsdu_put_subframe(padapter, pframe, subframes[i], i == sub_num - 1, &pattrib->last_txcmdsz);
 
-		llc_sz = rtw_put_snap(pframe, pattrib_queue->ether_type);
-		pframe += llc_sz;
+	pattrib->nr_frags = 1;
 
-		mem_sz = _rtw_pktfile_read(&pktfile_queue, pframe, pattrib_queue->pktlen);
-		pframe += mem_sz;
+	if ((pattrib->icv_len > 0) && (pattrib->bswenc)) {
+		_rtw_memcpy(pframe, pattrib->icv, pattrib->icv_len);
+		pframe += pattrib->icv_len;
+		pattrib->last_txcmdsz += pattrib->icv_len;
+	}
+
+	if (xmitframe_addmic(padapter, pxmitframe) == _FAIL) {
+		RTW_INFO("xmitframe_addmic(padapter, pxmitframe)==_FAIL\n");
+		res = _FAIL;
+		goto exit;
+	}
 
-		*len = htons(XATTRIB_GET_MCTRL_LEN(pattrib_queue) + llc_sz + mem_sz);
+	xmitframe_swencrypt(padapter, pxmitframe);
 
-		//calc padding
-		padding = 4 - ((ETH_HLEN + XATTRIB_GET_MCTRL_LEN(pattrib_queue) + llc_sz + mem_sz) & (4-1));
-		if(padding == 4)
-			padding = 0;
+	update_attrib_vcs_info(padapter, pxmitframe);
 
-		//_rtw_memset(pframe,0xaa, padding);
-		pframe += padding;
+exit:
+	return res;
+}
+
+/*
+ * rtw_amsdu_xmit_check - decide how the next frame to dequeue is sent
+ * Called by HAL before rtw_dequeue_xframe(). When the adaptive controller
+ * wants more subframes than are queued, the AC flush timer is armed with the
+ * timeout of the head frame's STA and TX is held until more frames come or
+ * the timer expires. Controller state is kept per STA in sta_xmit_priv, only
+ * the hold timer is per AC, as the head frame of an AC is what is held.
+ * Returns: subframe count for the next frame, 1: no A-MSDU, 0: hold TX
+ */
+u8 rtw_amsdu_xmit_check(_adapter *padapter)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	struct xmit_frame *pxmitframe;
+	struct pkt_attrib *pattrib;
+	struct rtw_amsdu_ctl *ctl;
+	int num_frame = 0;
+	u8 num, status;
 
-		pattrib->last_txcmdsz += ETH_HLEN + XATTRIB_GET_MCTRL_LEN(pattrib_queue) + llc_sz + mem_sz + padding ;
+	if (!check_amsdu_tx_support(padapter))
+		return 1;
+
+	pxmitframe = rtw_get_xframe(pxmitpriv, &num_frame);
+	if (!pxmitframe || !pxmitframe->attrib.psta || check_amsdu(pxmitframe) == _FALSE)
+		return 1;
+
+	pattrib = &pxmitframe->attrib;
+	ctl = &pattrib->psta->sta_xmitpriv.amsdu_ctl[rtw_amsdu_prio_to_qidx(pattrib->priority)];
+	status = rtw_amsdu_get_timer_status(padapter, pattrib->priority);
+
+	if (status == RTW_AMSDU_TIMER_TIMEOUT) {
+		/* waited long enough, send what is there */
+		rtw_amsdu_set_timer_status(padapter, pattrib->priority, RTW_AMSDU_TIMER_UNSET);
+		pxmitpriv->amsdu_debug_timeout++;
+		ctl->reason = RTW_AMSDU_FLUSH_TIMEOUT;
+		num = rtw_max(ctl->num, (u8)1);
+		goto exit;
 	}
 
-	//2nd mpdu
+	num = rtw_amsdu_adapt_decide(padapter, pattrib->psta, pattrib->priority, num_frame - 1, pattrib->pktlen);
 
-	pkt = pxmitframe->pkt;
-	_rtw_open_pktfile(pkt, &pktfile);
-	_rtw_pktfile_read(&pktfile, NULL, pattrib->pkt_hdrlen);
+	if (num > num_frame && ctl->timeout_ms) {
+		if (status == RTW_AMSDU_TIMER_UNSET) {
+			rtw_amsdu_set_timer_status(padapter, pattrib->priority, RTW_AMSDU_TIMER_SETTING);
+			rtw_amsdu_set_timer(padapter, pattrib->priority, ctl->timeout_ms);
+			pxmitpriv->amsdu_debug_set_timer++;
+		}
+		return 0;
+	}
 
-#ifdef CONFIG_RTW_MESH
-	if (MLME_IS_MESH(padapter)) {
-		/* mDA(6), mSA(6), len(2), mctrl */
-		_rtw_memcpy(pframe, pattrib->mda, ETH_ALEN);
-		pframe += ETH_ALEN;
-		_rtw_memcpy(pframe, pattrib->msa, ETH_ALEN);
-		pframe += ETH_ALEN;
-		len = (u16*)pframe;
-		pframe += 2;
-		rtw_mesh_tx_build_mctrl(padapter, pattrib, pframe);
-		pframe += XATTRIB_GET_MCTRL_LEN(pattrib);
-	} else
-#endif
-	{
-		/* 802.3 MAC Header  DA(6)  SA(6)  Len(2) */
-		_rtw_memcpy(pframe, pattrib->dst, ETH_ALEN);
-		pframe += ETH_ALEN;
-		_rtw_memcpy(pframe, pattrib->src, ETH_ALEN);
-		pframe += ETH_ALEN;
-		len = (u16*)pframe;
-		pframe += 2;
+	if (status == RTW_AMSDU_TIMER_SETTING) {
+		rtw_amsdu_cancel_timer(padapter, pattrib->priority);
+		rtw_amsdu_set_timer_status(padapter, pattrib->priority, RTW_AMSDU_TIMER_UNSET);
 	}
 
-	llc_sz = rtw_put_snap(pframe, pattrib->ether_type);
-	pframe += llc_sz;
+exit:
+	if (num <= 1) {
+		pxmitpriv->amsdu_debug_coalesce_one++;
+		rtw_amsdu_adapt_flush(padapter, pattrib->priority, 1, ctl->reason);
+	}
 
-	mem_sz = _rtw_pktfile_read(&pktfile, pframe, pattrib->pktlen);
+	return num;
+}
 
-	pframe += mem_sz;
+/* take up to max_num frames following pxmitframe in its station/AC queue to be its A-MSDU subframes */
+static u8 rtw_amsdu_dequeue_subframes(_adapter *padapter, struct xmit_frame *pxmitframe, struct xmit_frame **subframes, u8 max_num)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+	struct sta_info *psta = pattrib->psta;
+	struct tx_servq *ptxservq;
+	struct hw_xmit *phwxmit;
+	struct xmit_frame *psubframe;
+	_list *xmitframe_plist, *xmitframe_phead;
+	_irqL irqL;
+	u32 max_len, len;
+	u8 ac_index, num = 0;
 
-	*len = htons(XATTRIB_GET_MCTRL_LEN(pattrib) + llc_sz + mem_sz);
+	max_len = (le16_to_cpu(psta->htpriv.ht_cap.cap_info) & IEEE80211_HT_CAP_MAX_AMSDU) ?
+		RTW_AMSDU_MAX_LEN_8K : RTW_AMSDU_MAX_LEN_4K;
+	max_len = rtw_min(max_len, (u32)(MAX_XMITBUF_SZ - 2 * WLANHDR_OFFSET));
+	len = ETH_HLEN + XATTRIB_GET_MCTRL_LEN(pattrib) + SNAP_SIZE + sizeof(u16) + pattrib->pktlen;
 
-	//the last ampdu has no padding
-	padding = 0;
+	_enter_critical_bh(&pxmitpriv->lock, &irqL);
 
-	pattrib->nr_frags = 1;
+	ptxservq = rtw_get_sta_pending(padapter, psta, pattrib->priority, &ac_index);
+	phwxmit = pxmitpriv->hwxmits + ac_index;
 
-	pattrib->last_txcmdsz += ETH_HLEN + XATTRIB_GET_MCTRL_LEN(pattrib) + llc_sz + mem_sz + padding +
-		((pattrib->bswenc) ? pattrib->icv_len : 0) ;
+	xmitframe_phead = get_list_head(&ptxservq->sta_pending);
+	xmitframe_plist = get_next(xmitframe_phead);
 
-	if ((pattrib->icv_len > 0) && (pattrib->bswenc)) {
-		_rtw_memcpy(pframe, pattrib->icv, pattrib->icv_len);
-		pframe += pattrib->icv_len;
-	}
+	while (num < max_num && rtw_end_of_queue_search(xmitframe_phead, xmitframe_plist) == _FALSE) {
+		psubframe = LIST_CONTAINOR(xmitframe_plist, struct xmit_frame, list);
+		xmitframe_plist = get_next(xmitframe_plist);
 
-	if (xmitframe_addmic(padapter, pxmitframe) == _FAIL) {
-		RTW_INFO("xmitframe_addmic(padapter, pxmitframe)==_FAIL\n");
-		res = _FAIL;
-		goto exit;
+		if (psubframe->attrib.priority != pattrib->priority
+			|| check_amsdu(psubframe) == _FALSE)
+			break;
+
+		len = _RND4(len) + ETH_HLEN + XATTRIB_GET_MCTRL_LEN(&psubframe->attrib)
+			+ SNAP_SIZE + sizeof(u16) + psubframe->attrib.pktlen;
+		if (len > max_len)
+			break;
+
+		rtw_list_delete(&psubframe->list);
+		ptxservq->qcnt--;
+		phwxmit->accnt--;
+		subframes[num++] = psubframe;
 	}
 
-	xmitframe_swencrypt(padapter, pxmitframe);
+	if (num && _rtw_queue_empty(&ptxservq->sta_pending) == _TRUE)
+		rtw_list_delete(&ptxservq->tx_pending);
 
-	update_attrib_vcs_info(padapter, pxmitframe);
+	_exit_critical_bh(&pxmitpriv->lock, &irqL);
+
+	return num;
+}
+
+/*
+ * rtw_amsdu_coalesce_xframe - coalesce pxmitframe with up to num - 1 queued frames as an A-MSDU
+ * @num: return of rtw_amsdu_xmit_check()
+ * Falls back to rtw_xmitframe_coalesce() when no subframe can be taken.
+ * MSDUs of the subframes are completed and their xmitframes freed here.
+ */
+s32 rtw_amsdu_coalesce_xframe(_adapter *padapter, struct xmit_frame *pxmitframe, u8 num)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+	struct xmit_frame *subframes[RTW_AMSDU_ADAPT_MAX_NUM - 1];
+	struct rtw_amsdu_ctl *ctl;
+	u8 sub_num = 0, i;
+	s32 res;
+
+	if (num > 1 && pattrib->psta && check_amsdu(pxmitframe) == _TRUE)
+		sub_num = rtw_amsdu_dequeue_subframes(padapter, pxmitframe, subframes
+			, rtw_min(num, (u8)RTW_AMSDU_ADAPT_MAX_NUM) - 1);
+
+	if (!sub_num)
+		return rtw_xmitframe_coalesce(padapter, pxmitframe->pkt, pxmitframe);
+
+	res = rtw_xmitframe_coalesce_amsdu(padapter, pxmitframe, subframes, sub_num);
+
+	for (i = 0; i < sub_num; i++) {
+		rtw_os_xmit_complete(padapter, subframes[i]);
+		rtw_free_xmitframe(pxmitpriv, subframes[i]);
+	}
+
+	if (res == _SUCCESS) {
+		ctl = &pattrib->psta->sta_xmitpriv.amsdu_ctl[rtw_amsdu_prio_to_qidx(pattrib->priority)];
+		pxmitpriv->amsdu_debug_coalesce_two++;
+		rtw_amsdu_adapt_flush(padapter, pattrib->priority, sub_num + 1, ctl->reason);
+	}
 
-exit:
 	return res;
 }
 #endif /* CONFIG_TX_AMSDU */
@@ -3373,6 +3666,24 @@ s32 rtw_free_xmitbuf_ext(struct xmit_priv *pxmitpriv, struct xmit_buf *pxmitbuf)
 	return _SUCCESS;
 }
 
+/*
+ * Free xmitbufs are down to the VO/VI reservation and no VO/VI frame is pending,
+ * HCI should not take an xmitbuf for BE/BK frames now.
+ */
+bool rtw_xmitbuf_rsvd_blocked(struct xmit_priv *pxmitpriv)
+{
+	struct hw_xmit *phwxmits = pxmitpriv->hwxmits;
+	u8 ofs = pxmitpriv->hwxmit_entry - 4; /* hwxmits[0] is BMC when hwxmit_entry is 5 */
+
+	if (!pxmitpriv->xmitbuf_rsvd || pxmitpriv->free_xmitbuf_cnt > pxmitpriv->xmitbuf_rsvd)
+		return _FALSE;
+
+	if (phwxmits[ofs + VO_QUEUE_INX].accnt || phwxmits[ofs + VI_QUEUE_INX].accnt)
+		return _FALSE;
+
+	return _TRUE;
+}
+
 struct xmit_buf *rtw_alloc_xmitbuf(struct xmit_priv *pxmitpriv)
 {
 	_irqL irqL;
@@ -3486,6 +3797,7 @@ void rtw_init_xmitframe(struct xmit_frame *pxframe)
 		/* pxframe->attrib.psta = NULL; */
 
 		pxframe->frame_tag = DATA_FRAMETAG;
+		pxframe->ac_qidx = 0xFF;
 
 #ifdef CONFIG_USB_HCI
 		pxframe->pkt = NULL;
@@ -3524,7 +3836,51 @@ Otherwise, we must use _enter/_exit critical to protect free_xmit_queue...
 Must be very very cautious...
 
 */
-struct xmit_frame *rtw_alloc_xmitframe(struct xmit_priv *pxmitpriv)/* (_queue *pfree_xmit_queue) */
+/* caller must hold free_xmit_queue.lock */
+static u16 _rtw_xmitframe_ac_avail(struct xmit_priv *pxmitpriv, u8 qidx)
+{
+	u32 rsvd_other = 0;
+	u16 avail;
+	u8 i;
+
+	/* xmitframes reserved but not yet used by other ACs are not available */
+	for (i = 0; i < 4; i++) {
+		if (i == qidx)
+			continue;
+		if (pxmitpriv->xmitframe_ac_rsvd[i] > pxmitpriv->xmitframe_ac_cnt[i])
+			rsvd_other += pxmitpriv->xmitframe_ac_rsvd[i] - pxmitpriv->xmitframe_ac_cnt[i];
+	}
+
+	if (pxmitpriv->free_xmitframe_cnt <= rsvd_other)
+		return 0;
+	avail = pxmitpriv->free_xmitframe_cnt - rsvd_other;
+
+	if (qidx < 4 && pxmitpriv->xmitframe_ac_quota[qidx]) {
+		if (pxmitpriv->xmitframe_ac_cnt[qidx] >= pxmitpriv->xmitframe_ac_quota[qidx])
+			return 0;
+		avail = rtw_min(avail, pxmitpriv->xmitframe_ac_quota[qidx] - pxmitpriv->xmitframe_ac_cnt[qidx]);
+	}
+
+	return avail;
+}
+
+u16 rtw_xmitframe_ac_avail(struct xmit_priv *pxmitpriv, u8 qidx)
+{
+	_irqL irqL;
+	_queue *pfree_xmit_queue = &pxmitpriv->free_xmit_queue;
+	u16 avail;
+
+	if (qidx >= 4)
+		return pxmitpriv->free_xmitframe_cnt;
+
+	_enter_critical_bh(&pfree_xmit_queue->lock, &irqL);
+	avail = _rtw_xmitframe_ac_avail(pxmitpriv, qidx);
+	_exit_critical_bh(&pfree_xmit_queue->lock, &irqL);
+
+	return avail;
+}
+
+static struct xmit_frame *_rtw_alloc_xmitframe(struct xmit_priv *pxmitpriv, u8 qidx)
 {
 	/*
 		Please remember to use all the osdep_service api,
@@ -3542,6 +3898,8 @@ struct xmit_frame *rtw_alloc_xmitframe(struct xmit_priv *pxmitpriv)/* (_queue *p
 
 	if (_rtw_queue_empty(pfree_xmit_queue) == _TRUE) {
 		pxframe =  NULL;
+	} else if (qidx < 4 && _rtw_xmitframe_ac_avail(pxmitpriv, qidx) == 0) {
+		pxframe =  NULL;
 	} else {
 		phead = get_list_head(pfree_xmit_queue);
 
@@ -3551,16 +3909,34 @@ struct xmit_frame *rtw_alloc_xmitframe(struct xmit_priv *pxmitpriv)/* (_queue *p
 
 		rtw_list_delete(&(pxframe->list));
 		pxmitpriv->free_xmitframe_cnt--;
+		if (qidx < 4)
+			pxmitpriv->xmitframe_ac_cnt[qidx]++;
 	}
 
 	_exit_critical_bh(&pfree_xmit_queue->lock, &irqL);
 
 	rtw_init_xmitframe(pxframe);
+	if (pxframe && qidx < 4)
+		pxframe->ac_qidx = qidx;
 
 
 	return pxframe;
 }
 
+struct xmit_frame *rtw_alloc_xmitframe(struct xmit_priv *pxmitpriv)/* (_queue *pfree_xmit_queue) */
+{
+	return _rtw_alloc_xmitframe(pxmitpriv, 0xFF);
+}
+
+/*
+ * Allocate xmitframe charged to AC @qidx (XX_QUEUE_INX),
+ * fail if it would take xmitframes reserved by other ACs or exceed the AC quota
+ */
+struct xmit_frame *rtw_alloc_xmitframe_ac(struct xmit_priv *pxmitpriv, u8 qidx)
+{
+	return _rtw_alloc_xmitframe(pxmitpriv, qidx);
+}
+
 struct xmit_frame *rtw_alloc_xmitframe_ext(struct xmit_priv *pxmitpriv)
 {
 	_irqL irqL;
@@ -3655,6 +4031,9 @@ s32 rtw_free_xmitframe(struct xmit_priv *pxmitpriv, struct xmit_frame *pxmitfram
 	rtw_list_insert_tail(&pxmitframe->list, get_list_head(queue));
 	if (pxmitframe->ext_tag == 0) {
 		pxmitpriv->free_xmitframe_cnt++;
+		if (pxmitframe->ac_qidx < 4 && pxmitpriv->xmitframe_ac_cnt[pxmitframe->ac_qidx])
+			pxmitpriv->xmitframe_ac_cnt[pxmitframe->ac_qidx]--;
+		pxmitframe->ac_qidx = 0xFF;
 	} else if (pxmitframe->ext_tag == 1) {
 		pxmitpriv->free_xframe_ext_cnt++;
 	} else {
@@ -4549,6 +4928,7 @@ s32 rtw_xmit(_adapter *padapter, _pkt **ppkt)
 	static u32 drop_cnt = 0;
 	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
 	struct xmit_frame *pxmitframe = NULL;
+	u8 qidx;
 	s32 res;
 
 	DBG_COUNTER(padapter->tx_logs.core_tx);
@@ -4562,7 +4942,8 @@ s32 rtw_xmit(_adapter *padapter, _pkt **ppkt)
 	if (start == 0)
 		start = rtw_get_current_time();
 
-	pxmitframe = rtw_alloc_xmitframe(pxmitpriv);
+	qidx = rtw_os_pkt_qidx(*ppkt);
+	pxmitframe = rtw_alloc_xmitframe_ac(pxmitpriv, qidx);
 
 	if (rtw_get_passing_time_ms(start) > 2000) {
 		if (drop_cnt)
@@ -4573,11 +4954,17 @@ s32 rtw_xmit(_adapter *padapter, _pkt **ppkt)
 
 	if (pxmitframe == NULL) {
 		drop_cnt++;
+		if (qidx < 4)
+			pxmitpriv->tx_ac_drop[qidx]++;
 		/*RTW_INFO("%s-"ADPT_FMT" no more xmitframe\n", __func__, ADPT_ARG(padapter));*/
 		DBG_COUNTER(padapter->tx_logs.core_tx_err_pxmitframe);
 		return -1;
 	}
 
+#ifdef CONFIG_TX_CMPL_TRACK
+	rtw_tx_cmpl_sample(padapter, pxmitframe);
+#endif
+
 #ifdef CONFIG_BR_EXT
 	if (check_fwstate(&padapter->mlmepriv, WIFI_STATION_STATE | WIFI_ADHOC_STATE) == _TRUE) {
 		void *br_port = NULL;
@@ -4673,7 +5060,7 @@ sint xmitframe_enqueue_for_tdls_sleeping_sta(_adapter *padapter, struct xmit_fra
 
 			rtw_list_insert_tail(&pxmitframe->list, get_list_head(&ptdls_sta->sleep_q));
 
-			ptdls_sta->sleepq_len++;
+			rtw_sleepq_frame_in(ptdls_sta, pxmitframe);
 			ptdls_sta->sleepq_ac_len++;
 
 			/* indicate 4-AC queue bit in TDLS peer traffic indication */
@@ -4752,6 +5139,56 @@ inline bool xmitframe_hiq_filter(struct xmit_frame *xmitframe)
 
 #if defined(CONFIG_AP_MODE) || defined(CONFIG_TDLS)
 
+static u8 sleepq_trigger_enabled_ac(struct sta_info *psta, u8 priority)
+{
+	switch (priority) {
+	case 1:
+	case 2:
+		return psta->uapsd_bk & BIT(0);
+	case 4:
+	case 5:
+		return psta->uapsd_vi & BIT(0);
+	case 6:
+	case 7:
+		return psta->uapsd_vo & BIT(0);
+	case 0:
+	case 3:
+	default:
+		return psta->uapsd_be & BIT(0);
+	}
+}
+
+/*
+ * Drop oldest frames in psta->sleep_q until a frame of @len can be buffered
+ * within sleepq_max_len and sleepq_max_bytes
+ * caller must hold psta->sleep_q.lock
+ */
+static void sleepq_make_room(_adapter *padapter, struct sta_info *psta, u32 len, bool bmc)
+{
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	_list *phead = get_list_head(&psta->sleep_q);
+	struct xmit_frame *pxmitframe;
+
+	while ((pstapriv->sleepq_max_len && psta->sleepq_len >= pstapriv->sleepq_max_len)
+		|| (pstapriv->sleepq_max_bytes && psta->sleepq_bytes + len > pstapriv->sleepq_max_bytes)
+	) {
+		if (rtw_is_list_empty(phead))
+			break;
+
+		pxmitframe = LIST_CONTAINOR(get_next(phead), struct xmit_frame, list);
+		rtw_list_delete(&pxmitframe->list);
+		rtw_sleepq_frame_out(psta, pxmitframe);
+		if (!bmc && psta->sleepq_ac_len
+			&& sleepq_trigger_enabled_ac(psta, pxmitframe->attrib.priority))
+			psta->sleepq_ac_len--;
+
+		psta->sleepq_ovf_drop++;
+		pstapriv->sleepq_ovf_drop++;
+		rtw_free_xmitframe(pxmitpriv, pxmitframe);
+	}
+}
+
 sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *pxmitframe)
 {
 	_irqL irqL;
@@ -4819,13 +5256,15 @@ sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *p
 		if (rtw_tim_map_anyone_be_set(padapter, pstapriv->sta_dz_bitmap)) { /* if anyone sta is in ps mode */
 			/* pattrib->qsel = QSLT_HIGH; */ /* HIQ */
 
+			sleepq_make_room(padapter, psta, pattrib->pktlen, _TRUE);
+
 			rtw_list_delete(&pxmitframe->list);
 
 			/*_enter_critical_bh(&psta->sleep_q.lock, &irqL);*/
 
 			rtw_list_insert_tail(&pxmitframe->list, get_list_head(&psta->sleep_q));
 
-			psta->sleepq_len++;
+			rtw_sleepq_frame_in(psta, pxmitframe);
 
 			if (!(rtw_tim_map_is_set(padapter, pstapriv->tim_bitmap, 0)))
 				update_tim = _TRUE;
@@ -4863,33 +5302,17 @@ sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *p
 		u8 wmmps_ac = 0;
 
 		if (rtw_tim_map_is_set(padapter, pstapriv->sta_dz_bitmap, psta->cmn.aid)) {
+			sleepq_make_room(padapter, psta, pattrib->pktlen, _FALSE);
+
 			rtw_list_delete(&pxmitframe->list);
 
 			/* _enter_critical_bh(&psta->sleep_q.lock, &irqL);	 */
 
 			rtw_list_insert_tail(&pxmitframe->list, get_list_head(&psta->sleep_q));
 
-			psta->sleepq_len++;
+			rtw_sleepq_frame_in(psta, pxmitframe);
 
-			switch (pattrib->priority) {
-			case 1:
-			case 2:
-				wmmps_ac = psta->uapsd_bk & BIT(0);
-				break;
-			case 4:
-			case 5:
-				wmmps_ac = psta->uapsd_vi & BIT(0);
-				break;
-			case 6:
-			case 7:
-				wmmps_ac = psta->uapsd_vo & BIT(0);
-				break;
-			case 0:
-			case 3:
-			default:
-				wmmps_ac = psta->uapsd_be & BIT(0);
-				break;
-			}
+			wmmps_ac = sleepq_trigger_enabled_ac(psta, pattrib->priority);
 
 			if (wmmps_ac)
 				psta->sleepq_ac_len++;
@@ -5068,7 +5491,7 @@ void wakeup_sta_to_xmit(_adapter *padapter, struct sta_info *psta)
 			break;
 		}
 
-		psta->sleepq_len--;
+		rtw_sleepq_frame_out(psta, pxmitframe);
 		if (psta->sleepq_len > 0)
 			pxmitframe->attrib.mdata = 1;
 		else
@@ -5126,7 +5549,7 @@ void wakeup_sta_to_xmit(_adapter *padapter, struct sta_info *psta)
 
 		if (psta->state & WIFI_STA_ALIVE_CHK_STATE) {
 			RTW_INFO("%s alive check\n", __func__);
-			psta->expire_to = pstapriv->expire_to;
+			rtw_sta_expire_arm(pstapriv, psta, pstapriv->expire_to);
 			psta->state ^= WIFI_STA_ALIVE_CHK_STATE;
 		}
 
@@ -5148,7 +5571,7 @@ void wakeup_sta_to_xmit(_adapter *padapter, struct sta_info *psta)
 
 			rtw_list_delete(&pxmitframe->list);
 
-			psta_bmc->sleepq_len--;
+			rtw_sleepq_frame_out(psta_bmc, pxmitframe);
 			if (psta_bmc->sleepq_len > 0)
 				pxmitframe->attrib.mdata = 1;
 			else
@@ -5246,7 +5669,7 @@ void xmit_delivery_enabled_frames(_adapter *padapter, struct sta_info *psta)
 
 		rtw_list_delete(&pxmitframe->list);
 
-		psta->sleepq_len--;
+		rtw_sleepq_frame_out(psta, pxmitframe);
 		psta->sleepq_ac_len--;
 
 		if (psta->sleepq_ac_len > 0) {
@@ -5666,7 +6089,7 @@ void rtw_amsdu_set_timer_status(_adapter *padapter, u8 priority, u8 status)
 	}
 }
 
-void rtw_amsdu_set_timer(_adapter *padapter, u8 priority)
+void rtw_amsdu_set_timer(_adapter *padapter, u8 priority, u8 timeout_ms)
 {
 	struct xmit_priv        *pxmitpriv = &padapter->xmitpriv;
 
@@ -5692,7 +6115,7 @@ void rtw_amsdu_set_timer(_adapter *padapter, u8 priority)
 			amsdu_timer = &pxmitpriv->amsdu_be_timer;
 			break;
 	}
-	_set_timer(amsdu_timer, 1);
+	_set_timer(amsdu_timer, timeout_ms);
 }
 
 void rtw_amsdu_cancel_timer(_adapter *padapter, u8 priority)
@@ -5779,6 +6202,19 @@ void rtw_sctx_init(struct submit_ctx *sctx, int timeout_ms)
 	init_completion(&sctx->done);
 #endif
 	sctx->status = RTW_SCTX_SUBMITTED;
+	sctx->done_cb = NULL;
+	sctx->cb_priv = NULL;
+}
+
+/*
+ * rtw_sctx_init_async - init sctx whose done_cb is called on done instead of waking waiter
+ * done_cb may be called in interrupt, tasklet or timer context, it must not sleep
+ */
+void rtw_sctx_init_async(struct submit_ctx *sctx, int timeout_ms, void (*done_cb)(void *priv, int status), void *cb_priv)
+{
+	rtw_sctx_init(sctx, timeout_ms);
+	sctx->done_cb = done_cb;
+	sctx->cb_priv = cb_priv;
 }
 
 int rtw_sctx_wait(struct submit_ctx *sctx, const char *msg)
@@ -5820,14 +6256,19 @@ bool rtw_sctx_chk_waring_status(int status)
 
 void rtw_sctx_done_err(struct submit_ctx **sctx, int status)
 {
-	if (*sctx) {
+	struct submit_ctx *done = *sctx;
+
+	if (done) {
 		if (rtw_sctx_chk_waring_status(status))
 			RTW_INFO("%s status:%d\n", __func__, status);
-		(*sctx)->status = status;
+		done->status = status;
+		*sctx = NULL;
+		if (done->done_cb)
+			done->done_cb(done->cb_priv, status);
 #ifdef PLATFORM_LINUX
-		complete(&((*sctx)->done));
+		else
+			complete(&done->done);
 #endif
-		*sctx = NULL;
 	}
 }
 
@@ -5848,13 +6289,325 @@ int rtw_ack_tx_wait(struct xmit_priv *pxmitpriv, u32 timeout_ms)
 	return rtw_sctx_wait(pack_tx_ops, __func__);
 }
 
+static void rtw_ack_tx_async_done(struct xmit_priv *pxmitpriv, int status)
+{
+	void (*done_cb)(void *priv, int status) = NULL;
+	void *cb_priv = NULL;
+	_irqL irqL;
+	u8 bcancelled;
+
+	/* take done_cb out, ack_tx_ops may be claimed again by done_cb */
+	_enter_critical(&pxmitpriv->lock_sctx, &irqL);
+	if (pxmitpriv->ack_tx_async) {
+		done_cb = pxmitpriv->ack_tx_ops.done_cb;
+		cb_priv = pxmitpriv->ack_tx_ops.cb_priv;
+		pxmitpriv->ack_tx_ops.status = status;
+		pxmitpriv->ack_tx_async = _FALSE;
+		pxmitpriv->ack_tx = _FALSE;
+#ifdef PLATFORM_LINUX
+		complete_all(&pxmitpriv->ack_tx_free);
+#endif
+	}
+	_exit_critical(&pxmitpriv->lock_sctx, &irqL);
+
+	if (!done_cb)
+		return;
+
+	if (status != RTW_SCTX_DONE_TIMEOUT)
+		_cancel_timer(&pxmitpriv->ack_tx_timer, &bcancelled);
+	if (rtw_sctx_chk_waring_status(status))
+		RTW_INFO("%s status:%d\n", __func__, status);
+	done_cb(cb_priv, status);
+}
+
+void rtw_ack_tx_timeout_hdl(void *ctx)
+{
+	struct xmit_priv *pxmitpriv = (struct xmit_priv *)ctx;
+	u32 pass_ms;
+
+	if (!pxmitpriv->ack_tx_async)
+		return;
+
+	/* timer of previous waiter not cancelled in time */
+	pass_ms = rtw_get_passing_time_ms(pxmitpriv->ack_tx_ops.submit_time);
+	if (pass_ms < pxmitpriv->ack_tx_ops.timeout_ms) {
+		_set_timer(&pxmitpriv->ack_tx_timer, pxmitpriv->ack_tx_ops.timeout_ms - pass_ms);
+		return;
+	}
+
+	rtw_ack_tx_async_done(pxmitpriv, RTW_SCTX_DONE_TIMEOUT);
+}
+
 void rtw_ack_tx_done(struct xmit_priv *pxmitpriv, int status)
 {
 	struct submit_ctx *pack_tx_ops = &pxmitpriv->ack_tx_ops;
 
-	if (pxmitpriv->ack_tx)
+	if (pxmitpriv->ack_tx_async)
+		rtw_ack_tx_async_done(pxmitpriv, status);
+	else if (pxmitpriv->ack_tx)
 		rtw_sctx_done_err(&pack_tx_ops, status);
 	else
 		RTW_INFO("%s ack_tx not set\n", __func__);
 }
+
+/*
+ * rtw_ack_tx_claim - claim ack report for synchronous waiter
+ * caller holds ack_tx_mutex, and sleeps here until asynchronous waiter releases
+ * the ack report, up to timeout_ms. ack_tx_free is re-armed under lock_sctx
+ * before sleeping, so a release after the check always wakes the caller.
+ */
+int rtw_ack_tx_claim(struct xmit_priv *pxmitpriv, u32 timeout_ms)
+{
+	systime start = rtw_get_current_time();
+	u32 pass_ms;
+	_irqL irqL;
+	int ret = _FAIL;
+
+	while (1) {
+		_enter_critical(&pxmitpriv->lock_sctx, &irqL);
+		if (!pxmitpriv->ack_tx) {
+			pxmitpriv->ack_tx = _TRUE;
+			rtw_sctx_init(&pxmitpriv->ack_tx_ops, timeout_ms);
+			ret = _SUCCESS;
+		}
+#ifdef PLATFORM_LINUX
+		else
+			init_completion(&pxmitpriv->ack_tx_free);
+#endif
+		_exit_critical(&pxmitpriv->lock_sctx, &irqL);
+
+		if (ret == _SUCCESS)
+			break;
+
+		/* done_cb of asynchronous waiter may claim it again, check again after wake up */
+		pass_ms = rtw_get_passing_time_ms(start);
+		if (pass_ms >= timeout_ms)
+			break;
+#ifdef PLATFORM_LINUX
+		wait_for_completion_timeout(&pxmitpriv->ack_tx_free, msecs_to_jiffies(timeout_ms - pass_ms));
+#else
+		rtw_msleep_os(1);
+#endif
+	}
+
+	return ret;
+}
+
+/*
+ * rtw_ack_tx_claim_async - claim ack report for asynchronous waiter
+ * done_cb is called by rtw_ack_tx_done() or after timeout_ms, return _FAIL if ack report is in use
+ */
+int rtw_ack_tx_claim_async(struct xmit_priv *pxmitpriv, u32 timeout_ms
+	, void (*done_cb)(void *priv, int status), void *cb_priv)
+{
+	_irqL irqL;
+	int ret = _FAIL;
+
+	_enter_critical(&pxmitpriv->lock_sctx, &irqL);
+	if (!pxmitpriv->ack_tx) {
+		pxmitpriv->ack_tx = _TRUE;
+		pxmitpriv->ack_tx_async = _TRUE;
+		rtw_sctx_init_async(&pxmitpriv->ack_tx_ops, timeout_ms, done_cb, cb_priv);
+		ret = _SUCCESS;
+	}
+	_exit_critical(&pxmitpriv->lock_sctx, &irqL);
+
+	if (ret == _SUCCESS)
+		_set_timer(&pxmitpriv->ack_tx_timer, timeout_ms);
+
+	return ret;
+}
+
+/*
+ * rtw_ack_tx_cancel - stop ack report timer, e.g. when the driver stops
+ * pending asynchronous waiter is completed with RTW_SCTX_DONE_DRV_STOP
+ */
+void rtw_ack_tx_cancel(struct xmit_priv *pxmitpriv)
+{
+	_cancel_timer_ex(&pxmitpriv->ack_tx_timer);
+	rtw_ack_tx_async_done(pxmitpriv, RTW_SCTX_DONE_DRV_STOP);
+}
+
+void rtw_ack_tx_release(struct xmit_priv *pxmitpriv)
+{
+	_irqL irqL;
+
+	_enter_critical(&pxmitpriv->lock_sctx, &irqL);
+	pxmitpriv->ack_tx = _FALSE;
+#ifdef PLATFORM_LINUX
+	complete_all(&pxmitpriv->ack_tx_free);
+#endif
+	_exit_critical(&pxmitpriv->lock_sctx, &irqL);
+}
+
+#ifdef CONFIG_TX_CMPL_TRACK
+/* mark 1 of every tx_cmpl_sample data frames for TX completion tracking */
+void rtw_tx_cmpl_sample(_adapter *padapter, struct xmit_frame *pxmitframe)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+
+	if (!pxmitpriv->tx_cmpl_sample)
+		return;
+
+	if (++pxmitpriv->tx_cmpl_cnt < pxmitpriv->tx_cmpl_sample)
+		return;
+
+	pxmitpriv->tx_cmpl_cnt = 0;
+	pxmitframe->attrib.enq_us = rtw_get_current_time_us();
+}
+
+/*
+ * rtw_tx_cmpl_track_push - queue a sampled frame to wait for its TX report
+ * Called by HAL when filling the TX descriptor of a data frame,
+ * after rtw_host_ra_select() if host RA is compiled in,
+ * and of an AP active keep alive null data, which shares the macid's reports.
+ * Returns: _TRUE if HAL should request TX report for this frame
+ */
+bool rtw_tx_cmpl_track_push(_adapter *padapter, struct xmit_frame *pxmitframe)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+	struct sta_info *psta = pattrib->psta;
+	struct tx_cmpl_track *track;
+	_irqL irqL;
+	bool ret = _FALSE;
+#ifdef CONFIG_RTW_HOST_RA
+	bool hra_rpt = (pattrib->hra_flags & HOST_RA_F_RPT) ? _TRUE : _FALSE;
+#else
+	bool hra_rpt = _FALSE;
+#endif
+
+	if (pattrib->aka_probe) {
+		/* mgnt frame, STA is known by macid only */
+		if (pattrib->mac_id < adapter_to_macidctl(padapter)->num)
+			psta = adapter_to_macidctl(padapter)->sta[pattrib->mac_id];
+	} else {
+		if ((!pattrib->enq_us && !hra_rpt) || IS_MCAST(pattrib->ra))
+			return _FALSE;
+
+		/* the report of this frame belongs to rtw_ack_tx_wait() */
+		if (pxmitframe->ack_report)
+			return _FALSE;
+	}
+
+	if (!psta)
+		return _FALSE;
+
+	track = &psta->tx_cmpl;
+
+	_enter_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+	if (((track->tail + 1) & (TX_CMPL_FIFO_SZ - 1)) == track->head) {
+		if (pattrib->enq_us)
+			track->overflow++;
+	} else {
+		track->enq_us[track->tail] = pattrib->aka_probe ? 0 : pattrib->enq_us;
+		track->flags[track->tail] = pattrib->aka_probe ? TX_CMPL_F_AKA : 0;
+		track->push_time[track->tail] = rtw_get_current_time();
+#ifdef CONFIG_RTW_HOST_RA
+		track->hra_rate[track->tail] = (hra_rpt && !pattrib->aka_probe) ? pattrib->hra_rate : HOST_RA_RATE_NONE;
+		track->hra_flags[track->tail] = pattrib->hra_flags;
+#endif
+		track->tail = (track->tail + 1) & (TX_CMPL_FIFO_SZ - 1);
+		ret = _TRUE;
+	}
+	_exit_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+
+	return ret;
+}
+
+/*
+ * rtw_tx_cmpl_track_report - account a TX report of data frame
+ * Reports of a macid come back in TX order, so the oldest outstanding
+ * frame of the station is the one being reported. If it's an active keep
+ * alive null data, the report is passed to rtw_ap_aka_probe_report().
+ * A lost report would shift every later match by one, so outstanding
+ * frames older than TX_CMPL_RPT_TO_MS are dropped before matching.
+ * Returns: _SUCCESS if consumed by tracker, _FAIL if no tracked frame is outstanding
+ */
+s32 rtw_tx_cmpl_track_report(_adapter *padapter, u8 mac_id, bool ok, u8 retry_cnt, u8 final_rate)
+{
+	struct dvobj_priv *dvobj = adapter_to_dvobj(padapter);
+	struct macid_ctl_t *macid_ctl = dvobj_to_macidctl(dvobj);
+	struct sta_info *psta;
+	struct tx_cmpl_track *track;
+	struct xmit_priv *pxmitpriv;
+	_irqL irqL;
+	u64 enq_us;
+	u64 lat_us;
+	u8 flags = 0;
+	s32 ret = _FAIL;
+
+	if (mac_id >= macid_ctl->num)
+		return _FAIL;
+
+	psta = macid_ctl->sta[mac_id];
+	if (!psta)
+		return _FAIL;
+
+	pxmitpriv = &psta->padapter->xmitpriv;
+	track = &psta->tx_cmpl;
+
+	_enter_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+	while (track->head != track->tail
+		&& rtw_get_passing_time_ms(track->push_time[track->head]) > TX_CMPL_RPT_TO_MS) {
+		track->head = (track->head + 1) & (TX_CMPL_FIFO_SZ - 1);
+		track->lost++;
+	}
+
+	if (track->head == track->tail)
+		goto exit;
+
+	enq_us = track->enq_us[track->head];
+	flags = track->flags[track->head];
+#ifdef CONFIG_RTW_HOST_RA
+	if (track->hra_rate[track->head] != HOST_RA_RATE_NONE)
+		rtw_host_ra_report(psta, track->hra_rate[track->head], track->hra_flags[track->head]
+			, ok, retry_cnt, final_rate);
+#endif
+	track->head = (track->head + 1) & (TX_CMPL_FIFO_SZ - 1);
+
+	/* queued only for host RA, not sampled for tracking */
+	if (!enq_us) {
+		ret = _SUCCESS;
+		goto exit;
+	}
+
+	lat_us = rtw_get_current_time_us() - enq_us;
+	if (lat_us > 0xFFFFFFFF)
+		lat_us = 0xFFFFFFFF;
+	if ((u32)lat_us > track->lat_max_us)
+		track->lat_max_us = (u32)lat_us;
+
+	if (ok)
+		track->ok++;
+	else
+		track->fail++;
+	track->lat_hist[rtw_log2_bucket((u32)lat_us, TX_CMPL_LAT_HIST_NUM)]++;
+	track->retry_hist[rtw_min(retry_cnt, TX_CMPL_RETRY_HIST_NUM - 1)]++;
+	if (final_rate < TX_CMPL_RATE_NUM)
+		track->rate_cnt[final_rate]++;
+
+	ret = _SUCCESS;
+
+exit:
+	_exit_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+
+#ifdef CONFIG_AP_MODE
+	if (flags & TX_CMPL_F_AKA)
+		rtw_ap_aka_probe_report(psta->padapter, mac_id, ok);
+#endif
+
+	return ret;
+}
+
+void rtw_tx_cmpl_track_reset(struct sta_info *psta)
+{
+	struct xmit_priv *pxmitpriv = &psta->padapter->xmitpriv;
+	_irqL irqL;
+
+	_enter_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+	_rtw_memset(&psta->tx_cmpl, 0, sizeof(psta->tx_cmpl));
+	_exit_critical_bh(&pxmitpriv->tx_cmpl_lock, &irqL);
+}
+#endif /* CONFIG_TX_CMPL_TRACK */
 #endif /* CONFIG_XMIT_ACK */
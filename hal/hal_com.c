@@ -8539,14 +8539,14 @@ void rtw_hal_set_wow_fw_rsvd_page(_adapter *adapter, u8 *pframe, u16 index,
 
 		/* if the ap staion info. exists, get the kek, kck from staion info. */
 		psta = rtw_get_stainfo(pstapriv, get_bssid(pmlmepriv));
-		if (psta == NULL) {
+		if (psta == NULL || psta->cold == NULL) {
 			_rtw_memset(kek, 0, RTW_KEK_LEN);
 			_rtw_memset(kck, 0, RTW_KCK_LEN);
 			RTW_INFO("%s, KEK, KCK download rsvd page all zero\n",
 				 __func__);
 		} else {
-			_rtw_memcpy(kek, psta->kek, RTW_KEK_LEN);
-			_rtw_memcpy(kck, psta->kck, RTW_KCK_LEN);
+			_rtw_memcpy(kek, psta->cold->kek, RTW_KEK_LEN);
+			_rtw_memcpy(kck, psta->cold->kck, RTW_KCK_LEN);
 		}
 
 		/* 3 KEK, KCK */
@@ -13477,6 +13477,95 @@ void rtw_hal_ch_sw_iqk_info_restore(_adapter *padapter, u8 ch_sw_use_case)
 	rtw_hal_set_hwreg(padapter, HW_VAR_CH_SW_IQK_INFO_RESTORE, &ch_sw_use_case);
 }
 
+#ifdef CONFIG_RTW_IQK_CACHE
+/*
+* IQK result cache, keyed on (channel, bw) and valid while thermal meter stays
+* within thermal_th of the value when calibrated, the same drift power tracking
+* redoes IQK for. HAL decides when to search and how to apply a result.
+*/
+struct hal_iqk_cache_ent *rtw_hal_iqk_cache_search(_adapter *adapter, u8 ch, u8 bw, u8 thermal, u8 thermal_th)
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
+	struct hal_iqk_cache_ent *ent;
+	u8 i;
+
+	for (i = 0; i < IQK_CACHE_ENT_NUM; i++) {
+		ent = &hal_data->iqk_cache[i];
+		if (ent->ch == 0 || ent->ch != ch || ent->bw != bw)
+			continue;
+
+		if ((ent->thermal > thermal ? ent->thermal - thermal : thermal - ent->thermal) < thermal_th) {
+			hal_data->iqk_cache_hit++;
+			return ent;
+		}
+
+		/* drifted, calibrate again */
+		ent->ch = 0;
+		break;
+	}
+
+	hal_data->iqk_cache_miss++;
+	return NULL;
+}
+
+void rtw_hal_iqk_cache_add(_adapter *adapter, u8 ch, u8 bw, u8 thermal, const s32 *result)
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
+	struct hal_iqk_cache_ent *ent = NULL;
+	u8 i;
+
+	/* overwrite the same (ch, bw), or take an empty one */
+	for (i = 0; i < IQK_CACHE_ENT_NUM; i++) {
+		if (hal_data->iqk_cache[i].ch == ch && hal_data->iqk_cache[i].bw == bw) {
+			ent = &hal_data->iqk_cache[i];
+			break;
+		}
+		if (!ent && hal_data->iqk_cache[i].ch == 0)
+			ent = &hal_data->iqk_cache[i];
+	}
+
+	/* else, round robin */
+	if (!ent) {
+		ent = &hal_data->iqk_cache[hal_data->iqk_cache_next];
+		hal_data->iqk_cache_next = (hal_data->iqk_cache_next + 1) % IQK_CACHE_ENT_NUM;
+	}
+
+	ent->ch = ch;
+	ent->bw = bw;
+	ent->thermal = thermal;
+	_rtw_memcpy(ent->result, result, sizeof(ent->result));
+}
+
+void rtw_hal_iqk_cache_flush(_adapter *adapter)
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
+
+	_rtw_memset(hal_data->iqk_cache, 0, sizeof(hal_data->iqk_cache));
+	hal_data->iqk_cache_next = 0;
+}
+
+void dump_iqk_cache(void *sel, _adapter *adapter)
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
+	struct hal_iqk_cache_ent *ent;
+	u8 i;
+
+	RTW_PRINT_SEL(sel, "mode:%u hit:%u miss:%u\n"
+		, adapter->registrypriv.iqk_cache, hal_data->iqk_cache_hit, hal_data->iqk_cache_miss);
+
+	for (i = 0; i < IQK_CACHE_ENT_NUM; i++) {
+		ent = &hal_data->iqk_cache[i];
+		if (ent->ch == 0)
+			continue;
+
+		RTW_PRINT_SEL(sel, "ch:%3u %-4s thermal:0x%02x TX0:0x%03x/0x%03x RX0:0x%03x/0x%03x TX1:0x%03x/0x%03x RX1:0x%03x/0x%03x\n"
+			, ent->ch, ch_width_str(ent->bw), ent->thermal
+			, ent->result[0], ent->result[1], ent->result[2], ent->result[3]
+			, ent->result[4], ent->result[5], ent->result[6], ent->result[7]);
+	}
+}
+#endif /* CONFIG_RTW_IQK_CACHE */
+
 void rtw_dump_mac_rx_counters(_adapter *padapter, struct dbg_rx_counter *rx_counter)
 {
 	u32	mac_cck_ok = 0, mac_ofdm_ok = 0, mac_ht_ok = 0, mac_vht_ok = 0;
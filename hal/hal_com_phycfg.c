@@ -3674,6 +3674,114 @@ phy_set_tx_power_limit(
 #endif
 }
 
+#ifdef CONFIG_TXPWR_IDX_CACHE
+/*
+* TX power index cache
+* Base, by-rate and limit part of TX power index only depends on the tables loaded and
+* the (path, bw, channel) set to HW, so it's resolved once per rate section and kept.
+* Power tracking offset changes at runtime and is applied on every lookup.
+* Invalidate by phy_txpwr_idx_cache_invalidate() when the tables are reloaded,
+* regulation change is detected by regd_name.
+*/
+void phy_txpwr_idx_cache_invalidate(_adapter *adapter)
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
+
+	_rtw_memset(hal_data->txpwr_idx_cache_valid, 0, sizeof(hal_data->txpwr_idx_cache_valid));
+}
+
+static int phy_txpwr_idx_cache_ent(HAL_DATA_TYPE *hal_data, enum channel_width bw, u8 cch)
+{
+	if (hal_data->current_band_type != BAND_ON_2_4G
+		|| cch < 1 || cch > CENTER_CH_2G_NUM)
+		return -1;
+
+	if (bw == CHANNEL_WIDTH_20) {
+		if (hal_data->cch_20 == cch)
+			return cch - 1;
+	} else if (bw == CHANNEL_WIDTH_40) {
+		if (hal_data->cch_40 != cch)
+			return -1;
+		if (hal_data->cch_20 + 2 == cch)
+			return CENTER_CH_2G_NUM + (cch - 1) * 2;
+		if (hal_data->cch_20 == cch + 2)
+			return CENTER_CH_2G_NUM + (cch - 1) * 2 + 1;
+	}
+
+	return -1;
+}
+
+static u8 phy_txpwr_idx_cache_rs(u8 hw_rate)
+{
+	if (hw_rate <= DESC_RATE11M)
+		return CCK;
+	if (hw_rate <= DESC_RATE54M)
+		return OFDM;
+	if (hw_rate <= DESC_RATEMCS7)
+		return HT_MCS0_MCS7;
+	return HT_MCS8_MCS15;
+}
+
+/*
+* return _TRUE and power index in *power_idx if the request can be served by cache
+* MP mode and settings other than current 2.4G channel are left to the HAL
+*/
+static bool phy_txpwr_idx_cache_get(_adapter *adapter, enum rf_path rfpath
+	, u8 rate, enum channel_width bw, u8 cch, u8 *power_idx)
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
+	struct hal_spec_t *hal_spec = GET_HAL_SPEC(adapter);
+	struct rf_ctl_t *rfctl = adapter_to_rfctl(adapter);
+	struct txpwr_idx_comp tic;
+	u8 hw_rate = MRateToHwRate(rate);
+	u8 rs, i;
+	int ent;
+	s16 idx;
+
+	if (rfpath >= TXPWR_IDX_CACHE_PATH_NUM || hw_rate >= TXPWR_IDX_CACHE_RATE_NUM)
+		return _FALSE;
+#ifdef CONFIG_MP_INCLUDED
+	if (rtw_mp_mode_check(adapter) == _TRUE)
+		return _FALSE;
+#endif
+	/* HAL resolves limit by current setting, not the arguments */
+	if (bw != hal_data->current_channel_bw || cch != hal_data->current_channel)
+		return _FALSE;
+
+	ent = phy_txpwr_idx_cache_ent(hal_data, bw, cch);
+	if (ent < 0)
+		return _FALSE;
+
+	if (hal_data->txpwr_idx_cache_regd != rfctl->regd_name) {
+		phy_txpwr_idx_cache_invalidate(adapter);
+		hal_data->txpwr_idx_cache_regd = rfctl->regd_name;
+	}
+
+	rs = phy_txpwr_idx_cache_rs(hw_rate);
+	if (!(hal_data->txpwr_idx_cache_valid[rfpath][ent] & BIT(rs))) {
+		for (i = 0; i < rates_by_sections[rs].rate_num; i++) {
+			rtw_hal_get_tx_power_index(adapter, rfpath, rates_by_sections[rs].rates[i], bw, cch, &tic);
+			hal_data->txpwr_idx_cache[rfpath][ent][MRateToHwRate(rates_by_sections[rs].rates[i])]
+				= tic.base + (tic.by_rate > tic.limit ? tic.limit : tic.by_rate) + tic.ebias;
+		}
+		hal_data->txpwr_idx_cache_valid[rfpath][ent] |= BIT(rs);
+		hal_data->txpwr_idx_cache_miss++;
+	} else
+		hal_data->txpwr_idx_cache_hit++;
+
+	idx = hal_data->txpwr_idx_cache[rfpath][ent][hw_rate]
+		+ PHY_GetTxPowerTrackingOffset(adapter, rfpath, rate);
+
+	if (idx < 0)
+		idx = 0;
+	else if (idx > hal_spec->txgi_max)
+		idx = hal_spec->txgi_max;
+
+	*power_idx = (u8)idx;
+	return _TRUE;
+}
+#endif /* CONFIG_TXPWR_IDX_CACHE */
+
 u8
 phy_get_tx_power_index(
 	IN	PADAPTER			pAdapter,
@@ -3683,6 +3791,13 @@ phy_get_tx_power_index(
 	IN	u8					Channel
 )
 {
+#ifdef CONFIG_TXPWR_IDX_CACHE
+	u8 power_idx;
+
+	if (phy_txpwr_idx_cache_get(pAdapter, RFPath, Rate, BandWidth, Channel, &power_idx) == _TRUE)
+		return power_idx;
+#endif
+
 	return rtw_hal_get_tx_power_index(pAdapter, RFPath, Rate, BandWidth, Channel, NULL);
 }
 
@@ -3757,6 +3872,11 @@ void dump_tx_power_idx(void *sel, _adapter *adapter)
 	for (rfpath = RF_PATH_A; rfpath < RF_PATH_MAX; rfpath++)
 		for (rs = CCK; rs < RATE_SECTION_NUM; rs++)
 			dump_tx_power_idx_by_path_rs(sel, adapter, rfpath, rs);
+
+#ifdef CONFIG_TXPWR_IDX_CACHE
+	RTW_PRINT_SEL(sel, "idx cache hit:%u, miss:%u\n"
+		, GET_HAL_DATA(adapter)->txpwr_idx_cache_hit, GET_HAL_DATA(adapter)->txpwr_idx_cache_miss);
+#endif
 }
 
 bool phy_is_tx_power_limit_needed(_adapter *adapter)
@@ -3896,6 +4016,10 @@ void phy_load_tx_power_ext_info(_adapter *adapter, u8 chk_file)
 	if (phy_is_tx_power_limit_needed(adapter))
 		phy_load_tx_power_limit(adapter, chk_file);
 #endif
+
+#ifdef CONFIG_TXPWR_IDX_CACHE
+	phy_txpwr_idx_cache_invalidate(adapter);
+#endif
 }
 
 inline void phy_reload_tx_power_ext_info(_adapter *adapter)
@@ -4243,6 +4367,186 @@ phy_ConfigBBWithParaFile(
 	return rtStatus;
 }
 
+/*
+* Parsing PHY_REG_PG.txt and TXPWR_LMT.txt scans strings line by line on every HAL init.
+* With rtw_phy_file_bin=2, the parsed result is stored as <name>.bin next to the text file,
+* and later loads take <name>.bin with validation and memcpy instead.
+* A binary not matching version, chip txgi, checksum, or length and checksum of
+* the current text file is ignored and text file is parsed.
+*/
+static u8 phy_para_bin_get_path(_adapter *adapter, const char *file_name)
+{
+	char *ext;
+
+	rtw_get_phy_file_path(adapter, file_name);
+
+	ext = strrchr(rtw_phy_para_file_path, '.');
+	if (!ext || ext + strlen(".bin") >= rtw_phy_para_file_path + PATH_LENGTH_MAX)
+		return _FALSE;
+
+	_rtw_memcpy(ext, ".bin", strlen(".bin") + 1);
+	return _TRUE;
+}
+
+static u32 phy_para_bin_csum(const u8 *buf, u32 len)
+{
+	u32 csum = 0;
+
+	while (len--)
+		csum += *buf++;
+
+	return csum;
+}
+
+static u8 phy_para_bin_chk(_adapter *adapter, const char *buf, u32 len, u8 type, struct phy_para_bin_hdr *hdr)
+{
+	struct hal_spec_t *hal_spec = GET_HAL_SPEC(adapter);
+
+	if (len < sizeof(*hdr))
+		return _FALSE;
+
+	/* buf may be unaligned */
+	_rtw_memcpy(hdr, buf, sizeof(*hdr));
+
+	if (hdr->magic != PHY_PARA_BIN_MAGIC)
+		return _FALSE;
+
+	if (hdr->ver != PHY_PARA_BIN_VER || hdr->type != type
+		|| hdr->txgi_max != hal_spec->txgi_max || hdr->txgi_pdbm != hal_spec->txgi_pdbm
+	) {
+		RTW_WARN("%s mismatch, ver:%u type:%u txgi_max:%u txgi_pdbm:%u\n", __func__
+			, hdr->ver, hdr->type, hdr->txgi_max, hdr->txgi_pdbm);
+		return _FALSE;
+	}
+
+	if (hdr->len > len - sizeof(*hdr)
+		|| phy_para_bin_csum(buf + sizeof(*hdr), hdr->len) != hdr->csum
+	) {
+		RTW_WARN("%s corrupted, len:%u/%u\n", __func__, hdr->len, len);
+		return _FALSE;
+	}
+
+	return _TRUE;
+}
+
+/*
+* para_file_buf holds text file of src_len read from file system,
+* replace it with <name>.bin if that's a valid binary of the type parsed from the same text
+* return length of para_file_buf content
+*/
+static int phy_para_bin_retrieve(_adapter *adapter, const char *file_name, u8 type, int src_len, u32 *src_csum)
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
+	struct phy_para_bin_hdr hdr;
+	u8 *buf;
+	int rlen;
+
+	*src_csum = phy_para_bin_csum(hal_data->para_file_buf, src_len);
+
+	if (!adapter->registrypriv.phy_file_bin)
+		return src_len;
+
+	if (phy_para_bin_get_path(adapter, file_name) != _TRUE
+		|| rtw_is_file_readable(rtw_phy_para_file_path) != _TRUE)
+		return src_len;
+
+	buf = rtw_zvmalloc(MAX_PARA_FILE_BUF_LEN);
+	if (!buf)
+		return src_len;
+
+	rlen = rtw_retrieve_from_file(rtw_phy_para_file_path, buf, MAX_PARA_FILE_BUF_LEN);
+	if (rlen > 0 && phy_para_bin_chk(adapter, buf, rlen, type, &hdr) == _TRUE) {
+		if (hdr.src_len == (u32)src_len && hdr.src_csum == *src_csum) {
+			_rtw_memset(hal_data->para_file_buf, 0, MAX_PARA_FILE_BUF_LEN);
+			_rtw_memcpy(hal_data->para_file_buf, buf, rlen);
+			rtw_vmfree(buf, MAX_PARA_FILE_BUF_LEN);
+			RTW_INFO("%s(): %s loaded\n", __func__, rtw_phy_para_file_path);
+			return rlen;
+		}
+		RTW_WARN("%s(): %s is not of current text file\n", __func__, rtw_phy_para_file_path);
+	} else
+		RTW_WARN("%s(): ignore %s\n", __func__, rtw_phy_para_file_path);
+
+	rtw_vmfree(buf, MAX_PARA_FILE_BUF_LEN);
+	return src_len;
+}
+
+/*
+* buf has header reserved at the beginning and payload of len following
+* caller fills hdr type and para[]
+*/
+static void phy_para_bin_store(_adapter *adapter, const char *file_name, u8 *buf, u32 len
+	, u32 src_len, u32 src_csum)
+{
+	struct hal_spec_t *hal_spec = GET_HAL_SPEC(adapter);
+	struct phy_para_bin_hdr *hdr = (struct phy_para_bin_hdr *)buf;
+
+	hdr->magic = PHY_PARA_BIN_MAGIC;
+	hdr->ver = PHY_PARA_BIN_VER;
+	hdr->txgi_max = hal_spec->txgi_max;
+	hdr->txgi_pdbm = hal_spec->txgi_pdbm;
+	hdr->len = len;
+	hdr->csum = phy_para_bin_csum(buf + sizeof(*hdr), len);
+	hdr->src_len = src_len;
+	hdr->src_csum = src_csum;
+
+	if (phy_para_bin_get_path(adapter, file_name) != _TRUE)
+		return;
+
+	if (rtw_store_to_file(rtw_phy_para_file_path, buf, sizeof(*hdr) + len) != sizeof(*hdr) + len)
+		RTW_WARN("%s(): store %s fail\n", __func__, rtw_phy_para_file_path);
+	else
+		RTW_INFO("%s(): %s stored\n", __func__, rtw_phy_para_file_path);
+}
+
+/* binary is stored only when parsing plain text file read from file system */
+static u8 phy_para_bin_store_needed(_adapter *adapter)
+{
+	return adapter->registrypriv.phy_file_bin >= 2
+		&& adapter->registrypriv.RegDecryptCustomFile != 1;
+}
+
+static int phy_load_bb_pg_para_bin(_adapter *adapter, const char *buf, u32 len)
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
+	struct phy_para_bin_hdr hdr;
+
+	if (phy_para_bin_chk(adapter, buf, len, PHY_PARA_BIN_BY_RATE, &hdr) != _TRUE
+		|| hdr.para[PHY_PARA_BIN_BY_RATE_SIZE] != sizeof(hal_data->TxPwrByRateOffset)
+		|| hdr.len < sizeof(hal_data->TxPwrByRateOffset)
+	)
+		return _FAIL;
+
+	hal_data->odmpriv.phy_reg_pg_version = hdr.para[PHY_PARA_BIN_BY_RATE_PG_VER];
+	hal_data->odmpriv.phy_reg_pg_value_type = hdr.para[PHY_PARA_BIN_BY_RATE_PG_VAL_TYPE];
+	_rtw_memcpy(hal_data->TxPwrByRateOffset, buf + sizeof(hdr), sizeof(hal_data->TxPwrByRateOffset));
+
+	return _SUCCESS;
+}
+
+static void phy_store_bb_pg_para_bin(_adapter *adapter, const char *file_name, u32 src_len, u32 src_csum)
+{
+	HAL_DATA_TYPE *hal_data = GET_HAL_DATA(adapter);
+	u32 len = sizeof(hal_data->TxPwrByRateOffset);
+	struct phy_para_bin_hdr *hdr;
+	u8 *buf;
+
+	buf = rtw_zvmalloc(sizeof(*hdr) + len);
+	if (!buf)
+		return;
+
+	hdr = (struct phy_para_bin_hdr *)buf;
+	hdr->type = PHY_PARA_BIN_BY_RATE;
+	hdr->para[PHY_PARA_BIN_BY_RATE_PG_VER] = hal_data->odmpriv.phy_reg_pg_version;
+	hdr->para[PHY_PARA_BIN_BY_RATE_PG_VAL_TYPE] = hal_data->odmpriv.phy_reg_pg_value_type;
+	hdr->para[PHY_PARA_BIN_BY_RATE_SIZE] = len;
+	_rtw_memcpy(buf + sizeof(*hdr), hal_data->TxPwrByRateOffset, len);
+
+	phy_para_bin_store(adapter, file_name, buf, len, src_len, src_csum);
+
+	rtw_vmfree(buf, sizeof(*hdr) + len);
+}
+
 VOID
 phy_DecryptBBPgParaFile(
 	PADAPTER		Adapter,
@@ -4465,6 +4769,8 @@ phy_ConfigBBWithPgParaFile(
 {
 	HAL_DATA_TYPE	*pHalData = GET_HAL_DATA(Adapter);
 	int	rlen = 0, rtStatus = _FAIL;
+	u32	src_len = 0, src_csum = 0;
+	u8	store_bin = _FALSE;
 
 	if (!(Adapter->registrypriv.load_phy_file & LOAD_BB_PG_PARA_FILE))
 		return rtStatus;
@@ -4476,18 +4782,24 @@ phy_ConfigBBWithPgParaFile(
 		if (rtw_is_file_readable(rtw_phy_para_file_path) == _TRUE) {
 			rlen = rtw_retrieve_from_file(rtw_phy_para_file_path, pHalData->para_file_buf, MAX_PARA_FILE_BUF_LEN);
 			if (rlen > 0) {
-				rtStatus = _SUCCESS;
-				pHalData->bb_phy_reg_pg = rtw_zvmalloc(rlen);
-				if (pHalData->bb_phy_reg_pg) {
-					_rtw_memcpy(pHalData->bb_phy_reg_pg, pHalData->para_file_buf, rlen);
-					pHalData->bb_phy_reg_pg_len = rlen;
-				} else
-					RTW_INFO("%s bb_phy_reg_pg alloc fail !\n", __FUNCTION__);
+				src_len = rlen;
+				rlen = phy_para_bin_retrieve(Adapter, pFileName, PHY_PARA_BIN_BY_RATE, src_len, &src_csum);
+				store_bin = phy_para_bin_store_needed(Adapter);
 			}
 		}
+		if (rlen > 0) {
+			rtStatus = _SUCCESS;
+			pHalData->bb_phy_reg_pg = rtw_zvmalloc(rlen);
+			if (pHalData->bb_phy_reg_pg) {
+				_rtw_memcpy(pHalData->bb_phy_reg_pg, pHalData->para_file_buf, rlen);
+				pHalData->bb_phy_reg_pg_len = rlen;
+			} else
+				RTW_INFO("%s bb_phy_reg_pg alloc fail !\n", __FUNCTION__);
+		}
 	} else {
 		if ((pHalData->bb_phy_reg_pg_len != 0) && (pHalData->bb_phy_reg_pg != NULL)) {
 			_rtw_memcpy(pHalData->para_file_buf, pHalData->bb_phy_reg_pg, pHalData->bb_phy_reg_pg_len);
+			rlen = pHalData->bb_phy_reg_pg_len;
 			rtStatus = _SUCCESS;
 		} else
 			RTW_INFO("%s(): Critical Error !!!\n", __FUNCTION__);
@@ -4495,7 +4807,11 @@ phy_ConfigBBWithPgParaFile(
 
 	if (rtStatus == _SUCCESS) {
 		/* RTW_INFO("phy_ConfigBBWithPgParaFile(): read %s ok\n", pFileName); */
-		rtStatus = phy_ParseBBPgParaFile(Adapter, pHalData->para_file_buf);
+		if (phy_load_bb_pg_para_bin(Adapter, pHalData->para_file_buf, rlen) != _SUCCESS) {
+			rtStatus = phy_ParseBBPgParaFile(Adapter, pHalData->para_file_buf);
+			if (rtStatus == _SUCCESS && store_bin)
+				phy_store_bb_pg_para_bin(Adapter, pFileName, src_len, src_csum);
+		}
 	} else
 		RTW_INFO("%s(): No File %s, Load from HWImg Array!\n", __FUNCTION__, pFileName);
 
@@ -5308,6 +5624,153 @@ exit:
 	return rtStatus;
 }
 
+#ifdef CONFIG_IEEE80211_BAND_5GHZ
+#define PHY_PARA_BIN_LMT_5G_SZ sizeof(((struct txpwr_lmt_ent *)0)->lmt_5g)
+#else
+#define PHY_PARA_BIN_LMT_5G_SZ 0
+#endif
+
+/*
+* payload of PHY_PARA_BIN_LMT:
+* regd exc record: country[2], domain, nlen, regd_name[nlen]
+* txpwr_lmt_ent record: nlen, regd_name[nlen], lmt_2g, lmt_5g
+*/
+static int phy_load_power_limit_bin(_adapter *adapter, const char *buf, u32 len)
+{
+	struct rf_ctl_t *rfctl = adapter_to_rfctl(adapter);
+	struct phy_para_bin_hdr hdr;
+	const char *name;
+	u32 pos, end, i;
+	u8 nlen;
+	int ret = _FAIL;
+
+	if (phy_para_bin_chk(adapter, buf, len, PHY_PARA_BIN_LMT, &hdr) != _TRUE)
+		return _FAIL;
+
+	if (hdr.para[PHY_PARA_BIN_LMT_2G_SIZE] != sizeof(((struct txpwr_lmt_ent *)0)->lmt_2g)
+		|| hdr.para[PHY_PARA_BIN_LMT_5G_SIZE] != PHY_PARA_BIN_LMT_5G_SZ
+	) {
+		RTW_WARN("%s table size mismatch\n", __func__);
+		return _FAIL;
+	}
+
+	pos = sizeof(hdr);
+	end = sizeof(hdr) + hdr.len;
+
+	for (i = 0; i < hdr.para[PHY_PARA_BIN_LMT_EXC_NUM]; i++) {
+		if (pos + 4 > end)
+			goto exit;
+		nlen = buf[pos + 3];
+		if (!nlen || pos + 4 + nlen > end)
+			goto exit;
+
+		rtw_regd_exc_add_with_nlen(rfctl, buf + pos, buf[pos + 2], buf + pos + 4, nlen);
+		pos += 4 + nlen;
+	}
+
+	for (i = 0; i < hdr.para[PHY_PARA_BIN_LMT_REGD_NUM]; i++) {
+		if (pos + 1 > end)
+			goto exit;
+		nlen = buf[pos];
+		name = buf + pos + 1;
+		pos += 1 + nlen;
+		if (!nlen || pos + hdr.para[PHY_PARA_BIN_LMT_2G_SIZE] + hdr.para[PHY_PARA_BIN_LMT_5G_SIZE] > end)
+			goto exit;
+
+		rtw_txpwr_lmt_ent_add_with_nlen(rfctl, name, nlen, (const s8 *)(buf + pos)
+			, PHY_PARA_BIN_LMT_5G_SZ ? (const s8 *)(buf + pos + hdr.para[PHY_PARA_BIN_LMT_2G_SIZE]) : NULL);
+		pos += hdr.para[PHY_PARA_BIN_LMT_2G_SIZE] + hdr.para[PHY_PARA_BIN_LMT_5G_SIZE];
+	}
+
+	ret = _SUCCESS;
+
+exit:
+	if (ret != _SUCCESS) {
+		RTW_WARN("%s truncated record\n", __func__);
+		rtw_regd_exc_list_free(rfctl);
+		rtw_txpwr_lmt_list_free(rfctl);
+	}
+
+	return ret;
+}
+
+static void phy_store_power_limit_bin(_adapter *adapter, const char *file_name, u32 src_len, u32 src_csum)
+{
+	struct rf_ctl_t *rfctl = adapter_to_rfctl(adapter);
+	struct phy_para_bin_hdr *hdr;
+	struct regd_exc_ent *exc;
+	struct txpwr_lmt_ent *ent;
+	_list *cur, *head;
+	_irqL irqL;
+	u32 pos = sizeof(*hdr);
+	u32 exc_num = 0, regd_num = 0;
+	u8 nlen;
+	u8 *buf;
+
+	buf = rtw_zvmalloc(MAX_PARA_FILE_BUF_LEN);
+	if (!buf)
+		return;
+
+	_enter_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
+
+	head = &rfctl->reg_exc_list;
+	cur = get_next(head);
+	while ((rtw_end_of_queue_search(head, cur)) == _FALSE) {
+		exc = LIST_CONTAINOR(cur, struct regd_exc_ent, list);
+		cur = get_next(cur);
+
+		nlen = strlen(exc->regd_name);
+		if (pos + 4 + nlen > MAX_PARA_FILE_BUF_LEN)
+			goto overflow;
+		_rtw_memcpy(buf + pos, exc->country, 2);
+		buf[pos + 2] = exc->domain;
+		buf[pos + 3] = nlen;
+		_rtw_memcpy(buf + pos + 4, exc->regd_name, nlen);
+		pos += 4 + nlen;
+		exc_num++;
+	}
+
+	head = &rfctl->txpwr_lmt_list;
+	cur = get_next(head);
+	while ((rtw_end_of_queue_search(head, cur)) == _FALSE) {
+		ent = LIST_CONTAINOR(cur, struct txpwr_lmt_ent, list);
+		cur = get_next(cur);
+
+		nlen = strlen(ent->regd_name);
+		if (pos + 1 + nlen + sizeof(ent->lmt_2g) + PHY_PARA_BIN_LMT_5G_SZ > MAX_PARA_FILE_BUF_LEN)
+			goto overflow;
+		buf[pos] = nlen;
+		_rtw_memcpy(buf + pos + 1, ent->regd_name, nlen);
+		pos += 1 + nlen;
+		_rtw_memcpy(buf + pos, ent->lmt_2g, sizeof(ent->lmt_2g));
+		pos += sizeof(ent->lmt_2g);
+		#ifdef CONFIG_IEEE80211_BAND_5GHZ
+		_rtw_memcpy(buf + pos, ent->lmt_5g, sizeof(ent->lmt_5g));
+		pos += sizeof(ent->lmt_5g);
+		#endif
+		regd_num++;
+	}
+
+	_exit_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
+
+	hdr = (struct phy_para_bin_hdr *)buf;
+	hdr->type = PHY_PARA_BIN_LMT;
+	hdr->para[PHY_PARA_BIN_LMT_EXC_NUM] = exc_num;
+	hdr->para[PHY_PARA_BIN_LMT_REGD_NUM] = regd_num;
+	hdr->para[PHY_PARA_BIN_LMT_2G_SIZE] = sizeof(((struct txpwr_lmt_ent *)0)->lmt_2g);
+	hdr->para[PHY_PARA_BIN_LMT_5G_SIZE] = PHY_PARA_BIN_LMT_5G_SZ;
+
+	phy_para_bin_store(adapter, file_name, buf, pos - sizeof(*hdr), src_len, src_csum);
+	goto exit;
+
+overflow:
+	_exit_critical_mutex(&rfctl->txpwr_lmt_mutex, &irqL);
+	RTW_WARN("%s(): exceed %u bytes\n", __func__, MAX_PARA_FILE_BUF_LEN);
+
+exit:
+	rtw_vmfree(buf, MAX_PARA_FILE_BUF_LEN);
+}
+
 int
 PHY_ConfigRFWithPowerLimitTableParaFile(
 	IN	PADAPTER	Adapter,
@@ -5316,6 +5779,8 @@ PHY_ConfigRFWithPowerLimitTableParaFile(
 {
 	HAL_DATA_TYPE		*pHalData = GET_HAL_DATA(Adapter);
 	int	rlen = 0, rtStatus = _FAIL;
+	u32	src_len = 0, src_csum = 0;
+	u8	store_bin = _FALSE;
 
 	if (!(Adapter->registrypriv.load_phy_file & LOAD_RF_TXPWR_LMT_PARA_FILE))
 		return rtStatus;
@@ -5327,18 +5792,24 @@ PHY_ConfigRFWithPowerLimitTableParaFile(
 		if (rtw_is_file_readable(rtw_phy_para_file_path) == _TRUE) {
 			rlen = rtw_retrieve_from_file(rtw_phy_para_file_path, pHalData->para_file_buf, MAX_PARA_FILE_BUF_LEN);
 			if (rlen > 0) {
-				rtStatus = _SUCCESS;
-				pHalData->rf_tx_pwr_lmt = rtw_zvmalloc(rlen);
-				if (pHalData->rf_tx_pwr_lmt) {
-					_rtw_memcpy(pHalData->rf_tx_pwr_lmt, pHalData->para_file_buf, rlen);
-					pHalData->rf_tx_pwr_lmt_len = rlen;
-				} else
-					RTW_INFO("%s rf_tx_pwr_lmt alloc fail !\n", __FUNCTION__);
+				src_len = rlen;
+				rlen = phy_para_bin_retrieve(Adapter, pFileName, PHY_PARA_BIN_LMT, src_len, &src_csum);
+				store_bin = phy_para_bin_store_needed(Adapter);
 			}
 		}
+		if (rlen > 0) {
+			rtStatus = _SUCCESS;
+			pHalData->rf_tx_pwr_lmt = rtw_zvmalloc(rlen);
+			if (pHalData->rf_tx_pwr_lmt) {
+				_rtw_memcpy(pHalData->rf_tx_pwr_lmt, pHalData->para_file_buf, rlen);
+				pHalData->rf_tx_pwr_lmt_len = rlen;
+			} else
+				RTW_INFO("%s rf_tx_pwr_lmt alloc fail !\n", __FUNCTION__);
+		}
 	} else {
 		if ((pHalData->rf_tx_pwr_lmt_len != 0) && (pHalData->rf_tx_pwr_lmt != NULL)) {
 			_rtw_memcpy(pHalData->para_file_buf, pHalData->rf_tx_pwr_lmt, pHalData->rf_tx_pwr_lmt_len);
+			rlen = pHalData->rf_tx_pwr_lmt_len;
 			rtStatus = _SUCCESS;
 		} else
 			RTW_INFO("%s(): Critical Error !!!\n", __FUNCTION__);
@@ -5346,7 +5817,11 @@ PHY_ConfigRFWithPowerLimitTableParaFile(
 
 	if (rtStatus == _SUCCESS) {
 		/* RTW_INFO("%s(): read %s ok\n", __FUNCTION__, pFileName); */
-		rtStatus = phy_ParsePowerLimitTableFile(Adapter, pHalData->para_file_buf);
+		if (phy_load_power_limit_bin(Adapter, pHalData->para_file_buf, rlen) != _SUCCESS) {
+			rtStatus = phy_ParsePowerLimitTableFile(Adapter, pHalData->para_file_buf);
+			if (rtStatus == _SUCCESS && store_bin)
+				phy_store_power_limit_bin(Adapter, pFileName, src_len, src_csum);
+		}
 	} else
 		RTW_INFO("%s(): No File %s, Load from HWImg Array!\n", __FUNCTION__, pFileName);
 
@@ -1920,6 +1920,43 @@ void phy_iq_calibrate_8192e(void *dm_void, boolean is_recovery)
 	RF_DBG(dm, DBG_RF_IQK, "IQK finished\n");
 }
 
+/*@apply IQK result saved from a former phy_iq_calibrate_8192e() without calibrating again*/
+void phy_iq_calibrate_8192e_reload(void *dm_void, s32 *iqk_result)
+{
+	struct dm_struct *dm = (struct dm_struct *)dm_void;
+	s32 result[4][8];
+	u8 i, indexforchannel;
+	u32 IQK_BB_REG_92C[IQK_BB_REG_NUM] = {
+		REG_OFDM_0_XA_RX_IQ_IMBALANCE, REG_OFDM_0_XB_RX_IQ_IMBALANCE,
+		REG_OFDM_0_ECCA_THRESHOLD, REG_OFDM_0_AGC_RSSI_TABLE,
+		REG_OFDM_0_XA_TX_IQ_IMBALANCE, REG_OFDM_0_XB_TX_IQ_IMBALANCE,
+		REG_OFDM_0_XC_TX_AFE, REG_OFDM_0_XD_TX_AFE,
+		REG_OFDM_0_RX_IQ_EXT_ANTA};
+
+	for (i = 0; i < iqk_matrix_reg_num; i++)
+		result[0][i] = iqk_result[i];
+
+	dm->rf_calibrate_info.rege94 = result[0][0];
+	dm->rf_calibrate_info.rege9c = result[0][1];
+	dm->rf_calibrate_info.regeb4 = result[0][4];
+	dm->rf_calibrate_info.regebc = result[0][5];
+
+	if (result[0][0] != 0) {
+		_phy_path_a_fill_iqk_matrix_92e(dm, true, result, 0, (result[0][2] == 0));
+		_phy_path_b_fill_iqk_matrix_92e(dm, true, result, 0, (result[0][6] == 0));
+	}
+
+	indexforchannel = odm_get_right_chnl_place_for_iqk(*dm->channel);
+	for (i = 0; i < iqk_matrix_reg_num; i++)
+		dm->rf_calibrate_info.iqk_matrix_reg_setting[indexforchannel].value[0][i] = result[0][i];
+	dm->rf_calibrate_info.iqk_matrix_reg_setting[indexforchannel].is_iqk_done = true;
+
+	_phy_save_adda_registers_92e(dm, IQK_BB_REG_92C, dm->rf_calibrate_info.IQK_BB_backup_recover, IQK_BB_REG_NUM);
+
+	RF_DBG(dm, DBG_RF_IQK, "IQK reloaded: TX0_X=%x TX0_Y=%x TX1_X=%x TX1_Y=%x\n",
+	       result[0][0], result[0][1], result[0][4], result[0][5]);
+}
+
 void phy_lc_calibrate_8192e(void *dm_void)
 {
 	struct dm_struct *dm = (struct dm_struct *)dm_void;
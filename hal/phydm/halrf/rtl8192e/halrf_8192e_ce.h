@@ -45,6 +45,8 @@ void odm_tx_pwr_track_set_pwr92_e(void *dm_void, enum pwrtrack_method method,
 
 void phy_iq_calibrate_8192e(void *dm_void, boolean is_recovery);
 
+void phy_iq_calibrate_8192e_reload(void *dm_void, s32 *iqk_result);
+
 /*
  * LC calibrate
  *   */
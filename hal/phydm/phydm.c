@@ -1980,10 +1980,100 @@ u8 phydm_stop_dm_watchdog_check(void *dm_void)
 	}
 }
 
+void phydm_wd_prof_start(struct dm_struct *dm)
+{
+	struct phydm_wd_prof *prof = &dm->wd_prof;
+
+	prof->start_us = odm_get_current_time_us(dm);
+	prof->start_reg = prof->reg_cnt;
+}
+
+void phydm_wd_prof_end(struct dm_struct *dm, enum phydm_wd_mod id)
+{
+	struct phydm_wd_prof *prof = &dm->wd_prof;
+	struct phydm_wd_prof_mod *mod = &prof->mod[id];
+	u32 time_us;
+
+	time_us = (u32)(odm_get_current_time_us(dm) - prof->start_us);
+	mod->run_cnt++;
+	mod->time_us += time_us;
+	if (time_us > mod->time_max_us)
+		mod->time_max_us = time_us;
+	mod->reg_cnt += prof->reg_cnt - prof->start_reg;
+}
+
+#define PHYDM_WD_RUN(dm, id, func)				\
+	do {							\
+		phydm_wd_prof_start(dm);			\
+		func;						\
+		phydm_wd_prof_end(dm, id);			\
+	} while (0)
+
+/*@change driven modules, skipped while inputs are settled*/
+#define PHYDM_WD_RUN_CHG(dm, id, func)				\
+	do {							\
+		if ((dm)->wd_prof.settled) {			\
+			(dm)->wd_prof.mod[id].skip_cnt++;	\
+			break;					\
+		}						\
+		PHYDM_WD_RUN(dm, id, func);			\
+	} while (0)
+
+/*@
+ * DIG, CCK PD, RA mask and dynamic TX power only depend on link state,
+ * RSSI min/max, FA/CCA counts and noisy state. Settled means none of them
+ * moved past its threshold since these modules last ran, and the last DIG
+ * run didn't move IGI, i.e. running them again would change nothing.
+ */
+void phydm_wd_prof_settle_chk(struct dm_struct *dm)
+{
+	struct phydm_wd_prof *prof = &dm->wd_prof;
+	struct phydm_fa_struct *fa = &dm->false_alm_cnt;
+	u32 fa_th = MAX_2(PHYDM_WD_FA_TH, prof->fa_cnt >> 2);
+	u32 cca_th = MAX_2(PHYDM_WD_FA_TH, prof->cca_cnt >> 2);
+
+	prof->igi = dm->dm_dig_table.cur_ig_value;
+
+	prof->settled = prof->skip_en
+		&& prof->skip_seq < PHYDM_WD_SKIP_MAX
+		&& !prof->igi_moved
+		&& prof->is_linked == dm->is_linked
+		&& prof->linked_num == dm->number_linked_client
+		&& prof->noisy == dm->noisy_decision
+		&& DIFF_2(prof->rssi_min, dm->rssi_min) < PHYDM_WD_RSSI_TH
+		&& DIFF_2(prof->rssi_max, dm->rssi_max) < PHYDM_WD_RSSI_TH
+		&& DIFF_2(prof->fa_cnt, fa->cnt_all) < fa_th
+		&& DIFF_2(prof->cca_cnt, fa->cnt_cca_all) < cca_th;
+
+	if (prof->settled)
+		prof->skip_seq++;
+}
+
+void phydm_wd_prof_settle_update(struct dm_struct *dm)
+{
+	struct phydm_wd_prof *prof = &dm->wd_prof;
+
+	if (prof->settled)
+		return;
+
+	prof->skip_seq = 0;
+	prof->igi_moved = (prof->igi != dm->dm_dig_table.cur_ig_value);
+	prof->is_linked = dm->is_linked;
+	prof->linked_num = dm->number_linked_client;
+	prof->noisy = dm->noisy_decision;
+	prof->rssi_min = dm->rssi_min;
+	prof->rssi_max = dm->rssi_max;
+	prof->fa_cnt = dm->false_alm_cnt.cnt_all;
+	prof->cca_cnt = dm->false_alm_cnt.cnt_cca_all;
+}
+
 void phydm_watchdog(struct dm_struct *dm)
 {
 	PHYDM_DBG(dm, DBG_COMMON_FLOW, "%s ======>\n", __func__);
 
+	dm->wd_prof.settled = false;
+
+	phydm_wd_prof_start(dm);
 	phydm_common_info_self_update(dm);
 	phydm_phy_info_update(dm);
 	phydm_rssi_monitor_check(dm);
@@ -1994,69 +2084,133 @@ void phydm_watchdog(struct dm_struct *dm)
 #endif
 	phydm_receiver_blocking(dm);
 
-	if (phydm_stop_dm_watchdog_check(dm) == true)
+	if (phydm_stop_dm_watchdog_check(dm) == true) {
+		phydm_wd_prof_end(dm, PHYDM_WD_COMMON);
 		return;
+	}
 
 	phydm_hw_setting(dm);
+	phydm_wd_prof_end(dm, PHYDM_WD_COMMON);
 
 	#ifdef PHYDM_TDMA_DIG_SUPPORT
 	if (dm->original_dig_restore == 0)
-		phydm_tdma_dig_timer_check(dm);
+		PHYDM_WD_RUN(dm, PHYDM_WD_DIG, phydm_tdma_dig_timer_check(dm));
 	else
 	#endif
 	{
-		phydm_false_alarm_counter_statistics(dm);
-		phydm_noisy_detection(dm);
-		phydm_dig(dm);
+		PHYDM_WD_RUN(dm, PHYDM_WD_FA_CNT,
+			     phydm_false_alarm_counter_statistics(dm);
+			     phydm_noisy_detection(dm));
+		phydm_wd_prof_settle_chk(dm);
+		PHYDM_WD_RUN_CHG(dm, PHYDM_WD_DIG, phydm_dig(dm));
 		#ifdef PHYDM_SUPPORT_CCKPD
-		phydm_cck_pd_th(dm);
+		PHYDM_WD_RUN_CHG(dm, PHYDM_WD_CCKPD, phydm_cck_pd_th(dm));
 		#endif
 	}
 
 #ifdef PHYDM_POWER_TRAINING_SUPPORT
 	phydm_update_power_training_state(dm);
 #endif
-	phydm_adaptivity(dm);
-	phydm_ra_info_watchdog(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_ADAPTIVITY, phydm_adaptivity(dm));
+	PHYDM_WD_RUN_CHG(dm, PHYDM_WD_RA, phydm_ra_info_watchdog(dm));
 #ifdef CONFIG_PATH_DIVERSITY
-	phydm_tx_path_diversity(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_PATH_DIV, phydm_tx_path_diversity(dm));
 #endif
-	phydm_cfo_tracking(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_CFO, phydm_cfo_tracking(dm));
 #ifdef CONFIG_DYNAMIC_TX_TWR
-	phydm_dynamic_tx_power(dm);
+	PHYDM_WD_RUN_CHG(dm, PHYDM_WD_DYN_TXPWR, phydm_dynamic_tx_power(dm));
 #endif
 #ifdef CONFIG_PHYDM_ANTENNA_DIVERSITY
-	odm_antenna_diversity(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_ANT_DIV, odm_antenna_diversity(dm));
 #endif
 #ifdef CONFIG_ADAPTIVE_SOML
-	phydm_adaptive_soml(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_SOML, phydm_adaptive_soml(dm));
 #endif
 
 #ifdef PHYDM_BEAMFORMING_VERSION1
-	phydm_beamforming_watchdog(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_BF, phydm_beamforming_watchdog(dm));
 #endif
 
-	halrf_watchdog(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_HALRF, halrf_watchdog(dm));
 #ifdef PHYDM_PRIMARY_CCA
-	phydm_primary_cca(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_PRI_CCA, phydm_primary_cca(dm));
 #endif
 #if (DM_ODM_SUPPORT_TYPE == ODM_CE)
-	odm_dtc(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_DTC, odm_dtc(dm));
 #endif
 
-	phydm_env_mntr_watchdog(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_ENV_MNTR, phydm_env_mntr_watchdog(dm));
 
 #ifdef PHYDM_LNA_SAT_CHK_SUPPORT
-	phydm_lna_sat_chk_watchdog(dm);
+	PHYDM_WD_RUN(dm, PHYDM_WD_LNA_SAT, phydm_lna_sat_chk_watchdog(dm));
 #endif
 #ifdef CONFIG_MCC_DM
 	#if (RTL8822B_SUPPORT == 1)
 	phydm_mcc_switch(dm);
 	#endif
 #endif
+	phydm_wd_prof_settle_update(dm);
 	phydm_common_info_self_reset(dm);
 }
 
+void phydm_wd_prof_debug(void *dm_void, char input[][16], u32 *_used,
+			 char *output, u32 *_out_len)
+{
+	struct dm_struct *dm = (struct dm_struct *)dm_void;
+	struct phydm_wd_prof *prof = &dm->wd_prof;
+	struct phydm_wd_prof_mod *mod;
+	char help[] = "-h";
+	const char *name[PHYDM_WD_MOD_NUM] = {
+		"common", "fa_cnt", "dig", "cckpd", "adaptivity", "ra",
+		"path_div", "cfo", "dyn_txpwr", "ant_div", "soml", "bf",
+		"halrf", "pri_cca", "dtc", "env_mntr", "lna_sat"};
+	u32 var1[10] = {0};
+	u32 used = *_used;
+	u32 out_len = *_out_len;
+	u8 i;
+
+	if ((strcmp(input[1], help) == 0)) {
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+			 "show: {100}\n");
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+			 "skip settled modules: {1} {en}\n");
+		PDM_SNPF(out_len, used, output + used, out_len - used,
+			 "reset: {2}\n");
+	} else {
+		PHYDM_SSCANF(input[1], DCMD_DECIMAL, &var1[0]);
+
+		if (var1[0] == 1) {
+			PHYDM_SSCANF(input[2], DCMD_DECIMAL, &var1[1]);
+			prof->skip_en = (boolean)var1[1];
+			prof->skip_seq = 0;
+			PDM_SNPF(out_len, used, output + used, out_len - used,
+				 "skip_en=%d\n", prof->skip_en);
+		} else if (var1[0] == 2) {
+			odm_memory_set(dm, prof->mod, 0, sizeof(prof->mod));
+		} else if (var1[0] == 100) {
+			PDM_SNPF(out_len, used, output + used, out_len - used,
+				 "skip_en=%d settled=%d skip_seq=%d\n",
+				 prof->skip_en, prof->settled, prof->skip_seq);
+			PDM_SNPF(out_len, used, output + used, out_len - used,
+				 "%-10s %8s %8s %8s %8s %8s\n", "module", "run",
+				 "skip", "avg_us", "max_us", "reg");
+			for (i = 0; i < PHYDM_WD_MOD_NUM; i++) {
+				mod = &prof->mod[i];
+				if (!mod->run_cnt && !mod->skip_cnt)
+					continue;
+				PDM_SNPF(out_len, used, output + used,
+					 out_len - used,
+					 "%-10s %8d %8d %8d %8d %8d\n", name[i],
+					 mod->run_cnt, mod->skip_cnt,
+					 mod->run_cnt ? (u32)phydm_division64(mod->time_us, mod->run_cnt) : 0,
+					 mod->time_max_us, mod->reg_cnt);
+			}
+		}
+	}
+	*_used = used;
+	*_out_len = out_len;
+}
+
 /*@
  * Init /.. Fixed HW value. Only init time.
  */
@@ -689,6 +689,62 @@ struct _phydm_mcc_dm_ {
 #endif
 
 
+/*@
+ * phydm_watchdog() profiling, see phydm_wd_prof_debug()
+ */
+#define PHYDM_WD_SKIP_MAX	4	/*@max consecutive skipped cycles*/
+#define PHYDM_WD_RSSI_TH	3
+#define PHYDM_WD_FA_TH		100
+
+enum phydm_wd_mod {
+	PHYDM_WD_COMMON		= 0, /*@info update, rssi monitor, hw setting*/
+	PHYDM_WD_FA_CNT		= 1, /*@FA counter, noisy detection*/
+	PHYDM_WD_DIG		= 2,
+	PHYDM_WD_CCKPD		= 3,
+	PHYDM_WD_ADAPTIVITY	= 4,
+	PHYDM_WD_RA		= 5,
+	PHYDM_WD_PATH_DIV	= 6,
+	PHYDM_WD_CFO		= 7,
+	PHYDM_WD_DYN_TXPWR	= 8,
+	PHYDM_WD_ANT_DIV	= 9,
+	PHYDM_WD_SOML		= 10,
+	PHYDM_WD_BF		= 11,
+	PHYDM_WD_HALRF		= 12,
+	PHYDM_WD_PRI_CCA	= 13,
+	PHYDM_WD_DTC		= 14,
+	PHYDM_WD_ENV_MNTR	= 15,
+	PHYDM_WD_LNA_SAT	= 16,
+	PHYDM_WD_MOD_NUM
+};
+
+struct phydm_wd_prof_mod {
+	u32		run_cnt;
+	u32		skip_cnt;
+	u64		time_us;
+	u32		time_max_us;
+	u32		reg_cnt;
+};
+
+struct phydm_wd_prof {
+	boolean		skip_en; /*@skip change driven modules when settled*/
+	boolean		settled; /*@decision of current cycle*/
+	u8		skip_seq;
+	u32		reg_cnt; /*@odm_* register accesses, free running*/
+	u64		start_us;
+	u32		start_reg;
+	struct phydm_wd_prof_mod mod[PHYDM_WD_MOD_NUM];
+	/*@inputs seen when change driven modules last ran*/
+	boolean		is_linked;
+	u8		linked_num;
+	boolean		noisy;
+	u8		rssi_min;
+	u8		rssi_max;
+	u32		fa_cnt;
+	u32		cca_cnt;
+	u8		igi; /*@before DIG of current cycle*/
+	boolean		igi_moved; /*@last DIG run changed IGI*/
+};
+
 #if (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	#if (RT_PLATFORM != PLATFORM_LINUX)
 		typedef
@@ -1114,6 +1170,7 @@ struct dm_struct {
 
 	struct ra_table			dm_ra_table;
 	struct phydm_fa_struct		false_alm_cnt;
+	struct phydm_wd_prof		wd_prof;
 #ifdef PHYDM_TDMA_DIG_SUPPORT
 	struct phydm_fa_acc_struct	false_alm_cnt_acc;
 #ifdef IS_USE_NEW_TDMA
@@ -1284,6 +1341,22 @@ phydm_pause_dm_watchdog(void *dm_void, enum phydm_pause_type pause_type);
 void
 phydm_watchdog(struct dm_struct *dm);
 
+void
+phydm_wd_prof_start(struct dm_struct *dm);
+
+void
+phydm_wd_prof_end(struct dm_struct *dm, enum phydm_wd_mod id);
+
+void
+phydm_wd_prof_settle_chk(struct dm_struct *dm);
+
+void
+phydm_wd_prof_settle_update(struct dm_struct *dm);
+
+void
+phydm_wd_prof_debug(void *dm_void, char input[][16], u32 *_used,
+		    char *output, u32 *_out_len);
+
 void
 phydm_watchdog_mp(struct dm_struct *dm);
 
@@ -3931,7 +3931,8 @@ enum PHYDM_CMD_ID {
 	PHYDM_PAUSE_FUNC,
 	PHYDM_PER_TONE_EVM,
 	PHYDM_DYN_TXPWR,
-	PHYDM_LNA_SAT
+	PHYDM_LNA_SAT,
+	PHYDM_WD_PROF
 };
 
 struct phydm_command phy_dm_ary[] = {
@@ -3980,7 +3981,8 @@ struct phydm_command phy_dm_ary[] = {
 	{"pause", PHYDM_PAUSE_FUNC},
 	{"evm", PHYDM_PER_TONE_EVM},
 	{"dyn_txpwr", PHYDM_DYN_TXPWR},
-	{"lna_sat", PHYDM_LNA_SAT} };
+	{"lna_sat", PHYDM_LNA_SAT},
+	{"wd_prof", PHYDM_WD_PROF} };
 
 #endif /*@#ifdef CONFIG_PHYDM_DEBUG_FUNCTION*/
 
@@ -4308,6 +4310,10 @@ void phydm_cmd_parser(struct dm_struct *dm, char input[][MAX_ARGV],
 		#endif
 		break;
 
+	case PHYDM_WD_PROF:
+		phydm_wd_prof_debug(dm, input, &used, output, &out_len);
+		break;
+
 	default:
 		PDM_SNPF(out_len, used, output + used, out_len - used,
 			 "Do not support this command\n");
@@ -1227,13 +1227,9 @@ void phydm_false_alarm_counter_reg_reset(void *dm_void)
 
 #ifdef PHYDM_IC_JGR3_SERIES_SUPPORT
 	if (dm->support_ic_type & ODM_IC_JGR3_SERIES) {
-		/* @reset CCK FA counter */
-		odm_set_bb_reg(dm, R_0x1a2c, BIT(15) | BIT(14), 0);
-		odm_set_bb_reg(dm, R_0x1a2c, BIT(15) | BIT(14), 2);
-
-		/* @reset CCK CCA counter */
-		odm_set_bb_reg(dm, R_0x1a2c, BIT(13) | BIT(12), 0);
-		odm_set_bb_reg(dm, R_0x1a2c, BIT(13) | BIT(12), 2);
+		/* @reset CCK FA counter[15:14] & CCK CCA counter[13:12] */
+		odm_set_bb_reg(dm, R_0x1a2c, 0xf000, 0);
+		odm_set_bb_reg(dm, R_0x1a2c, 0xf000, 0xa);
 
 		/* @Disable common rx clk gating => WLANBB-1106*/
 		odm_set_bb_reg(dm, R_0x1d2c, BIT(31), 0);
@@ -1257,13 +1253,9 @@ void phydm_false_alarm_counter_reg_reset(void *dm_void)
 		/* @update page D counter*/
 		odm_set_bb_reg(dm, R_0xd00, BIT(31), 0);
 
-		/* @reset CCK CCA counter*/
-		odm_set_bb_reg(dm, R_0xa2c, BIT(13) | BIT(12), 0);
-		odm_set_bb_reg(dm, R_0xa2c, BIT(13) | BIT(12), 2);
-
-		/* @reset CCK FA counter*/
-		odm_set_bb_reg(dm, R_0xa2c, BIT(15) | BIT(14), 0);
-		odm_set_bb_reg(dm, R_0xa2c, BIT(15) | BIT(14), 2);
+		/* @reset CCK FA counter[15:14] & CCK CCA counter[13:12] */
+		odm_set_bb_reg(dm, R_0xa2c, 0xf000, 0);
+		odm_set_bb_reg(dm, R_0xa2c, 0xf000, 0xa);
 
 		/* @reset CRC32 counter*/
 		odm_set_bb_reg(dm, R_0xf14, BIT(16), 1);
@@ -1304,9 +1296,8 @@ void phydm_false_alarm_counter_reg_hold(void *dm_void)
 	struct dm_struct *dm = (struct dm_struct *)dm_void;
 
 	if (dm->support_ic_type & ODM_IC_JGR3_SERIES) {
-		/* @hold cck counter */
-		odm_set_bb_reg(dm, R_0x1a2c, BIT(12), 1);
-		odm_set_bb_reg(dm, R_0x1a2c, BIT(14), 1);
+		/* @hold cck counter, BIT(12) & BIT(14) */
+		odm_set_bb_reg(dm, R_0x1a2c, BIT(14) | BIT(12), 0x5);
 	} else if (dm->support_ic_type & ODM_IC_11N_SERIES) {
 		/*@hold ofdm counter*/
 		/*@hold page C counter*/
@@ -1314,38 +1305,71 @@ void phydm_false_alarm_counter_reg_hold(void *dm_void)
 		/*@hold page D counter*/
 		odm_set_bb_reg(dm, R_0xd00, BIT(31), 1);
 
-		/*@hold cck counter*/
-		odm_set_bb_reg(dm, R_0xa2c, BIT(12), 1);
-		odm_set_bb_reg(dm, R_0xa2c, BIT(14), 1);
+		/*@hold cck counter, BIT(12) & BIT(14)*/
+		odm_set_bb_reg(dm, R_0xa2c, BIT(14) | BIT(12), 0x5);
 	}
 }
 
+struct phydm_fa_snapshot *phydm_fa_cnt_snapshot(void *dm_void)
+{
+	struct dm_struct *dm = (struct dm_struct *)dm_void;
+	struct phydm_fa_snapshot *snap = &dm->false_alm_cnt.snap;
+
+	snap->valid = false;
+
+	#if (ODM_IC_11N_SERIES_SUPPORT)
+	if (!(dm->support_ic_type & ODM_IC_11N_SERIES))
+		return snap;
+
+	/* @hold ofdm & cck counter */
+	phydm_false_alarm_counter_reg_hold(dm);
+
+	/*@0xa58 ~ 0xa60*/
+	odm_read_4byte_burst(dm, ODM_REG_CCK_FA_MSB_11N,
+			     &snap->reg[FA_SNAP_CCK_FA_MSB], 3);
+	/*@0xcf0*/
+	odm_read_4byte_burst(dm, ODM_REG_OFDM_FA_TYPE1_11N,
+			     &snap->reg[FA_SNAP_OFDM_FA1], 1);
+	/*@0xda0 ~ 0xda8*/
+	odm_read_4byte_burst(dm, ODM_REG_OFDM_FA_TYPE2_11N,
+			     &snap->reg[FA_SNAP_OFDM_FA2], 3);
+	/*@0xf84 ~ 0xf94*/
+	odm_read_4byte_burst(dm, R_0xf84, &snap->reg[FA_SNAP_CCK_CRC_ERR], 5);
+
+	snap->burst_cnt = 4;
+	snap->sys_up_time = dm->phydm_sys_up_time;
+	snap->valid = true;
+	#endif
+
+	return snap;
+}
+
 #if (ODM_IC_11N_SERIES_SUPPORT)
 void phydm_fa_cnt_statistics_n(void *dm_void)
 {
 	struct dm_struct *dm = (struct dm_struct *)dm_void;
 	struct phydm_fa_struct *fa_t = &dm->false_alm_cnt;
+	struct phydm_fa_snapshot *snap = NULL;
 	u32 reg = 0;
 
 	if (!(dm->support_ic_type & ODM_IC_11N_SERIES))
 		return;
 
-	/* @hold ofdm & cck counter */
-	phydm_false_alarm_counter_reg_hold(dm);
+	snap = phydm_fa_cnt_snapshot(dm);
 
-	reg = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE1_11N, MASKDWORD);
+	reg = snap->reg[FA_SNAP_OFDM_FA1];
 	fa_t->cnt_fast_fsync = (reg & 0xffff);
 	fa_t->cnt_sb_search_fail = ((reg & 0xffff0000) >> 16);
 
-	reg = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE2_11N, MASKDWORD);
+	reg = snap->reg[FA_SNAP_OFDM_FA2];
 	fa_t->cnt_ofdm_cca = (reg & 0xffff);
 	fa_t->cnt_parity_fail = ((reg & 0xffff0000) >> 16);
 
-	reg = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE3_11N, MASKDWORD);
+	reg = snap->reg[FA_SNAP_OFDM_FA3];
 	fa_t->cnt_rate_illegal = (reg & 0xffff);
 	fa_t->cnt_crc8_fail = ((reg & 0xffff0000) >> 16);
 
-	reg = odm_get_bb_reg(dm, ODM_REG_OFDM_FA_TYPE4_11N, MASKDWORD);
+	reg = snap->reg[FA_SNAP_OFDM_FA4];
 	fa_t->cnt_mcs_fail = (reg & 0xffff);
 
 	fa_t->cnt_ofdm_fail =
@@ -1354,16 +1378,16 @@ void phydm_fa_cnt_statistics_n(void *dm_void)
 		fa_t->cnt_fast_fsync + fa_t->cnt_sb_search_fail;
 
 	/* read CCK CRC32 counter */
-	fa_t->cnt_cck_crc32_error = odm_get_bb_reg(dm, R_0xf84, MASKDWORD);
-	fa_t->cnt_cck_crc32_ok = odm_get_bb_reg(dm, R_0xf88, MASKDWORD);
+	fa_t->cnt_cck_crc32_error = snap->reg[FA_SNAP_CCK_CRC_ERR];
+	fa_t->cnt_cck_crc32_ok = snap->reg[FA_SNAP_CCK_CRC_OK];
 
 	/* read OFDM CRC32 counter */
-	reg = odm_get_bb_reg(dm, ODM_REG_OFDM_CRC32_CNT_11N, MASKDWORD);
+	reg = snap->reg[FA_SNAP_OFDM_CRC];
 	fa_t->cnt_ofdm_crc32_error = (reg & 0xffff0000) >> 16;
 	fa_t->cnt_ofdm_crc32_ok = reg & 0xffff;
 
 	/* read HT CRC32 counter */
-	reg = odm_get_bb_reg(dm, ODM_REG_HT_CRC32_CNT_11N, MASKDWORD);
+	reg = snap->reg[FA_SNAP_HT_CRC];
 	fa_t->cnt_ht_crc32_error = (reg & 0xffff0000) >> 16;
 	fa_t->cnt_ht_crc32_ok = reg & 0xffff;
 
@@ -1388,13 +1412,13 @@ void phydm_fa_cnt_statistics_n(void *dm_void)
 	}
 	#endif
 
-	reg = odm_get_bb_reg(dm, ODM_REG_CCK_FA_LSB_11N, MASKBYTE0);
-	fa_t->cnt_cck_fail = reg;
+	reg = snap->reg[FA_SNAP_CCK_FA_LSB];
+	fa_t->cnt_cck_fail = reg & MASKBYTE0;
 
-	reg = odm_get_bb_reg(dm, ODM_REG_CCK_FA_MSB_11N, MASKBYTE3);
-	fa_t->cnt_cck_fail += (reg & 0xff) << 8;
+	reg = snap->reg[FA_SNAP_CCK_FA_MSB];
+	fa_t->cnt_cck_fail += ((reg & MASKBYTE3) >> 24) << 8;
 
-	reg = odm_get_bb_reg(dm, ODM_REG_CCK_CCA_CNT_11N, MASKDWORD);
+	reg = snap->reg[FA_SNAP_CCK_CCA];
 	fa_t->cnt_cck_cca = ((reg & 0xFF) << 8) | ((reg & 0xFF00) >> 8);
 
 	fa_t->cnt_all_pre = fa_t->cnt_all;
@@ -106,6 +106,25 @@ enum tdma_dig_state {
 };
 #endif
 
+/*@FA/CCA counter dwords on 11N series, grouped by address so that
+ * each block can be fetched with one burst read
+ */
+enum phydm_fa_snap_idx {
+	FA_SNAP_CCK_FA_MSB	= 0,	/*@0xa58*/
+	FA_SNAP_CCK_FA_LSB	= 1,	/*@0xa5c*/
+	FA_SNAP_CCK_CCA		= 2,	/*@0xa60*/
+	FA_SNAP_OFDM_FA1	= 3,	/*@0xcf0*/
+	FA_SNAP_OFDM_FA2	= 4,	/*@0xda0*/
+	FA_SNAP_OFDM_FA3	= 5,	/*@0xda4*/
+	FA_SNAP_OFDM_FA4	= 6,	/*@0xda8*/
+	FA_SNAP_CCK_CRC_ERR	= 7,	/*@0xf84*/
+	FA_SNAP_CCK_CRC_OK	= 8,	/*@0xf88*/
+	FA_SNAP_RSVD_F8C	= 9,	/*@0xf8c, read only to keep burst*/
+	FA_SNAP_HT_CRC		= 10,	/*@0xf90*/
+	FA_SNAP_OFDM_CRC	= 11,	/*@0xf94*/
+	FA_SNAP_NUM
+};
+
 /*@--------------------Define Struct-----------------------------------*/
 #ifdef CFG_DIG_DAMPING_CHK
 struct phydm_dig_recorder_strcut {
@@ -180,6 +199,13 @@ struct phydm_dig_struct {
 #endif
 };
 
+struct phydm_fa_snapshot {
+	u32		reg[FA_SNAP_NUM];
+	u32		sys_up_time;	/*@watchdog time the snapshot is taken*/
+	u8		burst_cnt;	/*@bus transactions used for reading*/
+	boolean		valid;
+};
+
 struct phydm_fa_struct {
 	u32		cnt_parity_fail;
 	u32		cnt_rate_illegal;
@@ -217,6 +243,7 @@ struct phydm_fa_struct {
 	boolean		ofdm_block_enable;
 	u32		dbg_port0;
 	boolean		edcca_flag;
+	struct phydm_fa_snapshot snap;
 };
 
 #ifdef PHYDM_TDMA_DIG_SUPPORT
@@ -272,6 +299,8 @@ void phydm_dig_lps_32k(void *dm_void);
 
 void phydm_dig_by_rssi_lps(void *dm_void);
 
+struct phydm_fa_snapshot *phydm_fa_cnt_snapshot(void *dm_void);
+
 void phydm_false_alarm_counter_statistics(void *dm_void);
 
 #ifdef PHYDM_TDMA_DIG_SUPPORT
@@ -49,6 +49,7 @@ u8 odm_read_1byte(struct dm_struct *dm, u32 reg_addr)
 	return rtw_read8(rtwdev, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void *adapter = dm->adapter;
+	dm->wd_prof.reg_cnt++;
 	return rtw_read8(adapter, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void *adapter = dm->adapter;
@@ -75,6 +76,7 @@ u16 odm_read_2byte(struct dm_struct *dm, u32 reg_addr)
 	return rtw_read16(rtwdev, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void *adapter = dm->adapter;
+	dm->wd_prof.reg_cnt++;
 	return rtw_read16(adapter, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void *adapter = dm->adapter;
@@ -101,6 +103,7 @@ u32 odm_read_4byte(struct dm_struct *dm, u32 reg_addr)
 	return rtw_read32(rtwdev, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void *adapter = dm->adapter;
+	dm->wd_prof.reg_cnt++;
 	return rtw_read32(adapter, reg_addr);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void *adapter = dm->adapter;
@@ -112,6 +115,29 @@ u32 odm_read_4byte(struct dm_struct *dm, u32 reg_addr)
 #endif
 }
 
+/*@Read num consecutive dwords starting at reg_addr in as few bus
+ * transactions as the interface allows (one vendor request on USB).
+ */
+void odm_read_4byte_burst(struct dm_struct *dm, u32 reg_addr, u32 *val,
+			  u8 num)
+{
+	u8 i;
+#if (DM_ODM_SUPPORT_TYPE & ODM_CE) && !defined(DM_ODM_CE_MAC80211) && \
+	!defined(DM_ODM_CE_MAC80211_V2) && defined(CONFIG_USB_HCI)
+	void *adapter = dm->adapter;
+
+	odm_memory_set(dm, val, 0, (u32)num << 2);
+	dm->wd_prof.reg_cnt++;
+	rtw_read_mem(adapter, reg_addr, (u32)num << 2, (u8 *)val);
+	/*@registers are little endian on the bus, as in rtw_read32()*/
+	for (i = 0; i < num; i++)
+		val[i] = le32_to_cpu(val[i]);
+#else
+	for (i = 0; i < num; i++)
+		val[i] = odm_read_4byte(dm, reg_addr + (i << 2));
+#endif
+}
+
 void odm_write_1byte(struct dm_struct *dm, u32 reg_addr, u8 data)
 {
 #if (DM_ODM_SUPPORT_TYPE & (ODM_AP))
@@ -127,6 +153,7 @@ void odm_write_1byte(struct dm_struct *dm, u32 reg_addr, u8 data)
 	rtw_write8(rtwdev, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void *adapter = dm->adapter;
+	dm->wd_prof.reg_cnt++;
 	rtw_write8(adapter, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void *adapter = dm->adapter;
@@ -153,6 +180,7 @@ void odm_write_2byte(struct dm_struct *dm, u32 reg_addr, u16 data)
 	rtw_write16(rtwdev, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void *adapter = dm->adapter;
+	dm->wd_prof.reg_cnt++;
 	rtw_write16(adapter, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void *adapter = dm->adapter;
@@ -179,6 +207,7 @@ void odm_write_4byte(struct dm_struct *dm, u32 reg_addr, u32 data)
 	rtw_write32(rtwdev, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
 	void *adapter = dm->adapter;
+	dm->wd_prof.reg_cnt++;
 	rtw_write32(adapter, reg_addr, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_WIN)
 	void *adapter = dm->adapter;
@@ -208,6 +237,7 @@ void odm_set_mac_reg(struct dm_struct *dm, u32 reg_addr, u32 bit_mask, u32 data)
 #elif (DM_ODM_SUPPORT_TYPE & ODM_IOT)
 	phy_set_bb_reg(dm->adapter, reg_addr, bit_mask, data);
 #else
+	dm->wd_prof.reg_cnt++;
 	phy_set_bb_reg(dm->adapter, reg_addr, bit_mask, data);
 #endif
 }
@@ -229,6 +259,7 @@ u32 odm_get_mac_reg(struct dm_struct *dm, u32 reg_addr, u32 bit_mask)
 #elif (DM_ODM_SUPPORT_TYPE & ODM_IOT)
 	return phy_query_bb_reg(dm->adapter, reg_addr, bit_mask);
 #else
+	dm->wd_prof.reg_cnt++;
 	return phy_query_mac_reg(dm->adapter, reg_addr, bit_mask);
 #endif
 }
@@ -251,6 +282,7 @@ void odm_set_bb_reg(struct dm_struct *dm, u32 reg_addr, u32 bit_mask, u32 data)
 #elif (DM_ODM_SUPPORT_TYPE & ODM_IOT)
 	phy_set_bb_reg(dm->adapter, reg_addr, bit_mask, data);
 #else
+	dm->wd_prof.reg_cnt++;
 	phy_set_bb_reg(dm->adapter, reg_addr, bit_mask, data);
 #endif
 }
@@ -273,6 +305,7 @@ u32 odm_get_bb_reg(struct dm_struct *dm, u32 reg_addr, u32 bit_mask)
 #elif (DM_ODM_SUPPORT_TYPE & ODM_IOT)
 	return phy_query_bb_reg(dm->adapter, reg_addr, bit_mask);
 #else
+	dm->wd_prof.reg_cnt++;
 	return phy_query_bb_reg(dm->adapter, reg_addr, bit_mask);
 #endif
 }
@@ -296,6 +329,7 @@ void odm_set_rf_reg(struct dm_struct *dm, u8 e_rf_path, u32 reg_addr,
 
 	rtw_write_rf(rtwdev, e_rf_path, reg_addr, bit_mask, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_CE)
+	dm->wd_prof.reg_cnt++;
 	phy_set_rf_reg(dm->adapter, e_rf_path, reg_addr, bit_mask, data);
 #elif (DM_ODM_SUPPORT_TYPE & ODM_IOT)
 	phy_set_rf_reg(dm->adapter, e_rf_path, reg_addr, bit_mask, data);
@@ -322,6 +356,7 @@ u32 odm_get_rf_reg(struct dm_struct *dm, u8 e_rf_path, u32 reg_addr,
 #elif (DM_ODM_SUPPORT_TYPE & ODM_IOT)
 	return phy_query_rf_reg(dm->adapter, e_rf_path, reg_addr, bit_mask);
 #else
+	dm->wd_prof.reg_cnt++;
 	return phy_query_rf_reg(dm->adapter, e_rf_path, reg_addr, bit_mask);
 #endif
 }
@@ -1090,6 +1125,27 @@ u64 odm_get_progressing_time(struct dm_struct *dm, u64 start_time)
 #endif
 }
 
+/*@only for profiling, 0 on platforms without a us clock*/
+u64 odm_get_current_time_us(struct dm_struct *dm)
+{
+#if (DM_ODM_SUPPORT_TYPE & ODM_CE) && \
+	(!defined(DM_ODM_CE_MAC80211) && !defined(DM_ODM_CE_MAC80211_V2))
+	return rtw_get_current_time_us();
+#else
+	return 0;
+#endif
+}
+
+u64 phydm_division64(u64 x, u64 y)
+{
+#if (DM_ODM_SUPPORT_TYPE & ODM_CE) && \
+	(!defined(DM_ODM_CE_MAC80211) && !defined(DM_ODM_CE_MAC80211_V2))
+	return rtw_division64(x, y);
+#else
+	return x / y;
+#endif
+}
+
 #if (DM_ODM_SUPPORT_TYPE & (ODM_WIN | ODM_CE)) && \
 	(!defined(DM_ODM_CE_MAC80211) && !defined(DM_ODM_CE_MAC80211_V2))
 
@@ -159,6 +159,9 @@ u16 odm_read_2byte(struct dm_struct *dm, u32 reg_addr);
 
 u32 odm_read_4byte(struct dm_struct *dm, u32 reg_addr);
 
+void odm_read_4byte_burst(struct dm_struct *dm, u32 reg_addr, u32 *val,
+			  u8 num);
+
 void odm_write_1byte(struct dm_struct *dm, u32 reg_addr, u8 data);
 
 void odm_write_2byte(struct dm_struct *dm, u32 reg_addr, u16 data);
@@ -266,6 +269,10 @@ u8 phydm_c2H_content_parsing(void *dm_void, u8 c2h_cmd_id, u8 c2h_cmd_len,
 u64 odm_get_current_time(struct dm_struct *dm);
 u64 odm_get_progressing_time(struct dm_struct *dm, u64 start_time);
 
+u64 odm_get_current_time_us(struct dm_struct *dm);
+
+u64 phydm_division64(u64 x, u64 y);
+
 #if (DM_ODM_SUPPORT_TYPE & (ODM_WIN | ODM_CE)) && \
 	(!defined(DM_ODM_CE_MAC80211) && !defined(DM_ODM_CE_MAC80211_V2))
 
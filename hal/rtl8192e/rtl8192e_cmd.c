@@ -848,16 +848,37 @@ C2HTxFeedbackHandler_8192E(
 	IN	u8			CmdLen
 )
 {
+	u8 ac_queue = GET_8192E_C2H_TX_RPT_QUEUE_SELECT(CmdBuf) <= 0x07;
+	bool ok = !(GET_8192E_C2H_TX_RPT_RETRY_OVER(CmdBuf) | GET_8192E_C2H_TX_RPT_LIFE_TIME_OVER(CmdBuf));
+
+#if defined(CONFIG_AP_MODE) && defined(CONFIG_XMIT_ACK) && !defined(CONFIG_TX_CMPL_TRACK)
+	/* AC queue report of active keep alive null data, no data frame requests report without tx_cmpl_track */
+	if (ac_queue
+		&& rtw_ap_aka_probe_report(Adapter, GET_8192E_C2H_TX_RPT_MAC_ID(CmdBuf), ok) == _SUCCESS)
+		goto exit;
+#endif
+#ifdef CONFIG_TX_CMPL_TRACK
+	/* AC queue report of a tracked data frame or keep alive null data, not an ACK of mgmt frame */
+	if (ac_queue
+		&& rtw_tx_cmpl_track_report(Adapter
+			, GET_8192E_C2H_TX_RPT_MAC_ID(CmdBuf)
+			, ok
+			, GET_8192E_C2H_TX_RPT_DATA_RETRY_CNT(CmdBuf)
+			, GET_8192E_C2H_TX_RPT_FINAL_DATA_RATE(CmdBuf)) == _SUCCESS)
+		goto exit;
+#endif
 #ifdef CONFIG_XMIT_ACK
-	if (GET_8192E_C2H_TX_RPT_RETRY_OVER(CmdBuf) | GET_8192E_C2H_TX_RPT_LIFE_TIME_OVER(CmdBuf))
+	if (!ok)
 		rtw_ack_tx_done(&Adapter->xmitpriv, RTW_SCTX_DONE_CCX_PKT_FAIL);
 	else
 		rtw_ack_tx_done(&Adapter->xmitpriv, RTW_SCTX_DONE_SUCCESS);
 #endif
+
+exit:
 #ifdef DBG_CCX
 	dump_txrpt_ccx_92e(CmdBuf);
 #endif
-
+	return;
 }
 
 s32 c2h_handler_8192e(_adapter *adapter, u8 id, u8 seq, u8 plen, u8 *payload)
@@ -1040,6 +1040,56 @@ phy_SwChnl8192E(
 
 }
 
+#ifdef CONFIG_RTW_IQK_CACHE
+/*
+* IQK takes ~100ms on 8192E and is redone after every HAL init (ifup, IPS leave).
+* Reuse the result of the same channel/bw if temperature has not drifted,
+* power tracking still redoes IQK when it drifts later on.
+*/
+static void phy_iqk_8192e(PADAPTER Adapter)
+{
+	HAL_DATA_TYPE *pHalData = GET_HAL_DATA(Adapter);
+	struct dm_struct *pDM_Odm = &pHalData->odmpriv;
+	struct dm_rf_calibration_struct *cali_info = &pDM_Odm->rf_calibrate_info;
+	struct iqk_matrix_regs_setting *iqk_matrix;
+	struct hal_iqk_cache_ent *ent;
+	u8 ch = pHalData->current_channel;
+	u8 bw = pHalData->current_channel_bw;
+	u8 thermal;
+
+	if (!Adapter->registrypriv.iqk_cache
+		#if (MP_DRIVER == 1)
+		|| Adapter->registrypriv.mp_mode == 1
+		#endif
+	) {
+		halrf_iqk_trigger(pDM_Odm, _FALSE);
+		return;
+	}
+
+	thermal = (u8)phy_query_rf_reg(Adapter, RF_PATH_A, RF_T_METER_8192E, 0xfc00);
+	if (thermal == 0) {
+		/* thermal meter not ready, can't tell drift */
+		halrf_iqk_trigger(pDM_Odm, _FALSE);
+		return;
+	}
+
+	ent = rtw_hal_iqk_cache_search(Adapter, ch, bw, thermal, IQK_THRESHOLD);
+	if (ent) {
+		phy_iq_calibrate_8192e_reload(pDM_Odm, ent->result);
+		cali_info->thermal_value_iqk = ent->thermal;
+		return;
+	}
+
+	iqk_matrix = &cali_info->iqk_matrix_reg_setting[odm_get_right_chnl_place_for_iqk(ch)];
+	iqk_matrix->is_iqk_done = false;
+
+	halrf_iqk_trigger(pDM_Odm, _FALSE);
+
+	if (iqk_matrix->is_iqk_done)
+		rtw_hal_iqk_cache_add(Adapter, ch, bw, thermal, iqk_matrix->value[0]);
+}
+#endif /* CONFIG_RTW_IQK_CACHE */
+
 VOID
 phy_SwChnlAndSetBwMode8192E(
 	IN  PADAPTER		Adapter
@@ -1080,7 +1130,11 @@ phy_SwChnlAndSetBwMode8192E(
 	if (pHalData->bNeedIQK == _TRUE) {
 		if (pHalData->neediqk_24g == _TRUE) {
 
+			#ifdef CONFIG_RTW_IQK_CACHE
+			phy_iqk_8192e(Adapter);
+			#else
 			halrf_iqk_trigger(&pHalData->odmpriv, _FALSE);
+			#endif
 			pHalData->bIQKInitialized = _TRUE;
 			pHalData->neediqk_24g = _FALSE;
 		}
@@ -188,6 +188,26 @@ static s32 update_txdesc(struct xmit_frame *pxmitframe, u8 *pmem, s32 sz , u8 ba
 			/* for debug */
 			rtl8192e_fixed_rate(padapter, ptxdesc);
 
+#ifdef CONFIG_RTW_HOST_RA
+			if (rtw_host_ra_select(padapter, pxmitframe)) {
+				SET_TX_DESC_USE_RATE_92E(ptxdesc, 1);
+				SET_TX_DESC_TX_RATE_92E(ptxdesc, pattrib->hra_rate);
+				SET_TX_DESC_DATA_SHORT_92E(ptxdesc,
+					(pattrib->hra_rate >= DESC_RATEMCS0 && pattrib->sgi) ? 1 : 0);
+
+				/* HW fallback stays on, only keep the sample rate out of others' aggregation */
+				if (pattrib->hra_flags & HOST_RA_F_SAMPLE) {
+					SET_TX_DESC_AGG_ENABLE_92E(ptxdesc, 0);
+					SET_TX_DESC_BK_92E(ptxdesc, 1);
+				}
+			}
+#endif
+
+#ifdef CONFIG_TX_CMPL_TRACK
+			if (rtw_tx_cmpl_track_push(padapter, pxmitframe))
+				SET_TX_DESC_SPE_RPT_92E(ptxdesc, 1);
+#endif
+
 			if (pattrib->ldpc)
 				SET_TX_DESC_DATA_LDPC_92E(ptxdesc, 1);
 			if (pattrib->stbc)
@@ -248,7 +268,12 @@ static s32 update_txdesc(struct xmit_frame *pxmitframe, u8 *pmem, s32 sz , u8 ba
 
 #ifdef CONFIG_XMIT_ACK
 		/* CCX-TXRPT ack for xmit mgmt frames. */
-		if (pxmitframe->ack_report) {
+		if (pxmitframe->ack_report
+			#ifdef CONFIG_TX_CMPL_TRACK
+			/* keep alive null data is reported only if its place in macid's reports is known */
+			&& (!pattrib->aka_probe || rtw_tx_cmpl_track_push(padapter, pxmitframe))
+			#endif
+		) {
 			SET_TX_DESC_SPE_RPT_92E(ptxdesc, 1);
 #ifdef DBG_CCX
 			RTW_INFO("%s set tx report\n", __func__);
@@ -460,6 +485,10 @@ s32 rtl8192eu_xmitframe_complete(_adapter *padapter, struct xmit_priv *pxmitpriv
 
 	_list *sta_plist, *sta_phead;
 	u8 single_sta_in_queue = _FALSE;
+	s32 coalesced;
+#ifdef CONFIG_TX_AMSDU
+	u8 amsdu_num;
+#endif
 
 #ifndef IDEA_CONDITION
 	int res = _SUCCESS;
@@ -469,6 +498,9 @@ s32 rtl8192eu_xmitframe_complete(_adapter *padapter, struct xmit_priv *pxmitpriv
 
 	/* check xmitbuffer is ok */
 	if (pxmitbuf == NULL) {
+		/* only BE/BK frames pending, keep the reserved xmitbufs for VO/VI */
+		if (rtw_xmitbuf_rsvd_blocked(pxmitpriv))
+			return _FALSE;
 		pxmitbuf = rtw_alloc_xmitbuf(pxmitpriv);
 		if (pxmitbuf == NULL) {
 			/* RTW_INFO("%s #1, connot alloc xmitbuf!!!!\n",__FUNCTION__); */
@@ -476,6 +508,15 @@ s32 rtl8192eu_xmitframe_complete(_adapter *padapter, struct xmit_priv *pxmitpriv
 		}
 	}
 
+#ifdef CONFIG_TX_AMSDU
+	amsdu_num = rtw_amsdu_xmit_check(padapter);
+	if (amsdu_num == 0) {
+		/* wait for more A-MSDU subframes, the flush timer kicks TX again */
+		rtw_free_xmitbuf(pxmitpriv, pxmitbuf);
+		return _FALSE;
+	}
+#endif
+
 	/* RTW_INFO("%s =====================================\n",__FUNCTION__); */
 	/* 3 1. pick up first frame */
 	do {
@@ -514,7 +555,12 @@ s32 rtl8192eu_xmitframe_complete(_adapter *padapter, struct xmit_priv *pxmitpriv
 		pxmitframe->pkt_offset = (PACKET_OFFSET_SZ / 8); /* 1; */ /* first frame of aggregation, reserve offset */
 #endif
 
-		if (rtw_xmitframe_coalesce(padapter, pxmitframe->pkt, pxmitframe) == _FALSE) {
+#ifdef CONFIG_TX_AMSDU
+		coalesced = rtw_amsdu_coalesce_xframe(padapter, pxmitframe, amsdu_num);
+#else
+		coalesced = rtw_xmitframe_coalesce(padapter, pxmitframe->pkt, pxmitframe);
+#endif
+		if (coalesced == _FALSE) {
 			RTW_INFO("%s coalesce 1st xmitframe failed\n", __FUNCTION__);
 			continue;
 		}
@@ -529,6 +575,11 @@ s32 rtl8192eu_xmitframe_complete(_adapter *padapter, struct xmit_priv *pxmitpriv
 	/* 3 2. aggregate same priority and same DA(AP or STA) frames */
 	pfirstframe = pxmitframe;
 	len = rtw_wlan_pkt_size(pfirstframe) + TXDESC_SIZE + (pfirstframe->pkt_offset * PACKET_OFFSET_SZ);
+#ifdef CONFIG_TX_AMSDU
+	/* A-MSDU carries more than its own MSDU */
+	if (pfirstframe->attrib.amsdu)
+		len = pfirstframe->attrib.last_txcmdsz + TXDESC_SIZE + (pfirstframe->pkt_offset * PACKET_OFFSET_SZ);
+#endif
 	pbuf_tail = len;
 	pbuf = _RND8(pbuf_tail);
 
@@ -751,6 +802,8 @@ s32 rtl8192eu_xmitframe_complete(_adapter *padapter, struct xmit_priv *pxmitpriv
 
 
 	if (pxmitbuf == NULL) {
+		if (rtw_xmitbuf_rsvd_blocked(pxmitpriv))
+			return _FALSE;
 		pxmitbuf = rtw_alloc_xmitbuf(pxmitpriv);
 		if (!pxmitbuf)
 			return _FALSE;
@@ -843,6 +896,10 @@ static s32 pre_xmitframe(_adapter *padapter, struct xmit_frame *pxmitframe)
 	if (DEV_STA_LG_NUM(padapter->dvobj))
 		goto enqueue;
 
+	/* BE/BK (UP 0~3) can't take the xmitbufs reserved for VO/VI */
+	if (pattrib->priority < 4 && rtw_xmitbuf_rsvd_blocked(pxmitpriv))
+		goto enqueue;
+
 	pxmitbuf = rtw_alloc_xmitbuf(pxmitpriv);
 	if (pxmitbuf == NULL)
 		goto enqueue;
@@ -1137,6 +1137,11 @@ u32 rtl8192eu_hal_init(PADAPTER Adapter)
 		if (pwrctrlpriv->rf_pwrstate == rf_on) {
 
 			pHalData->neediqk_24g  = _TRUE;
+			#ifdef CONFIG_RTW_IQK_CACHE
+			/* kept over IPS leave, thermal check of each entry covers drift there */
+			if (Adapter->registrypriv.iqk_cache == 1 && pwrctrlpriv->bips_processing != _TRUE)
+				rtw_hal_iqk_cache_flush(Adapter);
+			#endif
 			HAL_INIT_PROFILE_TAG(HAL_INIT_STAGES_PW_TRACK);
 
 			odm_txpowertracking_check(&pHalData->odmpriv);
@@ -53,6 +53,8 @@
 #define CONFIG_XMIT_ACK
 #ifdef CONFIG_XMIT_ACK
 	#define CONFIG_ACTIVE_KEEP_ALIVE_CHECK
+	/* #define CONFIG_TX_CMPL_TRACK */	/* per data frame TX report tracking, enabled at runtime by proc tx_cmpl_stat */
+	/* #define CONFIG_RTW_HOST_RA */	/* host side rate control by TX reports, enabled at runtime by proc host_ra, needs CONFIG_TX_CMPL_TRACK */
 #endif
 #define CONFIG_80211N_HT
 
@@ -64,6 +66,8 @@
 #define CONFIG_PREALLOC_RECV_SKB   /* Pre-allocate SKBs for better RX performance */
 #define CONFIG_USE_USB_BUFFER_ALLOC_RX  /* Use USB buffer allocation for RX */
 #define CONFIG_USE_USB_BUFFER_ALLOC_TX  /* Use USB buffer allocation for TX */
+#define CONFIG_TXPWR_IDX_CACHE  /* Resolve TX power index of a channel once instead of on every channel switch */
+#define CONFIG_RTW_IQK_CACHE  /* Reuse IQK result of the same channel/bw and temperature, see module param rtw_iqk_cache */
 
  /* #define CONFIG_SUPPORT_USB_INT */
  #ifdef CONFIG_SUPPORT_USB_INT
@@ -272,6 +276,13 @@
 
 #ifdef CONFIG_USB_TX_AGGREGATION
 /* #define	CONFIG_TX_EARLY_MODE */
+/*
+ * A-MSDU TX, only built into the USB TX aggregation path. The adaptive
+ * controller (proc tx_amsdu_adapt) picks the subframe count and flush timeout
+ * per STA and AC. While more subframes are wanted, TX of the head frame is
+ * held until they are queued or the flush timer of that AC expires.
+ */
+/* #define CONFIG_TX_AMSDU */
 #endif
 
 #ifdef CONFIG_TX_EARLY_MODE
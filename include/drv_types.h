@@ -97,6 +97,7 @@ typedef struct _ADAPTER _adapter, ADAPTER, *PADAPTER;
 #include <rtw_ioctl_rtl.h>
 #include <osdep_intf.h>
 #include <rtw_eeprom.h>
+#include <rtw_host_ra.h>
 #include <sta_info.h>
 #include <rtw_event.h>
 #include <rtw_mlme_ext.h>
@@ -274,6 +275,11 @@ struct registry_priv {
 	u8	low_power ;
 
 	u8	wifi_spec;/* !turbo_mode */
+	u16	tx_ac_rsvd[4]; /* xmitframes reserved for each AC, index by XX_QUEUE_INX */
+	u16	tx_ac_quota[4]; /* max xmitframes of each AC, 0: no limit */
+	u8	tx_xmitbuf_rsvd;
+	u16	ps_sleepq_max_len; /* per STA limit of frames buffered for power save */
+	u32	ps_sleepq_max_bytes;
 	u8	special_rf_path; /* 0: 2T2R ,1: only turn on path A 1T1R */
 	char alpha2[2];
 	u8	channel_plan;
@@ -355,6 +361,7 @@ struct registry_priv {
 #ifdef CONFIG_LOAD_PHY_PARA_FROM_FILE
 	u8	load_phy_file;
 	u8	RegDecryptCustomFile;
+	u8	phy_file_bin;
 #endif
 #ifdef CONFIG_CONCURRENT_MODE
 	u8 virtual_iface_num;
@@ -424,6 +431,9 @@ struct registry_priv {
 
 	u8 iqk_fw_offload;
 	u8 ch_switch_offload;
+#ifdef CONFIG_RTW_IQK_CACHE
+	u8 iqk_cache;
+#endif
 
 #ifdef CONFIG_TDLS
 	u8 en_tdls;
@@ -1104,6 +1114,10 @@ struct dvobj_priv {
 	_timer txbcn_timer;
 #endif
 	_timer dynamic_chk_timer; /* dynamic/periodic check timer */
+	struct rtw_wdog_task wdog_task[WDOG_TASK_NUM];
+	u32 wdog_last_tp;	/* tx + rx Mbps seen by last watchdog tick */
+	u8 wdog_last_assoc;
+	u8 wdog_input_changed;
 	
 #ifdef CONFIG_RTW_NAPI_DYNAMIC
 	u8 en_napi_dynamic;
@@ -1155,6 +1169,8 @@ struct dvobj_priv {
 	u8 *usb_vendor_req_buf;
 #endif
 
+	ATOMIC_T usb_ctrl_xfer_cnt; /* vendor requests issued, including retries */
+
 
 #ifdef PLATFORM_LINUX
 	struct usb_interface *pusbintf;
@@ -1618,6 +1634,8 @@ struct _ADAPTER {
 #ifdef CONFIG_TX_AMSDU
 	u8 tx_amsdu;
 	u16 tx_amsdu_rate;
+	u8 tx_amsdu_max_num; /* upper bound of subframes chosen by adaptive A-MSDU */
+	u16 tx_amsdu_lat_budget; /* BE latency budget in us for adaptive A-MSDU */
 #endif
 	u8 driver_tx_max_agg_num; /*fix tx desc max agg num , 0xff: disable drv ctrl*/
 #ifdef DBG_RX_COUNTER_DUMP
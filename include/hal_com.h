@@ -559,6 +559,13 @@ s8 rtw_hal_ch_sw_iqk_info_search(_adapter *padapter, u8 central_chnl, u8 bw_mode
 void rtw_hal_ch_sw_iqk_info_backup(_adapter *adapter);
 void rtw_hal_ch_sw_iqk_info_restore(_adapter *padapter, u8 ch_sw_use_case);
 
+#ifdef CONFIG_RTW_IQK_CACHE
+struct hal_iqk_cache_ent *rtw_hal_iqk_cache_search(_adapter *adapter, u8 ch, u8 bw, u8 thermal, u8 thermal_th);
+void rtw_hal_iqk_cache_add(_adapter *adapter, u8 ch, u8 bw, u8 thermal, const s32 *result);
+void rtw_hal_iqk_cache_flush(_adapter *adapter);
+void dump_iqk_cache(void *sel, _adapter *adapter);
+#endif
+
 #ifdef CONFIG_GPIO_WAKEUP
 	void rtw_hal_switch_gpio_wl_ctrl(_adapter *padapter, u8 index, u8 enable);
 	void rtw_hal_set_output_gpio(_adapter *padapter, u8 index, u8 outputval);
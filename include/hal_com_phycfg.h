@@ -201,6 +201,10 @@ struct txpwr_idx_comp {
 	s8 ebias;
 };
 
+#ifdef CONFIG_TXPWR_IDX_CACHE
+void phy_txpwr_idx_cache_invalidate(_adapter *adapter);
+#endif
+
 u8
 phy_get_tx_power_index(
 	IN	PADAPTER			pAdapter,
@@ -283,6 +287,42 @@ int rtw_get_phy_file_path(_adapter *adapter, const char *file_name);
 #define LOAD_RF_TXPWR_TRACK_PARA_FILE	BIT5
 #define LOAD_RF_TXPWR_LMT_PARA_FILE		BIT6
 
+/*
+* Binary form of parsed PHY_REG_PG.txt and TXPWR_LMT.txt, stored as <name>.bin
+* Host endian, values in txgi unit of the chip producing it,
+* valid only for the text file of src_len and src_csum it's parsed from
+*/
+#define PHY_PARA_BIN_MAGIC	0x42505452	/* "RTPB" */
+#define PHY_PARA_BIN_VER	2
+
+#define PHY_PARA_BIN_BY_RATE	1	/* payload: TxPwrByRateOffset */
+#define PHY_PARA_BIN_LMT		2	/* payload: regd exc records, then txpwr_lmt_ent records */
+
+/* para[] of PHY_PARA_BIN_BY_RATE */
+#define PHY_PARA_BIN_BY_RATE_PG_VER		0
+#define PHY_PARA_BIN_BY_RATE_PG_VAL_TYPE	1
+#define PHY_PARA_BIN_BY_RATE_SIZE		2
+
+/* para[] of PHY_PARA_BIN_LMT */
+#define PHY_PARA_BIN_LMT_EXC_NUM		0
+#define PHY_PARA_BIN_LMT_REGD_NUM		1
+#define PHY_PARA_BIN_LMT_2G_SIZE		2
+#define PHY_PARA_BIN_LMT_5G_SIZE		3
+
+struct phy_para_bin_hdr {
+	u32 magic;
+	u16 ver;
+	u8 type;
+	u8 txgi_max;
+	u8 txgi_pdbm;
+	u8 rsvd[3];
+	u32 len;	/* payload length */
+	u32 csum;	/* byte sum of payload */
+	u32 src_len;	/* length of source text file */
+	u32 src_csum;	/* byte sum of source text file */
+	u32 para[4];	/* type specific */
+};
+
 int phy_ConfigMACWithParaFile(IN PADAPTER	Adapter, IN char	*pFileName);
 int phy_ConfigBBWithParaFile(IN PADAPTER	Adapter, IN char	*pFileName, IN u32	ConfigType);
 int phy_ConfigBBWithPgParaFile(IN PADAPTER	Adapter, IN const char *pFileName);
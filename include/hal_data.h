@@ -205,6 +205,18 @@ typedef struct _BB_INIT_REGISTER {
 #define MAX_IQK_INFO_BACKUP_CHNL_NUM	5
 #define MAX_IQK_INFO_BACKUP_REG_NUM		10
 
+#ifdef CONFIG_RTW_IQK_CACHE
+#define IQK_CACHE_ENT_NUM	8
+#define IQK_CACHE_RESULT_NUM	8	/* same as iqk_matrix_reg_num of halrf */
+
+struct hal_iqk_cache_ent {
+	u8 ch;		/* 0: empty */
+	u8 bw;
+	u8 thermal;	/* thermal meter when calibrated */
+	s32 result[IQK_CACHE_RESULT_NUM];
+};
+#endif
+
 struct kfree_data_t {
 	u8 flag;
 	s8 bb_gain[BB_GAIN_NUM][RF_PATH_MAX];
@@ -336,6 +348,13 @@ struct txpwr_lmt_ent {
 };
 #endif /* CONFIG_TXPWR_LIMIT */
 
+#ifdef CONFIG_TXPWR_IDX_CACHE
+/* 2.4G only, entry of BW20 for each channel, entries of BW40 for each (cch_40, primary lower/upper) */
+#define TXPWR_IDX_CACHE_PATH_NUM	2
+#define TXPWR_IDX_CACHE_ENT_NUM		(CENTER_CH_2G_NUM * 3)
+#define TXPWR_IDX_CACHE_RATE_NUM	(DESC_RATEMCS15 + 1)	/* CCK, OFDM, HT MCS0~15 */
+#endif
+
 typedef struct hal_com_data {
 	HAL_VERSION			version_id;
 	RT_MULTI_FUNC		MultiFunc; /* For multi-function consideration. */
@@ -494,6 +513,17 @@ typedef struct hal_com_data {
 	u8	txpwr_limit_from_file:1;
 	u8	rf_power_tracking_type;
 
+#ifdef CONFIG_TXPWR_IDX_CACHE
+	/* TX power index before power tracking offset, index by DESC_RATEXXX */
+	s8	txpwr_idx_cache[TXPWR_IDX_CACHE_PATH_NUM]
+		[TXPWR_IDX_CACHE_ENT_NUM]
+		[TXPWR_IDX_CACHE_RATE_NUM];
+	u8	txpwr_idx_cache_valid[TXPWR_IDX_CACHE_PATH_NUM][TXPWR_IDX_CACHE_ENT_NUM]; /* bitmap of rate section */
+	const char *txpwr_idx_cache_regd; /* regd_name the cache is built for */
+	u32	txpwr_idx_cache_hit;
+	u32	txpwr_idx_cache_miss;
+#endif
+
 	/* Read/write are allow for following hardware information variables	 */
 	u8	crystal_cap;
 
@@ -760,6 +790,12 @@ typedef struct hal_com_data {
 	u8 BackUp_IG_REG_4_Chnl_Section[4]; /*{A,B,C,D}*/
 
 	struct hal_iqk_reg_backup iqk_reg_backup[MAX_IQK_INFO_BACKUP_CHNL_NUM];
+#ifdef CONFIG_RTW_IQK_CACHE
+	struct hal_iqk_cache_ent iqk_cache[IQK_CACHE_ENT_NUM];
+	u8 iqk_cache_next;	/* entry to replace when full */
+	u32 iqk_cache_hit;
+	u32 iqk_cache_miss;
+#endif
 
 #ifdef RTW_HALMAC
 	u16 drv_rsvd_page_number;
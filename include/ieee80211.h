@@ -1807,6 +1807,24 @@ struct rtw_ieee80211_channel {
 	/*, (channel)->orig_mpwr*/ \
 
 /* Parsed Information Elements */
+/* Max number of IEs whose offsets are kept by struct rtw_ie_idx */
+#define RTW_IE_IDX_NUM 32
+
+/*
+ * One-pass offset index of a TLV IE buffer, so that repeated lookups on the
+ * same frame don't rescan it from the start. Lookups return the first match
+ * like rtw_get_ie()/rtw_get_ie_ex(). IEs from @tail on (index full or last IE
+ * truncated) are not indexed and are searched linearly instead.
+ */
+struct rtw_ie_idx {
+	u8 *ies;
+	uint ies_len;
+	uint tail;
+	u32 eid_map[8]; /* bitmap of all element IDs present */
+	u16 ofs[RTW_IE_IDX_NUM];
+	u8 num;
+};
+
 struct rtw_ieee802_11_elems {
 	u8 *ssid;
 	u8 ssid_len;
@@ -1872,6 +1890,7 @@ struct rtw_ieee802_11_elems {
 	u8 *rann;
 	u8 rann_len;
 #endif
+	struct rtw_ie_idx idx;
 };
 
 typedef enum { ParseOK = 0, ParseUnknown = 1, ParseFailed = -1 } ParseRes;
@@ -1897,6 +1916,10 @@ u8 *rtw_set_ie_mesh_ch_switch_parm(u8 *buf, u32 *buf_len, u8 ttl, u8 flags, u16
 u8 *rtw_get_ie(const u8 *pbuf, sint index, sint *len, sint limit);
 int rtw_remove_ie_g_rate(u8 *ie, uint *ie_len, uint offset, u8 eid);
 u8 *rtw_get_ie_ex(const u8 *in_ie, uint in_len, u8 eid, const u8 *oui, u8 oui_len, u8 *ie, uint *ielen);
+
+void rtw_ie_idx_build(struct rtw_ie_idx *idx, u8 *ies, uint ies_len);
+u8 *rtw_ie_idx_get_ie(struct rtw_ie_idx *idx, u8 eid, sint *len);
+u8 *rtw_ie_idx_get_ie_ex(struct rtw_ie_idx *idx, u8 eid, const u8 *oui, u8 oui_len, u8 *ie, uint *ielen);
 int rtw_ies_remove_ie(u8 *ies, uint *ies_len, uint offset, u8 eid, u8 *oui, u8 oui_len);
 
 void rtw_set_supported_rate(u8 *SupportedRates, uint mode) ;
@@ -1961,6 +1984,7 @@ void dump_ht_cap_ie_content(void *sel, const u8 *buf, u32 buf_len);
 void dump_wps_ie(void *sel, const u8 *ie, u32 ie_len);
 
 void rtw_ies_get_chbw(u8 *ies, int ies_len, u8 *ch, u8 *bw, u8 *offset, u8 ht, u8 vht);
+void rtw_ie_idx_get_chbw(struct rtw_ie_idx *idx, u8 *ch, u8 *bw, u8 *offset, u8 ht, u8 vht);
 
 void rtw_bss_get_chbw(WLAN_BSSID_EX *bss, u8 *ch, u8 *bw, u8 *offset, u8 ht, u8 vht);
 
@@ -330,6 +330,7 @@ extern s32	_rtw_get_passing_time_ms(systime start);
 extern s32 _rtw_get_remaining_time_ms(systime end);
 extern s32	_rtw_get_time_interval_ms(systime start, systime end);
 extern bool _rtw_time_after(systime a, systime b);
+extern u64 rtw_get_current_time_us(void);
 
 #ifdef DBG_SYSTIME
 #define rtw_get_current_time() ({systime __stime = _rtw_get_current_time(); __stime;})
@@ -544,8 +545,41 @@ static inline int largest_bit(u32 bitmask)
 	return i;
 }
 
+/*
+* rtw_log2_bucket - bucket index of a log2 histogram
+* bucket 0 counts 0, bucket n counts [2^(n-1), 2^n), last bucket counts the rest
+*/
+static inline u8 rtw_log2_bucket(u32 val, u8 bucket_num)
+{
+	int idx = val ? largest_bit(val) + 1 : 0;
+
+	return idx >= bucket_num ? bucket_num - 1 : idx;
+}
+
+/* index of the first zero bit, 32 if all bits are set */
+static inline u8 rtw_ffz32(u32 val)
+{
+	if (val == 0xFFFFFFFF)
+		return 32;
+#ifdef PLATFORM_LINUX
+	return __ffs(~val);
+#else
+	return bitshift(~val);
+#endif
+}
+
 #define rtw_abs(a) (a < 0 ? -a : a)
 #define rtw_min(a, b) ((a > b) ? b : a)
+#define rtw_max(a, b) ((a > b) ? a : b)
+
+#ifdef PLATFORM_LINUX
+#define rtw_wmb() smp_wmb()
+#define rtw_mb() smp_mb()
+#else
+#define rtw_wmb() do {} while (0)
+#define rtw_mb() do {} while (0)
+#endif
+
 #define rtw_is_range_a_in_b(hi_a, lo_a, hi_b, lo_b) (((hi_a) <= (hi_b)) && ((lo_a) >= (lo_b)))
 #define rtw_is_range_overlap(hi_a, lo_a, hi_b, lo_b) (((hi_a) > (lo_b)) && ((lo_a) < (hi_b)))
 
@@ -36,6 +36,9 @@ void _update_beacon(_adapter *padapter, u8 ie_id, u8 *oui, u8 tx, const char *ta
 void rtw_ap_update_sta_ra_info(_adapter *padapter, struct sta_info *psta);
 
 void expire_timeout_chk(_adapter *padapter);
+#ifdef CONFIG_XMIT_ACK
+s32 rtw_ap_aka_probe_report(_adapter *adapter, u8 mac_id, bool acked);
+#endif
 void update_sta_info_apmode(_adapter *padapter, struct sta_info *psta);
 void rtw_start_bss_hdl_after_chbw_decided(_adapter *adapter);
 void start_bss_network(_adapter *padapter, struct createbss_parm *parm);
@@ -79,9 +82,9 @@ extern void rtw_start_auto_ap(_adapter *adapter);
 #endif /* CONFIG_AUTO_AP_MODE */
 
 void rtw_ap_parse_sta_capability(_adapter *adapter, struct sta_info *sta, u8 *cap);
-u16 rtw_ap_parse_sta_supported_rates(_adapter *adapter, struct sta_info *sta, u8 *tlv_ies, u16 tlv_ies_len);
+u16 rtw_ap_parse_sta_supported_rates(_adapter *adapter, struct sta_info *sta, struct rtw_ieee802_11_elems *elems);
 u16 rtw_ap_parse_sta_security_ie(_adapter *adapter, struct sta_info *sta, struct rtw_ieee802_11_elems *elems);
-void rtw_ap_parse_sta_wmm_ie(_adapter *adapter, struct sta_info *sta, u8 *tlv_ies, u16 tlv_ies_len);
+void rtw_ap_parse_sta_wmm_ie(_adapter *adapter, struct sta_info *sta, struct rtw_ieee802_11_elems *elems);
 void rtw_ap_parse_sta_ht_ie(_adapter *adapter, struct sta_info *sta, struct rtw_ieee802_11_elems *elems);
 void rtw_ap_parse_sta_vht_ie(_adapter *adapter, struct sta_info *sta, struct rtw_ieee802_11_elems *elems);
 
@@ -38,10 +38,46 @@ struct cmd_obj {
 	u32	rspsz;
 	struct submit_ctx *sctx;
 	u8 no_io;
+	u8 cls;		/* enum rtw_cmd_class, assigned by rtw_enqueue_cmd */
+	systime enq_time;
 	/* _sema 	cmd_sem; */
 	_list	list;
 };
 
+/*
+* cmd scheduling classes, each with its own queue
+* rtw_cmd_thread serves them in weighted round robin with CMD_CLS_*_QUOTA credits,
+* so a burst of urgent cmds can't starve normal and background ones.
+* Only cmds whose effect doesn't depend on their order against other queued
+* cmds are moved out of CMD_CLS_NORMAL, see rtw_cmd_classify()
+* Ordering rule: cmds of the same adapter run in enqueue order, a promoted cmd
+* stays in CMD_CLS_NORMAL while a cmd of its adapter is pending there.
+*/
+enum rtw_cmd_class {
+	CMD_CLS_URGENT = 0,
+	CMD_CLS_NORMAL,
+	CMD_CLS_BG,
+	CMD_CLS_NUM,
+};
+
+#define CMD_CLS_URGENT_QUOTA	4
+#define CMD_CLS_NORMAL_QUOTA	2
+#define CMD_CLS_BG_QUOTA	1
+
+/* log2 histogram in ms, see rtw_log2_bucket() */
+#define CMD_LAT_HIST_NUM 12
+/* log2 histogram of cmds handled per cmd thread wakeup */
+#define CMD_BATCH_HIST_NUM 8
+
+struct cmd_lat_stat {
+	u32 cnt;
+	u32 merged;		/* coalesced into a pending one, see rtw_cmd_coalesce() */
+	u32 wait_max_ms;	/* enqueue to start */
+	u32 run_max_ms;		/* start to done */
+	u32 wait_hist[CMD_LAT_HIST_NUM];
+	u32 run_hist[CMD_LAT_HIST_NUM];
+};
+
 /* cmd flags */
 enum {
 	RTW_CMDF_DIRECTLY = BIT0,
@@ -53,7 +89,17 @@ struct cmd_priv {
 	/* _sema	cmd_done_sema; */
 	_sema	start_cmdthread_sema;
 
-	_queue	cmd_queue;
+	_queue	cmd_queue[CMD_CLS_NUM];
+	u8	cls_credit[CMD_CLS_NUM];	/* remaining quota of current round, cmd thread only */
+	u32	cls_enq_cnt[CMD_CLS_NUM];
+	u32	cmd_merged_cnt;
+	/*
+	* cmds enqueued since cmd thread last woke up, only the first one ups
+	* cmd_queue_sema; cmd thread drains all queues on each wakeup
+	*/
+	ATOMIC_T cmd_kick;
+	u32	wakeup_cnt;
+	u32	batch_hist[CMD_BATCH_HIST_NUM];
 	u8	cmd_seq;
 	u8	*cmd_buf;	/* shall be non-paged, and 4 bytes aligned */
 	u8	*cmd_allocated_buf;
@@ -67,6 +113,9 @@ struct cmd_priv {
 
 	_adapter *padapter;
 	_mutex sctx_mutex;
+
+	/* indexed by rtw_cmd_lat_idx(), MAX_H2CCMD + MAX_WK_CID entries */
+	struct cmd_lat_stat *lat;
 };
 
 #ifdef CONFIG_EVENT_THREAD_MODE
@@ -402,6 +451,7 @@ struct sitesurvey_parm {
 	u16 duration;	/* 0: use default, otherwise: channel scan time */
 	u8 igi;		/* 0: use defalut */
 	u8 bw;		/* 0: use default */
+	u8 bg_scan;	/* 1: background scan issued by driver itself */
 };
 
 /*
@@ -1061,6 +1111,35 @@ extern u8 rtw_reset_securitypriv_cmd(_adapter *padapter);
 extern u8 rtw_free_assoc_resources_cmd(_adapter *padapter, u8 lock_scanned_queue, int flags);
 extern u8 rtw_dynamic_chk_wk_cmd(_adapter *adapter);
 
+/*
+* subsystem tasks of rtw_dynamic_chk_wk_hdl(), in running order
+* each runs every 'period' watchdog ticks (2s), see wdog_task_def[]
+*/
+enum rtw_wdog_task_id {
+	WDOG_TASK_IFACE = 0,
+	WDOG_TASK_HEALTH,
+	WDOG_TASK_USB_AGG,
+	WDOG_TASK_DM,
+	WDOG_TASK_BTCOEX,
+	WDOG_TASK_PS,
+	WDOG_TASK_MCC,
+	WDOG_TASK_TSF,
+	WDOG_TASK_NUM,
+};
+
+struct rtw_wdog_task {
+	u8 period;	/* in watchdog ticks */
+	u8 countdown;	/* ticks to skip before next run */
+	u32 run_cnt;
+	u32 skip_cnt;
+	u64 time_us;	/* accumulated running time in cmd thread */
+	u32 time_max_us;
+	u32 xfer_cnt;	/* bus register transfers issued while running */
+};
+
+void dump_wdog_task(void *sel, _adapter *adapter);
+void rtw_wdog_task_reset(_adapter *adapter);
+
 u8 rtw_lps_ctrl_wk_cmd(_adapter *padapter, u8 lps_ctrl_type, u8 flags);
 u8 rtw_lps_ctrl_leave_set_level_cmd(_adapter *adapter, u8 lps_level, u8 flags);
 u8 rtw_dm_in_lps_wk_cmd(_adapter *padapter);
@@ -1349,6 +1428,11 @@ struct _cmd_callback	rtw_cmd_callback[] = {
 };
 #endif
 
+#define CMD_LAT_STAT_NUM (MAX_H2CCMD + MAX_WK_CID)
+
+void dump_cmd_lat(void *sel, struct cmd_priv *cmdpriv);
+void rtw_cmd_lat_reset(struct cmd_priv *cmdpriv);
+
 #define CMD_FMT "cmd=%d,%d,%d"
 #define CMD_ARG(cmd) \
 	(cmd)->cmdcode, \
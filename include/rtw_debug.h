@@ -310,6 +310,8 @@ ssize_t proc_set_read_reg(struct file *file, const char __user *buffer, size_t c
 int proc_get_fwstate(struct seq_file *m, void *v);
 int proc_get_sec_info(struct seq_file *m, void *v);
 int proc_get_mlmext_state(struct seq_file *m, void *v);
+int proc_get_fast_reconn(struct seq_file *m, void *v);
+ssize_t proc_set_fast_reconn(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 #ifdef CONFIG_LAYER2_ROAMING
 int proc_get_roam_flags(struct seq_file *m, void *v);
 ssize_t proc_set_roam_flags(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
@@ -378,9 +380,28 @@ ssize_t proc_set_ap_linking_test(struct file *file, const char __user *buffer, s
 
 int proc_get_rx_stat(struct seq_file *m, void *v);
 int proc_get_tx_stat(struct seq_file *m, void *v);
+int proc_get_tx_ac_quota(struct seq_file *m, void *v);
+ssize_t proc_set_tx_ac_quota(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+#ifdef CONFIG_TX_CMPL_TRACK
+int proc_get_tx_cmpl_stat(struct seq_file *m, void *v);
+ssize_t proc_set_tx_cmpl_stat(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+#endif
+#ifdef CONFIG_RTW_HOST_RA
+int proc_get_host_ra(struct seq_file *m, void *v);
+ssize_t proc_set_host_ra(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+#endif
+#ifdef CONFIG_RTW_IQK_CACHE
+int proc_get_iqk_cache(struct seq_file *m, void *v);
+ssize_t proc_set_iqk_cache(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+#endif
+int proc_get_cmd_lat(struct seq_file *m, void *v);
+ssize_t proc_set_cmd_lat(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+int proc_get_wdog_task(struct seq_file *m, void *v);
+ssize_t proc_set_wdog_task(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 #ifdef CONFIG_AP_MODE
 int proc_get_all_sta_info(struct seq_file *m, void *v);
 #endif /* CONFIG_AP_MODE */
+int proc_get_sta_mem(struct seq_file *m, void *v);
 
 #ifdef DBG_MEMORY_LEAK
 int proc_get_malloc_cnt(struct seq_file *m, void *v);
@@ -448,6 +469,8 @@ int proc_get_tx_amsdu(struct seq_file *m, void *v);
 ssize_t proc_set_tx_amsdu(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 int proc_get_tx_amsdu_rate(struct seq_file *m, void *v);
 ssize_t proc_set_tx_amsdu_rate(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
+int proc_get_tx_amsdu_adapt(struct seq_file *m, void *v);
+ssize_t proc_set_tx_amsdu_adapt(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data);
 #endif
 #endif /* CONFIG_80211N_HT */
 
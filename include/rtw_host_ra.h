@@ -0,0 +1,80 @@
+/******************************************************************************
+ *
+ * Copyright(c) 2007 - 2017 Realtek Corporation.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ *****************************************************************************/
+#ifndef __RTW_HOST_RA_H_
+#define __RTW_HOST_RA_H_
+
+#ifdef CONFIG_RTW_HOST_RA
+
+#ifndef CONFIG_TX_CMPL_TRACK
+#error "CONFIG_RTW_HOST_RA depends on CONFIG_TX_CMPL_TRACK"
+#endif
+
+#define HOST_RA_RATE_NUM	(DESC_RATEMCS15 + 1)	/* CCK, OFDM, HT MCS0~15 */
+#define HOST_RA_RATE_NONE	0xFF
+
+#define HOST_RA_UPDATE_MS	100	/* statistics window */
+#define HOST_RA_EWMA_LEVEL	75	/* weight in % of history when merging a window */
+#define HOST_RA_PROB_MAX	1000	/* unit of success probability */
+#define HOST_RA_PROB_MIN	(HOST_RA_PROB_MAX / 10)	/* below this, expected throughput is 0 */
+#define HOST_RA_PROB_GOOD	(HOST_RA_PROB_MAX * 95 / 100)	/* no need to sample rates above this */
+
+#define HOST_RA_SAMPLE_INTVL_DEF	16	/* sample 1 of every N frames */
+#define HOST_RA_RPT_INTVL_DEF		2	/* request TX report for 1 of every N non-sample frames */
+
+/* pkt_attrib.hra_flags */
+#define HOST_RA_F_SAMPLE	BIT0	/* frame probes a rate out of the current choice */
+#define HOST_RA_F_RPT		BIT1	/* TX report is requested for the frame */
+
+struct host_ra_rate {
+	u32 att;		/* attempts in current window */
+	u32 succ;		/* successes in current window */
+	u32 att_total;
+	u32 succ_total;
+	u32 sample_cnt;		/* frames sent as sample at this rate */
+	u16 prob;		/* EWMA success probability, in 1/HOST_RA_PROB_MAX */
+	u16 tp;			/* expected throughput, in 100Kbps */
+};
+
+/* Minstrel like rate control state of a station, protected by xmitpriv.tx_cmpl_lock */
+struct host_ra_sta {
+	u64 ramask;		/* rate mask the state is built for */
+	u8 bw;			/* CHANNEL_WIDTH_XXX the state is built for */
+	u8 sgi;
+
+	u8 max_tp;		/* rate of normal frames */
+	u8 max_tp2;		/* second best throughput */
+	u8 max_prob;		/* most reliable rate */
+	u8 sample_idx;		/* next candidate of sampling, rotates over rates */
+
+	u16 sample_cnt;		/* frames since last sample */
+	u16 rpt_cnt;		/* non-sample frames since last reported one */
+	systime update_time;
+
+	u32 tx_cnt;		/* frames rate decided by host */
+	u32 sample_tx_cnt;
+	u32 rpt_total;		/* TX reports consumed */
+	u32 update_total;	/* statistics windows merged */
+
+	struct host_ra_rate rate[HOST_RA_RATE_NUM];
+};
+
+bool rtw_host_ra_select(_adapter *padapter, struct xmit_frame *pxmitframe);
+void rtw_host_ra_report(struct sta_info *psta, u8 tx_rate, u8 flags, bool ok, u8 retry_cnt, u8 final_rate);
+void rtw_host_ra_reset(struct sta_info *psta);
+void dump_host_ra(void *sel, struct sta_info *psta);
+
+#endif /* CONFIG_RTW_HOST_RA */
+
+#endif /* __RTW_HOST_RA_H_ */
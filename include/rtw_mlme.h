@@ -19,6 +19,7 @@
 
 
 #define	MAX_BSS_CNT	128
+#define SCANNED_HASH_NUM 64 /* power of 2, buckets of scanned_queue by BSSID */
 /* #define   MAX_JOIN_TIMEOUT	2000 */
 /* #define   MAX_JOIN_TIMEOUT	2500 */
 #define   MAX_JOIN_TIMEOUT	6500
@@ -750,6 +751,27 @@ struct roam_nb_info {
 #endif	/* defined(CONFIG_RTW_WNM) || defined(CONFIG_RTW_80211K) */
 #endif
 
+/* last BSS connected as STA, kept over disconnect and suspend for fast reconnect */
+struct rtw_last_bss {
+	NDIS_802_11_SSID ssid;
+	u8 bssid[ETH_ALEN];
+	u8 ch;
+	systime time; /* last time known to be connected */
+	u8 valid;
+};
+
+#define RTW_FAST_RECONN_EXP_MS (10 * 60 * 1000)
+#define RTW_FAST_RECONN_SURVEY_TIMES 2 /* times to survey the channel of last BSS */
+
+enum fast_reconn_state {
+	FAST_RECONN_NONE = 0,
+	FAST_RECONN_SURVEY, /* single channel survey issued */
+	FAST_RECONN_JOIN, /* joining with the result of single channel survey */
+	FAST_RECONN_FALLBACK, /* fell back to full survey */
+};
+
+#define JOIN_LAT_HIST_NUM 16 /* log2 buckets of time-to-associate in ms */
+
 struct mlme_priv {
 
 	_lock	lock;
@@ -774,6 +796,9 @@ struct mlme_priv {
 	_list		*pscanned;
 	_queue	free_bss_pool;
 	_queue	scanned_queue;
+	/* index of scanned_queue, protected by scanned_queue.lock */
+	_list	scanned_hash[SCANNED_HASH_NUM]; /* by BSSID */
+	_list	scanned_lru; /* least recently scanned first */
 	u8		*free_bss_buf;
 	u32	num_of_scanned;
 
@@ -783,8 +808,26 @@ struct mlme_priv {
 	struct wlan_network	cur_network;
 	struct wlan_network *cur_network_scanned;
 
+	struct rtw_last_bss last_bss;
+	u32 fast_reconn_exp_ms; /* max age of last_bss for fast reconnect, 0: disable */
+	u8 fast_reconn_state; /* enum fast_reconn_state of the ongoing join */
+	u32 fast_reconn_cnt;
+	u32 fast_reconn_hit;
+	u32 fast_reconn_fallback;
+
+	/* time-to-associate, from rtw_do_join() to rtw_indicate_connect() */
+	u8 join_timing;
+	systime join_start_time;
+	u32 join_lat_last_ms;
+	u32 join_lat_hist[2][JOIN_LAT_HIST_NUM]; /* [1]: connected by fast reconnect */
+
 	/* bcn check info */
 	struct beacon_keys cur_beacon_keys; /* save current beacon keys */
+	/* rtw_bcn_ie_crc() of the last beacon processed with keys adopted, beacons of the same CRC skip processing */
+	u32 cur_bcn_crc;
+	u8 cur_bcn_crc_valid;
+	u32 bcn_crc_skip_cnt;
+	u32 bcn_crc_proc_cnt;
 #ifdef CONFIG_BCN_CNT_CONFIRM_HDL
 	struct beacon_keys new_beacon_keys; /* save new beacon keys */
 	u8 new_beacon_cnts; /* if new_beacon_cnts >= threshold, ap beacon is changed */
@@ -1193,6 +1236,10 @@ extern void rtw_generate_random_ibss(u8 *pibss);
 struct wlan_network *_rtw_find_network(_queue *scanned_queue, const u8 *addr);
 struct wlan_network *rtw_find_network(_queue *scanned_queue, const u8 *addr);
 extern struct wlan_network *rtw_get_oldest_wlan_network(_queue *scanned_queue);
+void rtw_scanned_network_link(struct mlme_priv *pmlmepriv, struct wlan_network *pnetwork);
+void rtw_scanned_network_unlink(struct wlan_network *pnetwork);
+void rtw_scanned_network_touch(struct mlme_priv *pmlmepriv, struct wlan_network *pnetwork);
+void rtw_scanned_network_rehash(struct mlme_priv *pmlmepriv, struct wlan_network *pnetwork);
 struct wlan_network *_rtw_find_same_network(_queue *scanned_queue, struct wlan_network *network);
 struct wlan_network *rtw_find_same_network(_queue *scanned_queue, struct wlan_network *network);
 
@@ -1310,6 +1357,11 @@ void rtw_append_exented_cap(_adapter *padapter, u8 *out_ie, uint *pout_len);
 int rtw_is_same_ibss(_adapter *adapter, struct wlan_network *pnetwork);
 int is_same_network(WLAN_BSSID_EX *src, WLAN_BSSID_EX *dst, u8 feature);
 
+void rtw_join_timing_start(_adapter *adapter);
+u8 rtw_fast_reconn_survey_parm(_adapter *adapter, struct sitesurvey_parm *parm);
+u8 rtw_fast_reconn_fallback(_adapter *adapter);
+void dump_fast_reconn(void *sel, _adapter *adapter);
+
 #ifdef CONFIG_LAYER2_ROAMING
 #define rtw_roam_flags(adapter) ((adapter)->mlmepriv.roam_flags)
 #define rtw_chk_roam_flags(adapter, flags) ((adapter)->mlmepriv.roam_flags & flags)
@@ -22,6 +22,11 @@
  *	So, this driver tried to extend the dwell time for each scanning channel.
  *	This will increase the chance to receive the probe response from SoftAP. */
 #define SURVEY_TO		(100)
+/* bounds of scan dwell time adapted by channel history */
+#define RTW_SCAN_DWELL_MIN_MS	40
+#define RTW_SCAN_DWELL_MAX_MS	200
+#define RTW_SCAN_DWELL_IDLE(ms)	rtw_max((ms) / 2, RTW_SCAN_DWELL_MIN_MS)
+#define RTW_SCAN_DWELL_BUSY(ms)	rtw_max((ms), rtw_min((ms) * 3 / 2, RTW_SCAN_DWELL_MAX_MS))
 
 #define REAUTH_TO		(300) /* (50) */
 #define REASSOC_TO		(300) /* (50) */
@@ -191,6 +196,20 @@ enum ss_backop_flag {
 	SS_BACKOP_TX_RESUME = BIT5,
 };
 
+/* traffic level of background scan, decides off-channel slice and budget */
+enum ss_bg_tl {
+	SS_BG_TL_IDLE = 0,
+	SS_BG_TL_LIGHT = 1, /* latency sensitive low rate traffic, e.g. voice */
+	SS_BG_TL_BUSY = 2,
+	SS_BG_TL_NUM,
+};
+
+/* TX+RX unicast packets in traffic_status_watchdog() period for SS_BG_TL_LIGHT */
+#define RTW_BG_SCAN_PKT_LIGHT	20
+/* TX+RX throughput in Mbps for SS_BG_TL_BUSY */
+#define RTW_BG_SCAN_TP_BUSY	10
+#define RTW_BG_SCAN_BUDGET_WIN_MS	1000
+
 struct ss_res {
 	u8 state;
 	u8 next_state; /* will set to state on next cmd hdl */
@@ -219,6 +238,18 @@ struct ss_res {
 	u8 scan_cnt_max;
 	systime backop_time; /* the start time of backop */
 	u16 backop_ms;
+
+	u8 slice_ch_num; /* per scan runtime scan_cnt_max */
+	u16 slice_backop_ms; /* per scan runtime backop_ms */
+
+	u8 bg_scan; /* background scan, bounded by off-channel budget */
+	u8 bg_tl; /* enum ss_bg_tl */
+	u16 offch_budget_ms; /* max off-channel time in every RTW_BG_SCAN_BUDGET_WIN_MS */
+	u16 offch_win_ms; /* off-channel time in current window */
+	systime offch_win_time; /* start time of current window */
+	systime offch_time; /* start time of current off-channel slice */
+	u32 bg_slice_cnt;
+	u32 bg_defer_cnt; /* backop extended by off-channel budget */
 #endif
 #if defined(CONFIG_ANTENNA_DIVERSITY) || defined(DBG_SCAN_SW_ANTDIV_BL)
 	u8 is_sw_antdiv_bl_scan;
@@ -382,6 +413,12 @@ typedef struct _RT_CHANNEL_INFO {
 	#endif
 	u8 hidden_bss_cnt; /* per scan count */
 #endif
+	/* scan history, for channel order and dwell time of later scans */
+	u8 scan_visited; /* per scan flag */
+	u8 scan_bss_cnt; /* per scan count */
+	u8 scan_bss_avg; /* moving average of scan_bss_cnt, in 1/8 */
+	u8 scan_load; /* moving average of CLM + NHM ratio in percent */
+	u8 scan_hist_num; /* number of scans averaged */
 } RT_CHANNEL_INFO, *PRT_CHANNEL_INFO;
 
 #define CAC_TIME_MS (60*1000)
@@ -433,6 +470,7 @@ void dump_chset(void *sel, RT_CHANNEL_INFO *ch_set);
 void dump_cur_chset(void *sel, struct rf_ctl_t *rfctl);
 
 int rtw_chset_search_ch(RT_CHANNEL_INFO *ch_set, const u32 ch);
+void rtw_scan_hist_bss_found(_adapter *adapter, u8 ch);
 u8 rtw_chset_is_chbw_valid(RT_CHANNEL_INFO *ch_set, u8 ch, u8 bw, u8 offset);
 void rtw_chset_sync_chbw(RT_CHANNEL_INFO *ch_set, u8 *req_ch, u8 *req_bw, u8 *req_offset
 	, u8 *g_ch, u8 *g_bw, u8 *g_offset);
@@ -550,6 +588,8 @@ struct mlme_ext_priv {
 	/* #ifdef CONFIG_ACTIVE_KEEP_ALIVE_CHECK */
 	u8 active_keep_alive_check;
 	/* #endif */
+	u8 ka_null_pending; /* keep alive null data waiting for ack */
+	u8 ka_null_acked; /* keep alive null data acked, consumed by linked_status_chk() */
 #ifdef DBG_FIXED_CHAN
 	u8 fixed_chan;
 #endif
@@ -664,7 +704,7 @@ void sitesurvey_set_offch_state(_adapter *adapter, u8 scan_state);
 #define mlmeext_assign_scan_backop_flags_mesh(mlmeext, flags) do {} while (0)
 #endif /* defined(CONFIG_SCAN_BACKOP) && defined(CONFIG_RTW_MESH) */
 
-u32 rtw_scan_timeout_decision(_adapter *padapter);
+u32 rtw_scan_timeout_decision(_adapter *padapter, struct sitesurvey_parm *pparm);
 
 void init_mlme_default_rate_set(_adapter *padapter);
 int init_mlme_ext_priv(_adapter *padapter);
@@ -773,6 +813,7 @@ int rtw_get_bcn_keys(ADAPTER *Adapter, u8 *pframe, u32 packet_len,
 int validate_beacon_len(u8 *pframe, uint len);
 void rtw_dump_bcn_keys(void *sel, struct beacon_keys *recv_beacon);
 int rtw_check_bcn_info(ADAPTER *Adapter, u8 *pframe, u32 packet_len);
+u32 rtw_bcn_ie_crc(u8 *pframe, u32 packet_len);
 void update_beacon_info(_adapter *padapter, u8 *pframe, uint len, struct sta_info *psta);
 #ifdef CONFIG_DFS
 void process_csa_ie(_adapter *padapter, u8 *ies, uint ies_len);
@@ -782,6 +823,7 @@ void update_wireless_mode(_adapter *padapter);
 void update_tx_basic_rate(_adapter *padapter, u8 modulation);
 void update_sta_basic_rate(struct sta_info *psta, u8 wireless_mode);
 int rtw_ies_get_supported_rate(u8 *ies, uint ies_len, u8 *rate_set, u8 *rate_num);
+int rtw_ie_idx_get_supported_rate(struct rtw_ie_idx *idx, u8 *rate_set, u8 *rate_num);
 
 /* for sta/adhoc mode */
 void update_sta_info(_adapter *padapter, struct sta_info *psta);
@@ -882,6 +924,11 @@ void dump_mgntframe(_adapter *padapter, struct xmit_frame *pmgntframe);
 s32 dump_mgntframe_and_wait(_adapter *padapter, struct xmit_frame *pmgntframe, int timeout_ms);
 s32 dump_mgntframe_and_wait_ack(_adapter *padapter, struct xmit_frame *pmgntframe);
 s32 dump_mgntframe_and_wait_ack_timeout(_adapter *padapter, struct xmit_frame *pmgntframe, int timeout_ms);
+s32 dump_mgntframe_and_ack_async(_adapter *padapter, struct xmit_frame *pmgntframe, int timeout_ms
+	, void (*done_cb)(void *priv, int status), void *cb_priv);
+
+/* ack result of mgnt frame issued by issue_xxx_async(), not in process context */
+typedef void (*mgnt_tx_async_cb)(_adapter *adapter, const u8 *ra, bool acked, void *priv);
 
 #ifdef CONFIG_P2P
 int get_reg_classes_full_count(struct p2p_channels *channel_list);
@@ -903,6 +950,11 @@ void issue_auth(_adapter *padapter, struct sta_info *psta, unsigned short status
 void issue_probereq(_adapter *padapter, const NDIS_802_11_SSID *pssid, const u8 *da);
 s32 issue_probereq_ex(_adapter *padapter, const NDIS_802_11_SSID *pssid, const u8 *da, u8 ch, bool append_wps, int try_cnt, int wait_ms);
 int issue_nulldata(_adapter *padapter, unsigned char *da, unsigned int power_mode, int try_cnt, int wait_ms);
+int issue_nulldata_async(_adapter *padapter, unsigned char *da, unsigned int power_mode, int try_cnt
+	, mgnt_tx_async_cb done_cb, void *priv);
+#ifdef CONFIG_XMIT_ACK
+int issue_nulldata_tx_rpt(_adapter *padapter, struct sta_info *psta);
+#endif
 int issue_qos_nulldata(_adapter *padapter, unsigned char *da, u16 tid, u8 ps, int try_cnt, int wait_ms);
 int issue_deauth(_adapter *padapter, unsigned char *da, unsigned short reason);
 int issue_deauth_ex(_adapter *padapter, u8 *da, unsigned short reason, int try_cnt, int wait_ms);
@@ -910,8 +962,12 @@ void issue_action_spct_ch_switch(_adapter *padapter, u8 *ra, u8 new_ch, u8 ch_of
 void issue_addba_req(_adapter *adapter, unsigned char *ra, u8 tid);
 void issue_addba_rsp(_adapter *adapter, unsigned char *ra, u8 tid, u16 status, u8 size);
 u8 issue_addba_rsp_wait_ack(_adapter *adapter, unsigned char *ra, u8 tid, u16 status, u8 size, int try_cnt, int wait_ms);
+int issue_addba_rsp_async(_adapter *adapter, unsigned char *ra, u8 tid, u16 status, u8 size
+	, int try_cnt, mgnt_tx_async_cb done_cb, void *priv);
 void issue_del_ba(_adapter *adapter, unsigned char *ra, u8 tid, u16 reason, u8 initiator);
 int issue_del_ba_ex(_adapter *adapter, unsigned char *ra, u8 tid, u16 reason, u8 initiator, int try_cnt, int wait_ms);
+int issue_del_ba_async(_adapter *adapter, unsigned char *ra, u8 tid, u16 reason, u8 initiator
+	, int try_cnt, mgnt_tx_async_cb done_cb, void *priv);
 void issue_action_BSSCoexistPacket(_adapter *padapter);
 
 #ifdef CONFIG_IEEE80211W
@@ -78,6 +78,7 @@ extern u8 rtw_rfc1042_header[];
 
 /* for Rx reordering buffer control */
 struct recv_reorder_ctrl {
+	_list list;	/* in sta_priv.free_reorder_ctrl_queue when detached from STA */
 	_adapter	*padapter;
 	u8 tid;
 	u8 enable;
@@ -611,6 +612,7 @@ struct recv_buf *rtw_dequeue_recvbuf(_queue *queue);
 
 #if defined(CONFIG_80211N_HT) && defined(CONFIG_RECV_REORDERING_CTRL)
 void rtw_reordering_ctrl_timeout_handler(void *pcontext);
+void rtw_reorder_ctrl_indicate_all(struct recv_reorder_ctrl *preorder_ctrl);
 #endif
 
 void rx_query_phy_status(union recv_frame *rframe, u8 *phy_stat);
@@ -188,6 +188,8 @@ void rtw_txpwr_lmt_add_with_nlen(struct rf_ctl_t *rfctl, const char *regd_name,
 	, u8 band, u8 bw, u8 tlrs, u8 ntx_idx, u8 ch_idx, s8 lmt);
 void rtw_txpwr_lmt_add(struct rf_ctl_t *rfctl, const char *regd_name
 	, u8 band, u8 bw, u8 tlrs, u8 ntx_idx, u8 ch_idx, s8 lmt);
+void rtw_txpwr_lmt_ent_add_with_nlen(struct rf_ctl_t *rfctl, const char *regd_name, u32 nlen
+	, const s8 *lmt_2g, const s8 *lmt_5g);
 struct txpwr_lmt_ent *_rtw_txpwr_lmt_get_by_name(struct rf_ctl_t *rfctl, const char *regd_name);
 struct txpwr_lmt_ent *rtw_txpwr_lmt_get_by_name(struct rf_ctl_t *rfctl, const char *regd_name);
 void rtw_txpwr_lmt_list_free(struct rf_ctl_t *rfctl);
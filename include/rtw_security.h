@@ -460,6 +460,8 @@ void rtw_secmicappendbyte(struct mic_data *pmicdata, u8 b);
 void rtw_secmicappend(struct mic_data *pmicdata, u8 *src, u32 nBytes);
 void rtw_secgetmic(struct mic_data *pmicdata, u8 *dst);
 
+u32 rtw_crc32_update(u32 crc, const u8 *buf, sint len);
+
 void rtw_seccalctkipmic(
 	u8 *key,
 	u8 *header,
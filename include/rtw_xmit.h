@@ -448,6 +448,14 @@ struct pkt_attrib {
 	u8	ampdu_spacing; /* ampdu_min_spacing for peer sta's rx */
 	u8	amsdu;
 	u8	amsdu_ampdu_en;/* tx amsdu in ampdu enable */
+#ifdef CONFIG_TX_CMPL_TRACK
+	u64	enq_us; /* set at rtw_xmit() when sampled for TX completion tracking, 0: not sampled */
+	u8	aka_probe; /* AP active keep alive null data, its TX report is matched by the tracker */
+#endif
+#ifdef CONFIG_RTW_HOST_RA
+	u8	hra_rate; /* DESC_RATEXXX chosen by host RA at TX desc filling, HOST_RA_RATE_NONE: not chosen */
+	u8	hra_flags; /* HOST_RA_F_XXX */
+#endif
 	u8	mdata;/* more data bit */
 	u8	pctrl;/* per packet txdesc control enable */
 	u8	triggered;/* for ap mode handling Power Saving sta */
@@ -508,6 +516,30 @@ enum {
 	RTW_AMSDU_TIMER_SETTING,
 	RTW_AMSDU_TIMER_TIMEOUT,
 };
+
+#define RTW_AMSDU_ADAPT_MAX_NUM		8	/* upper bound of subframes per A-MSDU */
+#define RTW_AMSDU_ADAPT_DEF_NUM		4
+#define RTW_AMSDU_ADAPT_DEF_LAT_US	2000	/* latency budget for BE, VO:1/4 VI:1/2 BK:x2 */
+#define RTW_AMSDU_ADAPT_MAX_TIMEOUT_MS	10
+#define RTW_AMSDU_MAX_LEN_4K		3839	/* max A-MSDU length of HT */
+#define RTW_AMSDU_MAX_LEN_8K		7935	/* when peer sets IEEE80211_HT_CAP_MAX_AMSDU */
+
+/* why an A-MSDU (or a single MSDU) was released to HW */
+enum rtw_amsdu_flush_reason {
+	RTW_AMSDU_FLUSH_BURST = 0,	/* shallow queue, sent without waiting */
+	RTW_AMSDU_FLUSH_FULL,		/* reached the chosen subframe count */
+	RTW_AMSDU_FLUSH_TIMEOUT,	/* flush timer expired */
+	RTW_AMSDU_FLUSH_BUDGET,		/* airtime of next subframe exceeds latency budget */
+	RTW_AMSDU_FLUSH_NUM,
+};
+
+/* per station, per AC adaptive A-MSDU controller state */
+struct rtw_amsdu_ctl {
+	u16 qlen_avg;		/* EWMA of pending frames, fixed point << 3 */
+	u8 num;			/* subframe count chosen for the next A-MSDU */
+	u8 timeout_ms;		/* flush timeout chosen for the next A-MSDU, 0: no wait */
+	u8 reason;		/* enum rtw_amsdu_flush_reason of the last decision */
+};
 #endif
 
 #define WLANHDR_OFFSET	64
@@ -540,6 +572,8 @@ struct  submit_ctx {
 #ifdef PLATFORM_LINUX
 	struct completion done;
 #endif
+	void (*done_cb)(void *priv, int status); /* asynchronous waiter, called instead of completion */
+	void *cb_priv;
 };
 
 enum {
@@ -562,6 +596,7 @@ enum {
 
 
 void rtw_sctx_init(struct submit_ctx *sctx, int timeout_ms);
+void rtw_sctx_init_async(struct submit_ctx *sctx, int timeout_ms, void (*done_cb)(void *priv, int status), void *cb_priv);
 int rtw_sctx_wait(struct submit_ctx *sctx, const char *msg);
 void rtw_sctx_done_err(struct submit_ctx **sctx, int status);
 void rtw_sctx_done(struct submit_ctx **sctx);
@@ -659,6 +694,7 @@ struct xmit_frame {
 
 	u8 *alloc_addr; /* the actual address this xmitframe allocated */
 	u8 ext_tag; /* 0:data, 1:mgmt */
+	u8 ac_qidx; /* AC quota charged by this xmitframe, XX_QUEUE_INX, 0xFF: none */
 
 };
 
@@ -685,6 +721,10 @@ struct sta_xmit_priv {
 
 	u16 txseq_tid[16];
 
+#ifdef CONFIG_TX_AMSDU
+	struct rtw_amsdu_ctl amsdu_ctl[4]; /* index by XX_QUEUE_INX */
+#endif
+
 	/* uint	sta_tx_bytes; */
 	/* u64	sta_tx_pkts; */
 	/* uint	sta_tx_fail; */
@@ -738,6 +778,12 @@ struct	xmit_priv	{
 	uint free_xmitframe_cnt;
 	_queue	free_xmit_queue;
 
+	/* per AC share of free_xmit_queue, index by XX_QUEUE_INX, protected by free_xmit_queue.lock */
+	u16 xmitframe_ac_rsvd[4]; /* xmitframes kept for this AC only */
+	u16 xmitframe_ac_quota[4]; /* max xmitframes this AC can hold, 0: no limit */
+	u16 xmitframe_ac_cnt[4]; /* xmitframes held by this AC */
+	u32 tx_ac_drop[4];
+
 	/* uint mapping_addr; */
 	/* uint pkt_sz; */
 
@@ -812,6 +858,7 @@ struct	xmit_priv	{
 	u8 *pallocated_xmitbuf;
 	u8 *pxmitbuf;
 	uint free_xmitbuf_cnt;
+	u8 xmitbuf_rsvd; /* xmitbufs kept for VO/VI when BE/BK frames are dequeued */
 
 	_queue free_xmit_extbuf_queue;
 	u8 *pallocated_xmit_extbuf;
@@ -837,6 +884,22 @@ struct	xmit_priv	{
 	_mutex ack_tx_mutex;
 	struct submit_ctx ack_tx_ops;
 	u8 seq_no;
+	u8 ack_tx_async; /* ack_tx_ops is owned by asynchronous waiter */
+	_timer ack_tx_timer; /* timeout of asynchronous waiter */
+#ifdef PLATFORM_LINUX
+	_completion ack_tx_free; /* ack_tx released, wakes rtw_ack_tx_claim() */
+#endif
+#endif
+
+#ifdef CONFIG_TX_CMPL_TRACK
+	_lock tx_cmpl_lock;
+	u16 tx_cmpl_sample; /* track 1 of every N data frames, 0: disable */
+	u16 tx_cmpl_cnt;
+#endif
+#ifdef CONFIG_RTW_HOST_RA
+	u8 host_ra_en;
+	u16 host_ra_sample_intvl; /* probe another rate with 1 of every N frames, 0: disable */
+	u16 host_ra_rpt_intvl; /* request TX report for 1 of every N non-sample frames */
 #endif
 
 #ifdef CONFIG_TX_AMSDU
@@ -857,6 +920,9 @@ struct	xmit_priv	{
 	u32 amsdu_debug_coalesce_one;
 	u32 amsdu_debug_coalesce_two;
 
+	u32 amsdu_adapt_num_cnt[4][RTW_AMSDU_ADAPT_MAX_NUM + 1];
+	u32 amsdu_adapt_flush_cnt[4][RTW_AMSDU_FLUSH_NUM];
+
 #endif
 #ifdef DBG_TXBD_DESC_DUMP
 	BOOLEAN	 dump_txbd_desc;
@@ -925,6 +991,9 @@ extern s32 rtw_make_wlanhdr(_adapter *padapter, u8 *hdr, struct pkt_attrib *patt
 extern s32 rtw_put_snap(u8 *data, u16 h_proto);
 
 extern struct xmit_frame *rtw_alloc_xmitframe(struct xmit_priv *pxmitpriv);
+extern struct xmit_frame *rtw_alloc_xmitframe_ac(struct xmit_priv *pxmitpriv, u8 qidx);
+u16 rtw_xmitframe_ac_avail(struct xmit_priv *pxmitpriv, u8 qidx);
+bool rtw_xmitbuf_rsvd_blocked(struct xmit_priv *pxmitpriv);
 struct xmit_frame *rtw_alloc_xmitframe_ext(struct xmit_priv *pxmitpriv);
 struct xmit_frame *rtw_alloc_xmitframe_once(struct xmit_priv *pxmitpriv);
 extern s32 rtw_free_xmitframe(struct xmit_priv *pxmitpriv, struct xmit_frame *pxmitframe);
@@ -964,6 +1033,22 @@ s32 rtw_monitor_xmit_entry(struct sk_buff *skb, struct net_device *ndev);
 s32 rtw_xmit_posthandle(_adapter *padapter, struct xmit_frame *pxmitframe, _pkt *pkt);
 s32 rtw_xmit(_adapter *padapter, _pkt **pkt);
 bool xmitframe_hiq_filter(struct xmit_frame *xmitframe);
+/* sleep_q length accounting of frame moved in/out of psta->sleep_q */
+#define rtw_sleepq_frame_in(psta, pxframe) \
+	do { \
+		(psta)->sleepq_len++; \
+		(psta)->sleepq_bytes += (pxframe)->attrib.pktlen; \
+	} while (0)
+
+#define rtw_sleepq_frame_out(psta, pxframe) \
+	do { \
+		(psta)->sleepq_len--; \
+		if ((psta)->sleepq_len == 0 || (psta)->sleepq_bytes < (pxframe)->attrib.pktlen) \
+			(psta)->sleepq_bytes = 0; \
+		else \
+			(psta)->sleepq_bytes -= (pxframe)->attrib.pktlen; \
+	} while (0)
+
 #if defined(CONFIG_AP_MODE) || defined(CONFIG_TDLS)
 sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *pxmitframe);
 void stop_sta_xmit(_adapter *padapter, struct sta_info *psta);
@@ -994,6 +1079,13 @@ sint	check_pending_xmitbuf(struct xmit_priv *pxmitpriv);
 thread_return	rtw_xmit_thread(thread_context context);
 #endif
 
+#ifdef CONFIG_TX_CMPL_TRACK
+void rtw_tx_cmpl_sample(_adapter *padapter, struct xmit_frame *pxmitframe);
+bool rtw_tx_cmpl_track_push(_adapter *padapter, struct xmit_frame *pxmitframe);
+s32 rtw_tx_cmpl_track_report(_adapter *padapter, u8 mac_id, bool ok, u8 retry_cnt, u8 final_rate);
+void rtw_tx_cmpl_track_reset(struct sta_info *psta);
+#endif
+
 #ifdef CONFIG_TX_AMSDU
 extern void rtw_amsdu_vo_timeout_handler(void *FunctionContext);
 extern void rtw_amsdu_vi_timeout_handler(void *FunctionContext);
@@ -1002,12 +1094,20 @@ extern void rtw_amsdu_bk_timeout_handler(void *FunctionContext);
 
 extern u8 rtw_amsdu_get_timer_status(_adapter *padapter, u8 priority);
 extern void rtw_amsdu_set_timer_status(_adapter *padapter, u8 priority, u8 status);
-extern void rtw_amsdu_set_timer(_adapter *padapter, u8 priority);
+extern void rtw_amsdu_set_timer(_adapter *padapter, u8 priority, u8 timeout_ms);
 extern void rtw_amsdu_cancel_timer(_adapter *padapter, u8 priority);
 
-extern s32 rtw_xmitframe_coalesce_amsdu(_adapter *padapter, struct xmit_frame *pxmitframe, struct xmit_frame *pxmitframe_queue);	
+extern s32 rtw_xmitframe_coalesce_amsdu(_adapter *padapter, struct xmit_frame *pxmitframe, struct xmit_frame **subframes, u8 sub_num);
 extern s32 check_amsdu(struct xmit_frame *pxmitframe);
 extern s32 check_amsdu_tx_support(_adapter *padapter);
+extern u8 rtw_amsdu_prio_to_qidx(u8 priority);
+extern u8 rtw_amsdu_adapt_decide(_adapter *padapter, struct sta_info *psta, u8 priority, u16 qlen, u16 pkt_len);
+extern void rtw_amsdu_adapt_flush(_adapter *padapter, u8 priority, u8 num, u8 reason);
+extern void rtw_amsdu_adapt_stats_reset(_adapter *padapter);
+extern u8 rtw_amsdu_xmit_check(_adapter *padapter);
+extern s32 rtw_amsdu_coalesce_xframe(_adapter *padapter, struct xmit_frame *pxmitframe, u8 num);
+extern const char *const _amsdu_flush_reason_str[];
+#define amsdu_flush_reason_str(reason) (((reason) >= RTW_AMSDU_FLUSH_NUM) ? _amsdu_flush_reason_str[RTW_AMSDU_FLUSH_NUM] : _amsdu_flush_reason_str[(reason)])
 extern struct xmit_frame *rtw_get_xframe(struct xmit_priv *pxmitpriv, int *num_frame);
 #endif
 
@@ -1022,6 +1122,12 @@ u32	rtw_get_ff_hwaddr(struct xmit_frame	*pxmitframe);
 #ifdef CONFIG_XMIT_ACK
 int rtw_ack_tx_wait(struct xmit_priv *pxmitpriv, u32 timeout_ms);
 void rtw_ack_tx_done(struct xmit_priv *pxmitpriv, int status);
+void rtw_ack_tx_timeout_hdl(void *ctx);
+int rtw_ack_tx_claim(struct xmit_priv *pxmitpriv, u32 timeout_ms);
+int rtw_ack_tx_claim_async(struct xmit_priv *pxmitpriv, u32 timeout_ms
+	, void (*done_cb)(void *priv, int status), void *cb_priv);
+void rtw_ack_tx_cancel(struct xmit_priv *pxmitpriv);
+void rtw_ack_tx_release(struct xmit_priv *pxmitpriv);
 #endif /* CONFIG_XMIT_ACK */
 
 enum XMIT_BLOCK_REASON {
@@ -29,6 +29,17 @@
 #endif
 
 #define NUM_ACL 16
+#if (NUM_ACL > 32)
+	#error "NUM_ACL > 32 is not supported by wlan_acl_pool.used_map"
+#endif
+#define RTW_ACL_HASH_NUM 16 /* power of 2 */
+
+#define STA_EXPIRE_TICK_MS 2000 /* period of expire_timeout_chk(), unit of expire_to */
+#define STA_EXPIRE_WHEEL_SIZE 64 /* power of 2 */
+
+#define AKA_PROBE_NONE		0
+#define AKA_PROBE_PENDING	1 /* waiting for TX report */
+#define AKA_PROBE_FAIL		2
 
 #define RTW_ACL_PERIOD_DEV 0
 #define RTW_ACL_PERIOD_BSS 1
@@ -49,8 +60,13 @@ extern const char *const _acl_mode_str[RTW_ACL_MODE_MAX];
 #ifndef RTW_PRE_LINK_STA_NUM
 	#define RTW_PRE_LINK_STA_NUM 8
 #endif
+#if (RTW_PRE_LINK_STA_NUM > 32)
+	#error "RTW_PRE_LINK_STA_NUM > 32 is not supported by pre_link_sta_ctl_t.used_map"
+#endif
+#define RTW_PRE_LINK_STA_HASH_NUM 8 /* power of 2 */
 
 struct pre_link_sta_node_t {
+	_list hash_list;
 	u8 valid;
 	u8 addr[ETH_ALEN];
 };
@@ -58,6 +74,8 @@ struct pre_link_sta_node_t {
 struct pre_link_sta_ctl_t {
 	_lock lock;
 	u8 num;
+	u32 used_map; /* BIT(i) for valid node[i] */
+	_list hash[RTW_PRE_LINK_STA_HASH_NUM];
 	struct pre_link_sta_node_t node[RTW_PRE_LINK_STA_NUM];
 };
 
@@ -84,6 +102,7 @@ enum sta_info_update_type {
 
 struct rtw_wlan_acl_node {
 	_list		        list;
+	_list	hash_list;
 	u8       addr[ETH_ALEN];
 	u8       valid;
 };
@@ -91,6 +110,8 @@ struct rtw_wlan_acl_node {
 struct wlan_acl_pool {
 	int mode;
 	int num;
+	u32 used_map; /* BIT(i) for valid aclnode[i] */
+	_list hash[RTW_ACL_HASH_NUM];
 	struct rtw_wlan_acl_node aclnode[NUM_ACL];
 	_queue	acl_node_q;
 };
@@ -164,6 +185,39 @@ struct	stainfo_stats	{
 #endif
 };
 
+#ifdef CONFIG_TX_CMPL_TRACK
+#define TX_CMPL_FIFO_SZ		32	/* outstanding tracked frames per station, power of 2 */
+#define TX_CMPL_LAT_HIST_NUM	18	/* log2 buckets of enqueue-to-report latency in us */
+#define TX_CMPL_RETRY_HIST_NUM	8	/* retry count 0~6, last one counts 7 and more */
+#define TX_CMPL_RATE_NUM	(DESC_RATEVHTSS4MCS9 + 1)
+#define TX_CMPL_RPT_TO_MS	1000	/* outstanding frame older than this lost its report */
+
+/* tx_cmpl_track.flags */
+#define TX_CMPL_F_AKA		BIT0	/* AP active keep alive null data, report goes to rtw_ap_aka_probe_report() */
+
+/* TX completion of sampled data frames, matched in order to TX reports of the macid */
+struct tx_cmpl_track {
+	u64 enq_us[TX_CMPL_FIFO_SZ];	/* rtw_xmit() time of outstanding frames */
+	u8 flags[TX_CMPL_FIFO_SZ];	/* TX_CMPL_F_XXX of outstanding frames */
+	systime push_time[TX_CMPL_FIFO_SZ];	/* TX desc filling time of outstanding frames */
+	u8 head;
+	u8 tail;
+
+	u32 ok;
+	u32 fail;
+	u32 overflow;			/* sampled but not tracked because FIFO was full */
+	u32 lost;			/* dropped from FIFO because the report never came */
+	u32 lat_max_us;
+	u32 lat_hist[TX_CMPL_LAT_HIST_NUM];
+	u32 retry_hist[TX_CMPL_RETRY_HIST_NUM];
+	u32 rate_cnt[TX_CMPL_RATE_NUM];	/* final TX rate, index by DESC_RATEXXX */
+#ifdef CONFIG_RTW_HOST_RA
+	u8 hra_rate[TX_CMPL_FIFO_SZ];	/* host RA rate of outstanding frames, HOST_RA_RATE_NONE: not by host RA */
+	u8 hra_flags[TX_CMPL_FIFO_SZ];
+#endif
+};
+#endif
+
 #ifndef DBG_SESSION_TRACKER
 #define DBG_SESSION_TRACKER 0
 #endif
@@ -258,6 +312,31 @@ struct rtw_atlm_param {
 };
 #endif
 
+/* rarely used STA info, allocated on demand by rtw_sta_cold_get() */
+struct sta_cold_info {
+	unsigned char chg_txt[128]; /* shared key authentication challenge text */
+
+#ifdef CONFIG_GTK_OL
+	/* GTK rekey offload data of the AP, only used for WoWLAN */
+	u8 kek[RTW_KEK_LEN];
+	u8 kck[RTW_KCK_LEN];
+	u8 replay_ctr[RTW_REPLAY_CTR_LEN];
+#endif /* CONFIG_GTK_OL */
+
+#ifdef CONFIG_P2P
+	/* p2p client info */
+	u8 dev_addr[ETH_ALEN];
+	/* u8 iface_addr[ETH_ALEN]; */ /* = hwaddr[ETH_ALEN] */
+	u8 dev_cap;
+	u16 config_methods;
+	u8 primary_dev_type[8];
+	u8 num_of_secdev_type;
+	u8 secdev_types_list[32];/* 32/8 == 4; */
+	u16 dev_name_len;
+	u8 dev_name[32];
+#endif /* CONFIG_P2P */
+};
+
 struct sta_info {
 
 	_lock	lock;
@@ -278,6 +357,8 @@ struct sta_info {
 #endif
 	_queue sleep_q;
 	unsigned int sleepq_len;
+	unsigned int sleepq_bytes; /* sum of attrib.pktlen of frames in sleep_q */
+	u32 sleepq_ovf_drop; /* frames dropped from sleep_q by sleepq_max_len/sleepq_max_bytes */
 
 	uint state;
 	uint qos_option;
@@ -309,11 +390,6 @@ struct sta_info {
 	union pn48 igtk_pn;
 	#endif /* CONFIG_IEEE80211W */
 #endif /* CONFIG_RTW_MESH */
-#ifdef CONFIG_GTK_OL
-	u8 kek[RTW_KEK_LEN];
-	u8 kck[RTW_KCK_LEN];
-	u8 replay_ctr[RTW_REPLAY_CTR_LEN];
-#endif /* CONFIG_GTK_OL */
 #ifdef CONFIG_IEEE80211W
 	_timer dot11w_expire_timer;
 #endif /* CONFIG_IEEE80211W */
@@ -328,6 +404,12 @@ struct sta_info {
 	u8	wireless_mode;	/* NETWORK_TYPE */
 
 	struct stainfo_stats sta_stats;
+#ifdef CONFIG_TX_CMPL_TRACK
+	struct tx_cmpl_track tx_cmpl;
+#endif
+#ifdef CONFIG_RTW_HOST_RA
+	struct host_ra_sta host_ra;
+#endif
 
 #ifdef CONFIG_TDLS
 	u32	tdls_sta_state;
@@ -355,8 +437,8 @@ struct sta_info {
 	/* for A-MPDU TX, ADDBA timeout check	 */
 	_timer addba_retry_timer;
 
-	/* for A-MPDU Rx reordering buffer control */
-	struct recv_reorder_ctrl recvreorder_ctrl[TID_NUM];
+	/* for A-MPDU Rx reordering buffer control, allocated when ADDBA is accepted */
+	struct recv_reorder_ctrl *recvreorder_ctrl[TID_NUM];
 	ATOMIC_T continual_no_rx_packet[TID_NUM];
 	/* for A-MPDU Tx */
 	/* unsigned char		ampdu_txen_bitmap; */
@@ -387,9 +469,14 @@ struct sta_info {
 	_list asoc_list;
 	_list auth_list;
 
+	_list expire_list; /* in sta_priv.expire_wheel when armed by rtw_sta_expire_arm() */
+	u32 expire_tick; /* deadline in expire_timeout_chk() ticks */
+	u8 aka_probe; /* AKA_PROBE_XXX, state of async active keep alive probe */
+
 	unsigned int auth_seq;
 	unsigned int authalg;
-	unsigned char chg_txt[128];
+
+	struct sta_cold_info *cold;
 
 	u16 capability;
 	int flags;
@@ -436,20 +523,9 @@ struct sta_info {
 	unsigned int sleepq_ac_len;
 
 #ifdef CONFIG_P2P
-	/* p2p priv data */
+	/* p2p priv data, p2p client info is in cold */
 	u8 is_p2p_device;
 	u8 p2p_status_code;
-
-	/* p2p client info */
-	u8 dev_addr[ETH_ALEN];
-	/* u8 iface_addr[ETH_ALEN]; */ /* = hwaddr[ETH_ALEN] */
-	u8 dev_cap;
-	u16 config_methods;
-	u8 primary_dev_type[8];
-	u8 num_of_secdev_type;
-	u8 secdev_types_list[32];/* 32/8 == 4; */
-	u16 dev_name_len;
-	u8 dev_name[32];
 #endif /* CONFIG_P2P */
 
 #ifdef CONFIG_WFD
@@ -631,6 +707,7 @@ struct sta_info {
 #endif
 
 #define AID_BMP_LEN(max_aid) ((max_aid + 1) / 8 + (((max_aid + 1) % 8) ? 1 : 0))
+#define AID_MAP_WORDS(max_aid) (((max_aid) + 31) / 32) /* bit (AID - 1) */
 
 struct	sta_priv {
 
@@ -644,6 +721,15 @@ struct	sta_priv {
 	_queue sleep_q;
 	_queue wakeup_q;
 
+	/* per STA limit of sleep_q, oldest frame is dropped when exceeded, 0: no limit */
+	u16 sleepq_max_len;
+	u32 sleepq_max_bytes;
+	u32 sleepq_ovf_drop;
+
+	_queue free_reorder_ctrl_queue; /* detached recv_reorder_ctrl kept for reuse */
+	ATOMIC_T reorder_ctrl_cnt; /* allocated recv_reorder_ctrl, attached or in free_reorder_ctrl_queue */
+	ATOMIC_T cold_cnt; /* allocated sta_info.cold */
+
 	_adapter *padapter;
 
 	u32 adhoc_expire_to;
@@ -660,6 +746,15 @@ struct	sta_priv {
 	unsigned int assoc_to; /* sec, time to expire before associating. */
 	unsigned int expire_to; /* sec , time to expire after associated. */
 
+	/* auth/asoc STAs hashed by deadline tick, only due STAs are checked by expire_timeout_chk() */
+	_list expire_wheel[STA_EXPIRE_WHEEL_SIZE];
+	_lock expire_wheel_lock;
+	u32 expire_tick;
+	u32 expire_due_cnt;
+	u32 aka_probe_cnt;
+	u32 aka_probe_ack_cnt;
+	u32 aka_probe_fail_cnt;
+
 	/*
 	* pointers to STA info; based on allocated AID or NULL if AID free
 	* AID is in the range 1-2007, so sta_aid[0] corresponders to AID 1
@@ -668,6 +763,9 @@ struct	sta_priv {
 	u16 max_aid;
 	u16 started_aid; /* started AID for allocation search */
 	bool rr_aid; /* round robin AID allocation, will modify started_aid */
+	_lock aid_lock;
+	u32 aid_map[AID_MAP_WORDS(MACID_NUM_SW_LIMIT)]; /* AIDs bound in sta_aid */
+	u16 aid_used_cnt;
 	u8 aid_bmp_len; /* in byte */
 	u8 *sta_dz_bitmap;
 	u8 *tim_bitmap;
@@ -710,6 +808,8 @@ __inline static u32 wifi_mac_hash(const u8 *mac)
 	return x;
 }
 
+#define acl_hash(addr) (wifi_mac_hash(addr) & (RTW_ACL_HASH_NUM - 1))
+
 
 extern u32	_rtw_init_sta_priv(struct sta_priv *pstapriv);
 extern u32	_rtw_free_sta_priv(struct sta_priv *pstapriv);
@@ -722,15 +822,27 @@ extern struct sta_info *rtw_alloc_stainfo(struct	sta_priv *pstapriv, const u8 *h
 extern u32	rtw_free_stainfo(_adapter *padapter , struct sta_info *psta);
 extern void rtw_free_all_stainfo(_adapter *padapter);
 extern struct sta_info *rtw_get_stainfo(struct sta_priv *pstapriv, const u8 *hwaddr);
+struct recv_reorder_ctrl *rtw_alloc_reorder_ctrl(struct sta_info *psta, u8 tid);
+void rtw_free_reorder_ctrl(struct sta_info *psta, u8 tid);
+struct sta_cold_info *rtw_sta_cold_get(struct sta_info *psta);
+void dump_sta_mem(void *sel, _adapter *adapter);
+#ifdef CONFIG_AP_MODE
+void rtw_sta_expire_arm(struct sta_priv *pstapriv, struct sta_info *psta, u32 ticks);
+u8 rtw_sta_expire_tick(struct sta_priv *pstapriv, char *list);
+#endif
 extern u32 rtw_init_bcmc_stainfo(_adapter *padapter);
 extern struct sta_info *rtw_get_bcmc_stainfo(_adapter *padapter);
 
 #ifdef CONFIG_AP_MODE
 u16 rtw_aid_alloc(_adapter *adapter, struct sta_info *sta);
+void rtw_aid_bind(struct sta_priv *stapriv, struct sta_info *sta, u16 aid);
+void rtw_aid_free(struct sta_priv *stapriv, struct sta_info *sta);
+void rtw_aid_free_all(struct sta_priv *stapriv);
 void dump_aid_status(void *sel, _adapter *adapter);
 #endif
 
 #if CONFIG_RTW_MACADDR_ACL
+struct rtw_wlan_acl_node *rtw_acl_node_find(struct wlan_acl_pool *acl, const u8 *addr);
 extern u8 rtw_access_ctrl(_adapter *adapter, const u8 *mac_addr);
 void dump_macaddr_acl(void *sel, _adapter *adapter);
 #endif
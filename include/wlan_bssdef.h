@@ -359,6 +359,8 @@ __inline  static uint get_WLAN_BSSID_EX_sz(WLAN_BSSID_EX *bss)
 
 struct	wlan_network {
 	_list	list;
+	_list	hash_list; /* mlme_priv.scanned_hash */
+	_list	lru_list; /* mlme_priv.scanned_lru */
 	int	network_type;	/* refer to ieee80211.h for WIRELESS_11A/B/G */
 	int	fixed;			/* set to fixed when not to be removed as site-surveying */
 	systime last_scanned; /* timestamp for the network */
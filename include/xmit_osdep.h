@@ -53,6 +53,7 @@ extern uint _rtw_pktfile_read(struct pkt_file *pfile, u8 *rmem, uint rlen);
 extern sint rtw_endofpktfile(struct pkt_file *pfile);
 
 extern void rtw_os_pkt_complete(_adapter *padapter, _pkt *pkt);
+u8 rtw_os_pkt_qidx(_pkt *pkt);
 extern void rtw_os_xmit_complete(_adapter *padapter, struct xmit_frame *pxframe);
 
 void rtw_os_wake_queue_at_free_stainfo(_adapter *padapter, int *qcnt_freed);
@@ -1942,6 +1942,7 @@ static int cfg80211_rtw_set_rekey_data(struct wiphy *wiphy,
 {
 	/*int i;*/
 	struct sta_info *psta;
+	struct sta_cold_info *cold;
 	_adapter *padapter = (_adapter *)rtw_netdev_priv(ndev);
 	struct mlme_priv   *pmlmepriv = &padapter->mlmepriv;
 	struct sta_priv *pstapriv = &padapter->stapriv;
@@ -1953,19 +1954,23 @@ static int cfg80211_rtw_set_rekey_data(struct wiphy *wiphy,
 		return -1;
 	}
 
-	_rtw_memcpy(psta->kek, data->kek, NL80211_KEK_LEN);
+	cold = rtw_sta_cold_get(psta);
+	if (cold == NULL)
+		return -ENOMEM;
+
+	_rtw_memcpy(cold->kek, data->kek, NL80211_KEK_LEN);
 	/*printk("\ncfg80211_rtw_set_rekey_data KEK:");
 	for(i=0;i<NL80211_KEK_LEN; i++)
-		printk(" %02x ", psta->kek[i]);*/
-	_rtw_memcpy(psta->kck, data->kck, NL80211_KCK_LEN);
+		printk(" %02x ", cold->kek[i]);*/
+	_rtw_memcpy(cold->kck, data->kck, NL80211_KCK_LEN);
 	/*printk("\ncfg80211_rtw_set_rekey_data KCK:");
 	for(i=0;i<NL80211_KCK_LEN; i++)
-		printk(" %02x ", psta->kck[i]);*/
-	_rtw_memcpy(psta->replay_ctr, data->replay_ctr, NL80211_REPLAY_CTR_LEN);
+		printk(" %02x ", cold->kck[i]);*/
+	_rtw_memcpy(cold->replay_ctr, data->replay_ctr, NL80211_REPLAY_CTR_LEN);
 	psecuritypriv->binstallKCK_KEK = _TRUE;
 	/*printk("\nREPLAY_CTR: ");
 	for(i=0;i<RTW_REPLAY_CTR_LEN; i++)
-		printk(" %02x ", psta->replay_ctr[i]);*/
+		printk(" %02x ", cold->replay_ctr[i]);*/
 
 	return 0;
 }
@@ -8920,7 +8925,7 @@ void rtw_cfg80211_external_auth_status(struct wiphy *wiphy, struct net_device *d
 
 		psta->state &= ~WIFI_FW_AUTH_NULL;
 		psta->state |= WIFI_FW_AUTH_SUCCESS;
-		psta->expire_to = padapter->stapriv.assoc_to;
+		rtw_sta_expire_arm(pstapriv, psta, pstapriv->assoc_to);
 
 		/* RTW_INFO_DUMP("PMKID:", params->pmkid, PMKID_LEN); */
 		_rtw_set_pmksa(dev, params->bssid, params->pmkid);
@@ -304,6 +304,29 @@ int rtw_wifi_spec = 0;
 
 int rtw_special_rf_path = 0; /* 0: 2T2R ,1: only turn on path A 1T1R */
 
+/* per AC xmitframe share, order: VO, VI, BE, BK */
+static uint rtw_tx_ac_rsvd[4] = {16, 16, 0, 0};
+static int rtw_tx_ac_rsvd_num = 0;
+module_param_array(rtw_tx_ac_rsvd, uint, &rtw_tx_ac_rsvd_num, 0644);
+MODULE_PARM_DESC(rtw_tx_ac_rsvd, "xmitframes reserved for each AC (VO, VI, BE, BK)");
+
+static uint rtw_tx_ac_quota[4] = {0, 0, 0, 0};
+static int rtw_tx_ac_quota_num = 0;
+module_param_array(rtw_tx_ac_quota, uint, &rtw_tx_ac_quota_num, 0644);
+MODULE_PARM_DESC(rtw_tx_ac_quota, "max xmitframes each AC (VO, VI, BE, BK) can hold, 0: no limit");
+
+int rtw_tx_xmitbuf_rsvd = 2;
+module_param(rtw_tx_xmitbuf_rsvd, int, 0644);
+MODULE_PARM_DESC(rtw_tx_xmitbuf_rsvd, "xmitbufs kept for VO/VI frames, 0: disable");
+
+int rtw_ps_sleepq_max_len = NR_XMITFRAME / 4;
+module_param(rtw_ps_sleepq_max_len, int, 0644);
+MODULE_PARM_DESC(rtw_ps_sleepq_max_len, "max frames buffered for each power saving STA, 0: no limit");
+
+int rtw_ps_sleepq_max_bytes = 64 * 1024;
+module_param(rtw_ps_sleepq_max_bytes, int, 0644);
+MODULE_PARM_DESC(rtw_ps_sleepq_max_bytes, "max bytes buffered for each power saving STA, 0: no limit");
+
 char rtw_country_unspecified[] = {0xFF, 0xFF, 0x00};
 char *rtw_country_code = rtw_country_unspecified;
 module_param(rtw_country_code, charp, 0644);
@@ -747,6 +770,13 @@ MODULE_PARM_DESC(rtw_load_phy_file, "PHY File Bit Map");
 int rtw_decrypt_phy_file = 0;
 module_param(rtw_decrypt_phy_file, int, 0644);
 MODULE_PARM_DESC(rtw_decrypt_phy_file, "Enable Decrypt PHY File");
+/* PHY_REG_PG and TXPWR_LMT binary form
+* 0: text file only
+* 1: load <name>.bin instead of text file if valid
+* 2: as 1, and store <name>.bin after text file is parsed */
+int rtw_phy_file_bin = 1;
+module_param(rtw_phy_file_bin, int, 0644);
+MODULE_PARM_DESC(rtw_phy_file_bin, "PHY File Binary Form, 0:disable, 1:load, 2:load and store");
 #endif
 
 #ifdef CONFIG_SUPPORT_TRX_SHARED
@@ -839,6 +869,15 @@ int rtw_iqk_fw_offload;
 #endif /* RTW_IQK_FW_OFFLOAD */
 module_param(rtw_iqk_fw_offload, int, 0644);
 
+#ifdef CONFIG_RTW_IQK_CACHE
+/* 0: disable
+* 1: reuse IQK result of the same channel/bw and temperature over IPS, flushed at other HAL init
+* 2: as 1, and kept over all HAL init (ifup, resume) */
+int rtw_iqk_cache = 1;
+module_param(rtw_iqk_cache, int, 0644);
+MODULE_PARM_DESC(rtw_iqk_cache, "IQK result cache, 0:disable, 1:keep over IPS, 2:keep over all HAL init");
+#endif
+
 #ifdef RTW_CHANNEL_SWITCH_OFFLOAD
 int rtw_ch_switch_offload = 0;
 #else
@@ -948,6 +987,7 @@ uint loadparam(_adapter *padapter)
 {
 	uint status = _SUCCESS;
 	struct registry_priv  *registry_par = &padapter->registrypriv;
+	int i;
 
 
 #ifdef CONFIG_RTW_DEBUG
@@ -1064,6 +1104,14 @@ uint loadparam(_adapter *padapter)
 
 	registry_par->wifi_spec = (u8)rtw_wifi_spec;
 
+	for (i = 0; i < 4; i++) {
+		registry_par->tx_ac_rsvd[i] = (u16)rtw_tx_ac_rsvd[i];
+		registry_par->tx_ac_quota[i] = (u16)rtw_tx_ac_quota[i];
+	}
+	registry_par->tx_xmitbuf_rsvd = (u8)rtw_tx_xmitbuf_rsvd;
+	registry_par->ps_sleepq_max_len = (u16)rtw_ps_sleepq_max_len;
+	registry_par->ps_sleepq_max_bytes = (u32)rtw_ps_sleepq_max_bytes;
+
 	if (strlen(rtw_country_code) != 2
 		|| is_alpha(rtw_country_code[0]) == _FALSE
 		|| is_alpha(rtw_country_code[1]) == _FALSE
@@ -1159,6 +1207,7 @@ uint loadparam(_adapter *padapter)
 #ifdef CONFIG_LOAD_PHY_PARA_FROM_FILE
 	registry_par->load_phy_file = (u8)rtw_load_phy_file;
 	registry_par->RegDecryptCustomFile = (u8)rtw_decrypt_phy_file;
+	registry_par->phy_file_bin = (u8)rtw_phy_file_bin;
 #endif
 	registry_par->qos_opt_enable = (u8)rtw_qos_opt_enable;
 
@@ -1240,6 +1289,9 @@ uint loadparam(_adapter *padapter)
 
 	registry_par->iqk_fw_offload = (u8)rtw_iqk_fw_offload;
 	registry_par->ch_switch_offload = (u8)rtw_ch_switch_offload;
+#ifdef CONFIG_RTW_IQK_CACHE
+	registry_par->iqk_cache = (u8)rtw_iqk_cache;
+#endif
 
 #ifdef CONFIG_TDLS
 	registry_par->en_tdls = rtw_en_tdls;
@@ -2169,6 +2221,8 @@ u8 rtw_init_default_value(_adapter *padapter)
 #ifdef CONFIG_TX_AMSDU
 	padapter->tx_amsdu = 2;
 	padapter->tx_amsdu_rate = 400;
+	padapter->tx_amsdu_max_num = RTW_AMSDU_ADAPT_DEF_NUM;
+	padapter->tx_amsdu_lat_budget = RTW_AMSDU_ADAPT_DEF_LAT_US;
 #endif
 	padapter->driver_tx_max_agg_num = 0xFF;
 #ifdef DBG_RX_COUNTER_DUMP
@@ -2597,6 +2651,10 @@ void rtw_cancel_all_timer(_adapter *padapter)
 #endif
 	_cancel_timer_ex(&(adapter_to_pwrctl(padapter)->pwr_state_check_timer));
 
+#ifdef CONFIG_XMIT_ACK
+	rtw_ack_tx_cancel(&padapter->xmitpriv);
+#endif
+
 #ifdef CONFIG_TX_AMSDU
 	_cancel_timer_ex(&padapter->xmitpriv.amsdu_bk_timer);
 	_cancel_timer_ex(&padapter->xmitpriv.amsdu_be_timer);
@@ -554,30 +554,32 @@ int rtw_gtk_offload(struct net_device *net, u8 *cmd_ptr)
 
 	if (psta == NULL)
 		RTW_INFO("%s, : Obtain Sta_info fail\n", __func__);
+	else if (rtw_sta_cold_get(psta) == NULL)
+		RTW_INFO("%s, : alloc sta cold info fail\n", __func__);
 	else {
 		/* string command length of "GTK_REKEY_OFFLOAD" */
 		cmd_ptr += 18;
 
-		_rtw_memcpy(psta->kek, cmd_ptr, RTW_KEK_LEN);
+		_rtw_memcpy(psta->cold->kek, cmd_ptr, RTW_KEK_LEN);
 		cmd_ptr += RTW_KEK_LEN;
 		/*
 		printk("supplicant KEK: ");
 		for(i=0;i<RTW_KEK_LEN; i++)
-			printk(" %02x ", psta->kek[i]);
+			printk(" %02x ", psta->cold->kek[i]);
 		printk("\n supplicant KCK: ");
 		*/
-		_rtw_memcpy(psta->kck, cmd_ptr, RTW_KCK_LEN);
+		_rtw_memcpy(psta->cold->kck, cmd_ptr, RTW_KCK_LEN);
 		cmd_ptr += RTW_KCK_LEN;
 		/*
 		for(i=0;i<RTW_KEK_LEN; i++)
-			printk(" %02x ", psta->kck[i]);
+			printk(" %02x ", psta->cold->kck[i]);
 		*/
-		_rtw_memcpy(psta->replay_ctr, cmd_ptr, RTW_REPLAY_CTR_LEN);
+		_rtw_memcpy(psta->cold->replay_ctr, cmd_ptr, RTW_REPLAY_CTR_LEN);
 		psecuritypriv->binstallKCK_KEK = _TRUE;
 
 		/* printk("\nREPLAY_CTR: "); */
 		/* for(i=0;i<RTW_REPLAY_CTR_LEN; i++) */
-		/* printk(" %02x ", psta->replay_ctr[i]); */
+		/* printk(" %02x ", psta->cold->replay_ctr[i]); */
 	}
 
 	return _SUCCESS;
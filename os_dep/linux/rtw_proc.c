@@ -531,6 +531,106 @@ ssize_t proc_set_aid_status(struct file *file, const char __user *buffer, size_t
 
 	return count;
 }
+
+static int proc_get_sleepq_limit(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct sta_priv *stapriv = &adapter->stapriv;
+	struct sta_info *sta;
+	_list *plist, *phead;
+	_irqL irqL;
+
+	RTW_PRINT_SEL(m, "max_len:%u, max_bytes:%u (0: no limit)\n"
+		, stapriv->sleepq_max_len, stapriv->sleepq_max_bytes);
+	RTW_PRINT_SEL(m, "ovf_drop:%u\n", stapriv->sleepq_ovf_drop);
+
+	sta = rtw_get_bcmc_stainfo(adapter);
+	if (sta)
+		RTW_PRINT_SEL(m, "bmc len:%u, bytes:%u, ovf_drop:%u\n"
+			, sta->sleepq_len, sta->sleepq_bytes, sta->sleepq_ovf_drop);
+
+	_enter_critical_bh(&stapriv->asoc_list_lock, &irqL);
+	phead = &stapriv->asoc_list;
+	plist = get_next(phead);
+	while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
+		sta = LIST_CONTAINOR(plist, struct sta_info, asoc_list);
+		plist = get_next(plist);
+
+		RTW_PRINT_SEL(m, MAC_FMT" aid:%u len:%u, bytes:%u, ovf_drop:%u\n"
+			, MAC_ARG(sta->cmn.mac_addr), sta->cmn.aid
+			, sta->sleepq_len, sta->sleepq_bytes, sta->sleepq_ovf_drop);
+	}
+	_exit_critical_bh(&stapriv->asoc_list_lock, &irqL);
+
+	return 0;
+}
+
+static ssize_t proc_set_sleepq_limit(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct sta_priv *stapriv = &adapter->stapriv;
+
+	char tmp[32];
+	u16 max_len;
+	u32 max_bytes;
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+
+		int num = sscanf(tmp, "%hu %u", &max_len, &max_bytes);
+
+		if (num >= 1)
+			stapriv->sleepq_max_len = rtw_min(max_len, NR_XMITFRAME / 2);
+		if (num >= 2)
+			stapriv->sleepq_max_bytes = max_bytes;
+	}
+
+	return count;
+}
+
+static int proc_get_sta_expire(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = (_adapter *)rtw_netdev_priv(dev);
+	struct sta_priv *stapriv = &adapter->stapriv;
+	struct sta_info *sta;
+	_list *plist, *phead;
+	_irqL irqL;
+	int i;
+
+	RTW_PRINT_SEL(m, "tick:%u (%u ms), auth_to:%u, assoc_to:%u, expire_to:%u\n"
+		, stapriv->expire_tick, STA_EXPIRE_TICK_MS
+		, stapriv->auth_to, stapriv->assoc_to, stapriv->expire_to);
+	RTW_PRINT_SEL(m, "due:%u, aka_probe:%u, ack:%u, fail:%u\n"
+		, stapriv->expire_due_cnt, stapriv->aka_probe_cnt
+		, stapriv->aka_probe_ack_cnt, stapriv->aka_probe_fail_cnt);
+
+	_enter_critical_bh(&stapriv->expire_wheel_lock, &irqL);
+	for (i = 0; i < STA_EXPIRE_WHEEL_SIZE; i++) {
+		phead = &stapriv->expire_wheel[i];
+		plist = get_next(phead);
+		while ((rtw_end_of_queue_search(phead, plist)) == _FALSE) {
+			sta = LIST_CONTAINOR(plist, struct sta_info, expire_list);
+			plist = get_next(plist);
+
+			RTW_PRINT_SEL(m, "slot:%2d "MAC_FMT" deadline:%u (+%u), aka_probe:%u, trycnt:%u\n"
+				, i, MAC_ARG(sta->cmn.mac_addr), sta->expire_tick
+				, sta->expire_tick - stapriv->expire_tick, sta->aka_probe, sta->keep_alive_trycnt);
+		}
+	}
+	_exit_critical_bh(&stapriv->expire_wheel_lock, &irqL);
+
+	return 0;
+}
 #endif /* CONFIG_AP_MODE */
 
 static int proc_get_dump_tx_rate_bmp(struct seq_file *m, void *v)
@@ -3735,6 +3835,9 @@ int proc_get_cur_beacon_keys(struct seq_file *m, void *v)
 	struct mlme_priv *mlme = &adapter->mlmepriv;
 
 	rtw_dump_bcn_keys(m, &mlme->cur_beacon_keys);
+	RTW_PRINT_SEL(m, "bcn_crc = 0x%08x%s, skip = %u, proc = %u\n"
+		, mlme->cur_bcn_crc, mlme->cur_bcn_crc_valid ? "" : "(invalid)"
+		, mlme->bcn_crc_skip_cnt, mlme->bcn_crc_proc_cnt);
 
 	return 0;
 }
@@ -3790,6 +3893,7 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("sec_cam_cache", proc_get_sec_cam_cache, NULL),
 	RTW_PROC_HDL_SSEQ("ps_dbg_info", proc_get_ps_dbg_info, proc_set_ps_dbg_info),
 	RTW_PROC_HDL_SSEQ("wifi_spec", proc_get_wifi_spec, NULL),
+	RTW_PROC_HDL_SSEQ("fast_reconn", proc_get_fast_reconn, proc_set_fast_reconn),
 #ifdef CONFIG_LAYER2_ROAMING
 	RTW_PROC_HDL_SSEQ("roam_flags", proc_get_roam_flags, proc_set_roam_flags),
 	RTW_PROC_HDL_SSEQ("roam_param", proc_get_roam_param, proc_set_roam_param),
@@ -3825,9 +3929,12 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 
 #ifdef CONFIG_AP_MODE
 	RTW_PROC_HDL_SSEQ("aid_status", proc_get_aid_status, proc_set_aid_status),
+	RTW_PROC_HDL_SSEQ("sleepq_limit", proc_get_sleepq_limit, proc_set_sleepq_limit),
+	RTW_PROC_HDL_SSEQ("sta_expire", proc_get_sta_expire, NULL),
 	RTW_PROC_HDL_SSEQ("all_sta_info", proc_get_all_sta_info, NULL),
 	RTW_PROC_HDL_SSEQ("bmc_tx_rate", proc_get_bmc_tx_rate, proc_set_bmc_tx_rate),
 #endif /* CONFIG_AP_MODE */
+	RTW_PROC_HDL_SSEQ("sta_mem", proc_get_sta_mem, NULL),
 
 #ifdef DBG_MEMORY_LEAK
 	RTW_PROC_HDL_SSEQ("_malloc_cnt", proc_get_malloc_cnt, NULL),
@@ -3853,6 +3960,7 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 #ifdef CONFIG_TX_AMSDU
 	RTW_PROC_HDL_SSEQ("tx_amsdu", proc_get_tx_amsdu, proc_set_tx_amsdu),
 	RTW_PROC_HDL_SSEQ("tx_amsdu_rate", proc_get_tx_amsdu_rate, proc_set_tx_amsdu_rate),
+	RTW_PROC_HDL_SSEQ("tx_amsdu_adapt", proc_get_tx_amsdu_adapt, proc_set_tx_amsdu_adapt),
 #endif
 #endif /* CONFIG_80211N_HT */
 
@@ -4021,6 +4129,18 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	RTW_PROC_HDL_SSEQ("rx_stat", proc_get_rx_stat, NULL),
 
 	RTW_PROC_HDL_SSEQ("tx_stat", proc_get_tx_stat, NULL),
+	RTW_PROC_HDL_SSEQ("tx_ac_quota", proc_get_tx_ac_quota, proc_set_tx_ac_quota),
+#ifdef CONFIG_TX_CMPL_TRACK
+	RTW_PROC_HDL_SSEQ("tx_cmpl_stat", proc_get_tx_cmpl_stat, proc_set_tx_cmpl_stat),
+#endif
+#ifdef CONFIG_RTW_HOST_RA
+	RTW_PROC_HDL_SSEQ("host_ra", proc_get_host_ra, proc_set_host_ra),
+#endif
+#ifdef CONFIG_RTW_IQK_CACHE
+	RTW_PROC_HDL_SSEQ("iqk_cache", proc_get_iqk_cache, proc_set_iqk_cache),
+#endif
+	RTW_PROC_HDL_SSEQ("cmd_lat", proc_get_cmd_lat, proc_set_cmd_lat),
+	RTW_PROC_HDL_SSEQ("wdog_task", proc_get_wdog_task, proc_set_wdog_task),
 	/**** PHY Capability ****/
 	RTW_PROC_HDL_SSEQ("phy_cap", proc_get_phy_cap, NULL),
 #ifdef CONFIG_80211N_HT
@@ -107,6 +107,7 @@ int usbctrl_vendorreq(struct intf_hdl *pintfhdl, u8 request, u16 value, u16 inde
 		}
 
 		status = rtw_usb_control_msg(udev, pipe, request, reqtype, value, index, pIo_buf, len, RTW_USB_CONTROL_MSG_TIMEOUT);
+		ATOMIC_INC(&pdvobjpriv->usb_ctrl_xfer_cnt);
 
 		if (status == len) {  /* Success this control transfer. */
 			rtw_reset_continual_io_error(pdvobjpriv);
@@ -378,7 +379,21 @@ static u32 usb_bulkout_zero(struct intf_hdl *pintfhdl, u32 addr)
 
 void usb_read_mem(struct intf_hdl *pintfhdl, u32 addr, u32 cnt, u8 *rmem)
 {
+	u16 len;
 
+	/* one vendor request per chunk, kept dword aligned */
+	while (cnt) {
+		len = (cnt > (VENDOR_CMD_MAX_DATA_LEN & ~0x3)) ?
+			(VENDOR_CMD_MAX_DATA_LEN & ~0x3) : (u16)cnt;
+
+		if (usbctrl_vendorreq(pintfhdl, 0x05, (u16)(addr & 0x0000ffff), 0,
+				      rmem, len, 0x01) < 0)
+			break;
+
+		addr += len;
+		rmem += len;
+		cnt -= len;
+	}
 }
 
 void usb_write_mem(struct intf_hdl *pintfhdl, u32 addr, u32 cnt, u8 *wmem)
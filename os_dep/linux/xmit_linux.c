@@ -223,12 +223,18 @@ static inline bool rtw_os_need_stop_queue(_adapter *padapter, u16 qidx)
                if (pxmitpriv->hwxmits[qidx].accnt > WMM_XMIT_THRESHOLD)
                        return _TRUE;
        } else {
-               if (pxmitpriv->free_xmitframe_cnt <= 4)
+               if (rtw_xmitframe_ac_avail(pxmitpriv, qidx) <= 4)
                        return _TRUE;
        }
        return _FALSE;
 }
 
+/* os queue of pkt, the same as XX_QUEUE_INX by rtw_select_queue() */
+u8 rtw_os_pkt_qidx(_pkt *pkt)
+{
+	return (u8)skb_get_queue_mapping(pkt);
+}
+
 void rtw_os_pkt_complete(_adapter *padapter, _pkt *pkt)
 {
 u16     qidx;
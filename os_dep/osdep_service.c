@@ -1220,6 +1220,16 @@ inline bool _rtw_time_after(systime a, systime b)
 #endif
 }
 
+/* monotonic time in us, for latency statistics finer than systime (jiffies) */
+inline u64 rtw_get_current_time_us(void)
+{
+#ifdef PLATFORM_LINUX
+	return ktime_to_us(ktime_get());
+#else
+	#error "TBD\n"
+#endif
+}
+
 void rtw_sleep_schedulable(int ms)
 {
 